@@ -0,0 +1,7 @@
+/* Platon Lukyanov st128133@student.spbu.ru
+ * Problem 7
+ */
+#include "CircularListExtern.h"
+
+template class CircularList<int>;
+template class CircularList<std::string>;
@@ -3,151 +3,419 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <iterator>
+#include <memory>
+#include <new>
+#include <span>
 #include <stdexcept>
+#include <type_traits>
+#include <vector>
 
 template <typename T>
 class CircularList {
     private:
-        struct Node {
+        // Связи узла. Кольцо узлов замыкается через страж sentinel,
+        // хранящийся в самом списке: sentinel.next - голова, sentinel.prev -
+        // хвост. Благодаря стражу итератору достаточно одного указателя:
+        // end() - это страж, и --end() попадает на хвост.
+        struct Link {
+                Link* next;
+                Link* prev;
+                constexpr Link() : next(this), prev(this) {}
+        };
+
+        struct Node : Link {
                 T data;
-                Node* next;
-                Node* prev;
-                Node(const T& value) : data(value), next(this), prev(this) {}
+                constexpr Node(const T& value) : data(value) {}
+                constexpr Node(T&& value) : data(std::move(value)) {}
+        };
+
+        // Непрерывный блок узлов, созданный compact(). Освобождается вместе
+        // с последней ссылкой на него
+        struct Slab {
+                Node* nodes;
+                size_t capacity;
+                explicit Slab(size_t n);
+                ~Slab();
+                bool contains(const Node* node) const;
+        };
+
+        // Ссылка списка на блок и число живых узлов списка в нём; после
+        // split_at на один блок ссылаются оба списка, каждый со своим числом
+        struct SlabUse {
+                std::shared_ptr<Slab> slab;
+                size_t live;
         };
 
-        Node* head;
+        Link sentinel;
         size_t count;
+        std::vector<SlabUse> slabs;
+        double auto_compact_threshold;
+        size_t mutations_since_compact;
 
     public:
         // Конструкторы
-        CircularList();
-        CircularList(const CircularList& other);
-        CircularList(CircularList&& other) noexcept;
-        ~CircularList();
+        constexpr CircularList();
+        constexpr CircularList(const CircularList& other);
+        constexpr CircularList(CircularList&& other) noexcept;
+        constexpr ~CircularList();
 
         // Операторы присваивания
-        CircularList& operator=(const CircularList& other);
-        CircularList& operator=(CircularList&& other) noexcept;
+        constexpr CircularList& operator=(const CircularList& other);
+        constexpr CircularList& operator=(CircularList&& other) noexcept;
 
-        // Итераторы
+        // Итераторы занимают один указатель и тривиально копируются.
+        // Итераторы на элементы переживают любые изменения других
+        // элементов; end() меняется только при перемещении и обмене
+        // списков. Разыменование end() не проверяется.
         class iterator;
         class const_iterator;
-        using reverse_iterator = std::reverse_iterator<iterator>;
-        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
-
-        iterator begin();
-        iterator end();
-        const_iterator begin() const;
-        const_iterator end() const;
-        const_iterator cbegin() const;
-        const_iterator cend() const;
-        reverse_iterator rbegin();
-        reverse_iterator rend();
-        const_reverse_iterator rbegin() const;
-        const_reverse_iterator rend() const;
-        const_reverse_iterator crbegin() const;
-        const_reverse_iterator crend() const;
+        // Обратные итераторы указывают прямо на свой элемент и идут по prev,
+        // без лишнего шага назад при каждом разыменовании, как у
+        // std::reverse_iterator
+        class reverse_iterator;
+        class const_reverse_iterator;
+
+        constexpr iterator begin();
+        constexpr iterator end();
+        constexpr const_iterator begin() const;
+        constexpr const_iterator end() const;
+        constexpr const_iterator cbegin() const;
+        constexpr const_iterator cend() const;
+        constexpr reverse_iterator rbegin();
+        constexpr reverse_iterator rend();
+        constexpr const_reverse_iterator rbegin() const;
+        constexpr const_reverse_iterator rend() const;
+        constexpr const_reverse_iterator crbegin() const;
+        constexpr const_reverse_iterator crend() const;
+
+        // Соседи по кольцу: за хвостом следует голова, перед головой -
+        // хвост. it не может быть end()
+        constexpr iterator ring_next(iterator it);
+        constexpr iterator ring_prev(iterator it);
+        // Изменяемый итератор на тот же элемент, что и pos; pos должен
+        // принадлежать этому списку
+        constexpr iterator mutable_iterator(const_iterator pos);
+
+        // Сегментный обход: каждый сегмент - непрерывный участок памяти.
+        // У узлового списка сегмент всегда состоит из одного элемента.
+        class segment_iterator;
+        class const_segment_iterator;
+
+        constexpr segment_iterator segment_begin();
+        constexpr segment_iterator segment_end();
+        constexpr const_segment_iterator segment_begin() const;
+        constexpr const_segment_iterator segment_end() const;
+
+        // f принимает std::span<T>; если f возвращает bool, false
+        // прекращает обход
+        template <typename F>
+        constexpr void for_each_segment(F f);
+        template <typename F>
+        constexpr void for_each_segment(F f) const;
+
+        // Обход с упреждающей выборкой следующих узлов
+        template <typename F>
+        constexpr void for_each(F f);
+        template <typename F>
+        constexpr void for_each(F f) const;
 
         // Размер и проверка на пустоту
-        size_t size() const;
-        bool empty() const;
+        constexpr size_t size() const;
+        constexpr bool empty() const;
 
         // Доступ к элементам
-        T& front();
-        const T& front() const;
-        T& back();
-        const T& back() const;
+        constexpr T& front();
+        constexpr const T& front() const;
+        constexpr T& back();
+        constexpr const T& back() const;
 
         // Модификаторы
-        void push_back(const T& value);
-        void push_front(const T& value);
-        void pop_back();
-        void pop_front();
-        void clear();
-        iterator insert(iterator pos, const T& value);
-        iterator erase(iterator pos);
-        void assign(size_t n, const T& value);
-        void swap(CircularList& other) noexcept;
+        constexpr void push_back(const T& value);
+        constexpr void push_front(const T& value);
+        constexpr void pop_back();
+        constexpr void pop_front();
+        constexpr void clear();
+        constexpr iterator insert(iterator pos, const T& value);
+        constexpr iterator erase(iterator pos);
+        // Удаление [first, last) одной перестановкой связей; узлы
+        // освобождаются после отсоединения диапазона
+        constexpr iterator erase(iterator first, iterator last);
+        constexpr void resize(size_t n)
+            requires std::is_default_constructible_v<T>;
+        constexpr void resize(size_t n, const T& value);
+        constexpr void assign(size_t n, const T& value);
+        constexpr void swap(CircularList& other) noexcept;
+        // Сдвиг начала кольца на n позиций вперёд (назад при n < 0)
+        // без перемещения узлов; идёт в более короткую сторону
+        constexpr void rotate(std::ptrdiff_t n);
+        // Разрез кольца за O(1) связей: в списке остаются [begin, pos),
+        // остальные узлы переходят в возвращаемый список. index - номер
+        // pos от begin(); без него он считается обходом до pos. Если у
+        // списка есть блоки уплотнения (после compact() или
+        // автоуплотнения), разрез обходит меньшую из частей, чтобы
+        // поделить блоки, и стоит O(min(index, size() - index))
+        constexpr CircularList split_at(iterator pos, size_t index);
+        constexpr CircularList split_at(iterator pos);
+        // Присоединение узлов other к хвосту за O(1) связей; other
+        // становится пустым
+        constexpr void concat(CircularList&& other);
+
+        // Уплотнение: узлы переносятся в один непрерывный блок в порядке
+        // обхода. Доступно только для T с noexcept-перемещением; все
+        // итераторы, указатели и ссылки на элементы становятся
+        // недействительными.
+        static constexpr bool compact_preserves_iterators = false;
+        void compact()
+            requires std::is_nothrow_move_constructible_v<T>;
+        // Доля связей next (кроме замыкающей хвост на голову), ведущих к
+        // узлу, лежащему в памяти не дальше kLocalityWindow байт впереди;
+        // 1 для списков из < 2 узлов
+        double locality() const;
+        // Число блоков уплотнения, в которых лежат узлы списка
+        size_t slab_count() const noexcept;
+        // Автоматическое уплотнение: после не менее size() изменений список
+        // уплотняется, если locality() < threshold; 0 отключает. Пока порог
+        // задан, любой push_*, pop_*, insert или erase может уплотнить
+        // список и сделать недействительными все итераторы, указатели и
+        // ссылки на элементы, кроме итератора, возвращённого insert/erase
+        void set_auto_compact(double threshold)
+            requires std::is_nothrow_move_constructible_v<T>;
 
         // Операторы сравнения
-        bool operator==(const CircularList& other) const;
-        bool operator!=(const CircularList& other) const;
-        bool operator<(const CircularList& other) const;
-        bool operator>(const CircularList& other) const;
-        bool operator<=(const CircularList& other) const;
-        bool operator>=(const CircularList& other) const;
+        constexpr bool operator==(const CircularList& other) const;
+        constexpr bool operator!=(const CircularList& other) const;
+        constexpr bool operator<(const CircularList& other) const;
+        constexpr bool operator>(const CircularList& other) const;
+        constexpr bool operator<=(const CircularList& other) const;
+        constexpr bool operator>=(const CircularList& other) const;
 
         class iterator {
-                Node* node;
-                Node* head;
+                Link* node;
 
             public:
-            	using iterator_category = std::bidirectional_iterator_tag;
-	    	using value_type        = T;
-	    	using difference_type   = std::ptrdiff_t;
-	        using pointer           = T*;
-	        using reference         = T&;
-                iterator(Node* n = nullptr, Node* h = nullptr);
-                T& operator*();
-                iterator& operator++();
-                iterator& operator--();
-                bool operator==(const iterator& other) const;
-                bool operator!=(const iterator& other) const;
+                using iterator_category = std::bidirectional_iterator_tag;
+                using value_type = T;
+                using difference_type = std::ptrdiff_t;
+                using pointer = T*;
+                using reference = T&;
+                constexpr iterator(Link* n = nullptr);
+                constexpr T& operator*() const;
+                constexpr iterator& operator++();
+                constexpr iterator& operator--();
+                constexpr bool operator==(const iterator& other) const;
+                constexpr bool operator!=(const iterator& other) const;
                 friend class CircularList;
         };
 
         class const_iterator {
-                Node* node;
-                Node* head;
+                const Link* node;
 
             public:
                 using iterator_category = std::bidirectional_iterator_tag;
-	        using value_type        = T;
-	        using difference_type   = std::ptrdiff_t;
-	        using pointer           = const T*;
-	        using reference         = const T&;
-                const_iterator(Node* n = nullptr, Node* h = nullptr);
-                const T& operator*() const;
-                const_iterator& operator++();
-                const_iterator& operator--();
-                bool operator==(const const_iterator& other) const;
-                bool operator!=(const const_iterator& other) const;
+                using value_type = T;
+                using difference_type = std::ptrdiff_t;
+                using pointer = const T*;
+                using reference = const T&;
+                constexpr const_iterator(const Link* n = nullptr);
+                constexpr const_iterator(const iterator& other);
+                constexpr const T& operator*() const;
+                constexpr const_iterator& operator++();
+                constexpr const_iterator& operator--();
+                constexpr bool operator==(const const_iterator& other) const;
+                constexpr bool operator!=(const const_iterator& other) const;
+                friend class CircularList;
+        };
+
+        class reverse_iterator {
+                Link* node;
+
+            public:
+                using iterator_category = std::bidirectional_iterator_tag;
+                using value_type = T;
+                using difference_type = std::ptrdiff_t;
+                using pointer = T*;
+                using reference = T&;
+                constexpr reverse_iterator(Link* n = nullptr);
+                // Как у std::reverse_iterator: rbegin() получается из end()
+                constexpr explicit reverse_iterator(const iterator& base);
+                // Прямой итератор на элемент, следующий за текущим
+                constexpr iterator base() const;
+                constexpr T& operator*() const;
+                constexpr reverse_iterator& operator++();
+                constexpr reverse_iterator& operator--();
+                constexpr bool operator==(const reverse_iterator& other) const;
+                constexpr bool operator!=(const reverse_iterator& other) const;
+                friend class CircularList;
+        };
+
+        class const_reverse_iterator {
+                const Link* node;
+
+            public:
+                using iterator_category = std::bidirectional_iterator_tag;
+                using value_type = T;
+                using difference_type = std::ptrdiff_t;
+                using pointer = const T*;
+                using reference = const T&;
+                constexpr const_reverse_iterator(const Link* n = nullptr);
+                constexpr explicit const_reverse_iterator(
+                    const const_iterator& base);
+                constexpr const_reverse_iterator(const reverse_iterator& other);
+                constexpr const_iterator base() const;
+                constexpr const T& operator*() const;
+                constexpr const_reverse_iterator& operator++();
+                constexpr const_reverse_iterator& operator--();
+                constexpr bool operator==(
+                    const const_reverse_iterator& other) const;
+                constexpr bool operator!=(
+                    const const_reverse_iterator& other) const;
+                friend class CircularList;
+        };
+
+        class segment_iterator {
+                Link* node;
+                const Link* last;  // страж списка
+
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using value_type = std::span<T>;
+                using difference_type = std::ptrdiff_t;
+                constexpr segment_iterator(Link* n = nullptr,
+                                           const Link* s = nullptr);
+                constexpr std::span<T> operator*() const;
+                constexpr segment_iterator& operator++();
+                // Итератор на элемент с номером offset внутри сегмента
+                constexpr iterator to_iterator(size_t offset) const;
+                constexpr bool operator==(const segment_iterator& other) const;
+                constexpr bool operator!=(const segment_iterator& other) const;
                 friend class CircularList;
         };
+
+        class const_segment_iterator {
+                const Link* node;
+                const Link* last;
+
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using value_type = std::span<const T>;
+                using difference_type = std::ptrdiff_t;
+                constexpr const_segment_iterator(const Link* n = nullptr,
+                                                 const Link* s = nullptr);
+                constexpr std::span<const T> operator*() const;
+                constexpr const_segment_iterator& operator++();
+                constexpr const_iterator to_iterator(size_t offset) const;
+                constexpr bool operator==(
+                    const const_segment_iterator& other) const;
+                constexpr bool operator!=(
+                    const const_segment_iterator& other) const;
+                friend class CircularList;
+        };
+
+    private:
+        // Число узлов, которые запрашиваются в кэш заранее при обходе
+        static constexpr size_t kPrefetchDistance = 4;
+
+        // Указатель, идущий по кольцу на kPrefetchDistance узлов впереди
+        // обхода и запрашивающий эти узлы в кэш
+        class Lookahead {
+                const Link* ahead;
+
+            public:
+                constexpr explicit Lookahead(const Link* start);
+                constexpr void advance();
+        };
+
+        template <typename Span, typename F>
+        static constexpr void visit_segments(Link* first, size_t n, F& f);
+
+        static constexpr size_t kLocalityWindow = 4 * sizeof(Node);
+        static constexpr size_t kAutoCompactMinMutations = 64;
+
+        static constexpr Node* as_node(Link* link);
+        static constexpr const Node* as_node(const Link* link);
+        // Вставка link перед pos
+        static constexpr void link_before(Link* link, Link* pos) noexcept;
+        static constexpr void unlink(Link* link) noexcept;
+        // Перенос кольца со стража from на пустой страж to
+        static constexpr void move_ring(Link& to, Link& from) noexcept;
+
+        constexpr Node* create_node(const T& value);
+        constexpr void destroy_node(Node* node) noexcept;
+        // Номер блока в slabs, содержащего node, или slabs.size()
+        constexpr size_t slab_index(const Node* node) const noexcept;
+        // Удаление всех элементов начиная с n-го
+        constexpr void truncate(size_t n);
+        // *tracked (если задан) после уплотнения указывает на новое место
+        // того же узла
+        void compact_nodes(Link** tracked);
+        constexpr void maybe_auto_compact(Link** tracked = nullptr) noexcept;
 };
 
-// Конструкторы
+// Связи
 template <typename T>
-CircularList<T>::CircularList() : head(nullptr), count(0) {
+constexpr typename CircularList<T>::Node* CircularList<T>::as_node(
+    Link* link) {
+    return static_cast<Node*>(link);
 }
 
 template <typename T>
-CircularList<T>::CircularList(const CircularList& other)
-    : head(nullptr), count(0) {
-    if (other.empty()) return;
+constexpr const typename CircularList<T>::Node* CircularList<T>::as_node(
+    const Link* link) {
+    return static_cast<const Node*>(link);
+}
 
-    try {
-        Node* current = other.head;
-        if (!current) throw std::runtime_error("Invalid source list head");
+template <typename T>
+constexpr void CircularList<T>::link_before(Link* link, Link* pos) noexcept {
+    link->next = pos;
+    link->prev = pos->prev;
+    pos->prev->next = link;
+    pos->prev = link;
+}
 
-        size_t elements_copied = 0;
-        do {
-            if (!current->next || !current->prev) {
-                throw std::runtime_error("Invalid node links in source list");
-            }
-            push_back(current->data);
-            current = current->next;
-            elements_copied++;
+template <typename T>
+constexpr void CircularList<T>::unlink(Link* link) noexcept {
+    link->prev->next = link->next;
+    link->next->prev = link->prev;
+}
 
-            if (elements_copied > other.count) {
-                throw std::runtime_error("Circular list structure corrupted");
-            }
-        } while (current != other.head);
+template <typename T>
+constexpr void CircularList<T>::move_ring(Link& to, Link& from) noexcept {
+    if (from.next == &from) {
+        to.next = to.prev = &to;
+        return;
+    }
+    to.next = from.next;
+    to.prev = from.prev;
+    to.next->prev = &to;
+    to.prev->next = &to;
+    from.next = from.prev = &from;
+}
+
+// Конструкторы
+template <typename T>
+constexpr CircularList<T>::CircularList()
+    : count(0), auto_compact_threshold(0), mutations_since_compact(0) {
+}
 
-        if (elements_copied != other.count) {
-            throw std::runtime_error("Element count mismatch during copy");
+template <typename T>
+constexpr CircularList<T>::CircularList(const CircularList& other)
+    : count(0), auto_compact_threshold(other.auto_compact_threshold),
+      mutations_since_compact(0) {
+    try {
+        const Link* current = other.sentinel.next;
+        Lookahead lookahead(current);
+        for (size_t i = 0; i < other.count; ++i) {
+            if (current == &other.sentinel)
+                throw std::runtime_error("Element count mismatch during copy");
+            push_back(as_node(current)->data);
+            current = current->next;
+            lookahead.advance();
         }
+        if (current != &other.sentinel)
+            throw std::runtime_error("Circular list structure corrupted");
     } catch (...) {
         clear();
         throw;
@@ -155,20 +423,25 @@ CircularList<T>::CircularList(const CircularList& other)
 }
 
 template <typename T>
-CircularList<T>::CircularList(CircularList&& other) noexcept
-    : head(other.head), count(other.count) {
-    other.head = nullptr;
+constexpr CircularList<T>::CircularList(CircularList&& other) noexcept
+    : count(other.count), slabs(std::move(other.slabs)),
+      auto_compact_threshold(other.auto_compact_threshold),
+      mutations_since_compact(other.mutations_since_compact) {
+    move_ring(sentinel, other.sentinel);
     other.count = 0;
+    other.slabs.clear();
+    other.mutations_since_compact = 0;
 }
 
 template <typename T>
-CircularList<T>::~CircularList() {
+constexpr CircularList<T>::~CircularList() {
     clear();
 }
 
 // Операторы присваивания
 template <typename T>
-CircularList<T>& CircularList<T>::operator=(const CircularList& other) {
+constexpr CircularList<T>& CircularList<T>::operator=(
+    const CircularList& other) {
     if (this != &other) {
         CircularList temp(other);
         swap(temp);
@@ -177,374 +450,717 @@ CircularList<T>& CircularList<T>::operator=(const CircularList& other) {
 }
 
 template <typename T>
-CircularList<T>& CircularList<T>::operator=(CircularList&& other) noexcept {
+constexpr CircularList<T>& CircularList<T>::operator=(
+    CircularList&& other) noexcept {
     if (this != &other) {
         clear();
-        head = other.head;
+        move_ring(sentinel, other.sentinel);
         count = other.count;
-        other.head = nullptr;
+        slabs = std::move(other.slabs);
+        auto_compact_threshold = other.auto_compact_threshold;
+        mutations_since_compact = other.mutations_since_compact;
         other.count = 0;
+        other.slabs.clear();
+        other.mutations_since_compact = 0;
     }
     return *this;
 }
 
 // Итераторы
 template <typename T>
-typename CircularList<T>::iterator CircularList<T>::begin() {
-    return iterator(head, head);
+constexpr typename CircularList<T>::iterator CircularList<T>::begin() {
+    return iterator(sentinel.next);
 }
 
 template <typename T>
-typename CircularList<T>::iterator CircularList<T>::end() {
-    return iterator(nullptr, head);
+constexpr typename CircularList<T>::iterator CircularList<T>::end() {
+    return iterator(&sentinel);
 }
 
 template <typename T>
-typename CircularList<T>::const_iterator CircularList<T>::begin() const {
-    return const_iterator(head, head);
+constexpr typename CircularList<T>::const_iterator CircularList<T>::begin()
+    const {
+    return const_iterator(sentinel.next);
 }
 
 template <typename T>
-typename CircularList<T>::const_iterator CircularList<T>::end() const {
-    return const_iterator(nullptr, head);
+constexpr typename CircularList<T>::const_iterator CircularList<T>::end()
+    const {
+    return const_iterator(&sentinel);
 }
 
 template <typename T>
-typename CircularList<T>::const_iterator CircularList<T>::cbegin() const {
+constexpr typename CircularList<T>::const_iterator CircularList<T>::cbegin()
+    const {
     return begin();
 }
 
 template <typename T>
-typename CircularList<T>::const_iterator CircularList<T>::cend() const {
+constexpr typename CircularList<T>::const_iterator CircularList<T>::cend()
+    const {
     return end();
 }
 
 template <typename T>
-typename CircularList<T>::reverse_iterator CircularList<T>::rbegin() {
-    return reverse_iterator(end());
+constexpr typename CircularList<T>::reverse_iterator
+CircularList<T>::rbegin() {
+    return reverse_iterator(sentinel.prev);
 }
 
 template <typename T>
-typename CircularList<T>::reverse_iterator CircularList<T>::rend() {
-    return reverse_iterator(begin());
+constexpr typename CircularList<T>::reverse_iterator
+CircularList<T>::rend() {
+    return reverse_iterator(&sentinel);
 }
 
 template <typename T>
-typename CircularList<T>::const_reverse_iterator CircularList<T>::rbegin()
-    const {
-    return const_reverse_iterator(end());
+constexpr typename CircularList<T>::const_reverse_iterator
+CircularList<T>::rbegin() const {
+    return const_reverse_iterator(sentinel.prev);
 }
 
 template <typename T>
-typename CircularList<T>::const_reverse_iterator CircularList<T>::rend() const {
-    return const_reverse_iterator(begin());
+constexpr typename CircularList<T>::const_reverse_iterator
+CircularList<T>::rend() const {
+    return const_reverse_iterator(&sentinel);
 }
 
 template <typename T>
-typename CircularList<T>::const_reverse_iterator CircularList<T>::crbegin()
-    const {
+constexpr typename CircularList<T>::const_reverse_iterator
+CircularList<T>::crbegin() const {
     return rbegin();
 }
 
 template <typename T>
-typename CircularList<T>::const_reverse_iterator CircularList<T>::crend()
-    const {
+constexpr typename CircularList<T>::const_reverse_iterator
+CircularList<T>::crend() const {
     return rend();
 }
 
+template <typename T>
+constexpr typename CircularList<T>::iterator CircularList<T>::ring_next(
+    iterator it) {
+    if (!it.node || it.node == &sentinel)
+        throw std::out_of_range("CircularList::ring_next: end iterator");
+    Link* next = it.node->next;
+    return iterator(next == &sentinel ? sentinel.next : next);
+}
+
+template <typename T>
+constexpr typename CircularList<T>::iterator CircularList<T>::ring_prev(
+    iterator it) {
+    if (!it.node || it.node == &sentinel)
+        throw std::out_of_range("CircularList::ring_prev: end iterator");
+    Link* prev = it.node->prev;
+    return iterator(prev == &sentinel ? sentinel.prev : prev);
+}
+
+template <typename T>
+constexpr typename CircularList<T>::iterator CircularList<T>::mutable_iterator(
+    const_iterator pos) {
+    return iterator(const_cast<Link*>(pos.node ? pos.node : &sentinel));
+}
+
 // Операторы сравнения
 template <typename T>
-bool CircularList<T>::operator==(const CircularList& other) const {
+constexpr bool CircularList<T>::operator==(const CircularList& other) const {
     if (size() != other.size()) return false;
     if (empty()) return true;
 
-    auto it1 = begin();
-    auto it2 = other.begin();
-    size_t elements_compared = 0;
-
-    while (it1 != end() && elements_compared < size()) {
-        if (*it1 != *it2) return false;
-        ++it1;
-        ++it2;
-        ++elements_compared;
-    }
+    const Link* other_node = other.sentinel.next;
+    Lookahead lookahead(other_node);
+    bool equal = true;
+    for_each_segment([&](std::span<const T> segment) {
+        for (const T& value : segment) {
+            if (value != as_node(other_node)->data) {
+                equal = false;
+                return false;
+            }
+            other_node = other_node->next;
+            lookahead.advance();
+        }
+        return true;
+    });
 
-    return elements_compared == size();
+    return equal;
 }
 
 template <typename T>
-bool CircularList<T>::operator!=(const CircularList& other) const {
+constexpr bool CircularList<T>::operator!=(const CircularList& other) const {
     return !(*this == other);
 }
 
 template <typename T>
-bool CircularList<T>::operator<(const CircularList& other) const {
+constexpr bool CircularList<T>::operator<(const CircularList& other) const {
     if (empty() && other.empty()) return false;
     if (empty()) return true;
     if (other.empty()) return false;
 
-    auto it1 = begin();
-    auto it2 = other.begin();
-    size_t elements_compared = 0;
-
-    while (it1 != end() && it2 != other.end() &&
-           elements_compared < std::min(size(), other.size())) {
-        if (*it1 < *it2) return true;
-        if (*it2 < *it1) return false;
-        ++it1;
-        ++it2;
-        ++elements_compared;
+    const Link* node1 = sentinel.next;
+    const Link* node2 = other.sentinel.next;
+    Lookahead lookahead1(node1);
+    Lookahead lookahead2(node2);
+    size_t common = std::min(size(), other.size());
+
+    for (size_t i = 0; i < common; ++i) {
+        if (as_node(node1)->data < as_node(node2)->data) return true;
+        if (as_node(node2)->data < as_node(node1)->data) return false;
+        node1 = node1->next;
+        node2 = node2->next;
+        lookahead1.advance();
+        lookahead2.advance();
     }
 
     return size() < other.size();
 }
 
 template <typename T>
-bool CircularList<T>::operator>(const CircularList& other) const {
+constexpr bool CircularList<T>::operator>(const CircularList& other) const {
     return other < *this;
 }
 
 template <typename T>
-bool CircularList<T>::operator<=(const CircularList& other) const {
+constexpr bool CircularList<T>::operator<=(const CircularList& other) const {
     return !(other < *this);
 }
 
 template <typename T>
-bool CircularList<T>::operator>=(const CircularList& other) const {
+constexpr bool CircularList<T>::operator>=(const CircularList& other) const {
     return !(*this < other);
 }
 
 template <typename T>
-void CircularList<T>::pop_back() {
+constexpr void CircularList<T>::pop_back() {
     if (empty()) throw std::out_of_range("CircularList::pop_back: empty list");
-    Node* tail = head->prev;
-    if (tail == head) {
-        delete head;
-        head = nullptr;
-    } else {
-        tail->prev->next = head;
-        head->prev = tail->prev;
-        delete tail;
-    }
+    Link* tail = sentinel.prev;
+    unlink(tail);
+    destroy_node(as_node(tail));
     --count;
+    maybe_auto_compact();
 }
 
 template <typename T>
-void CircularList<T>::pop_front() {
+constexpr void CircularList<T>::pop_front() {
     if (empty()) throw std::out_of_range("CircularList::pop_front: empty list");
-    if (head->next == head) {
-        delete head;
-        head = nullptr;
-    } else {
-        Node* old_head = head;
-        head->prev->next = head->next;
-        head->next->prev = head->prev;
-        head = head->next;
-        delete old_head;
-    }
+    Link* first = sentinel.next;
+    unlink(first);
+    destroy_node(as_node(first));
     --count;
+    maybe_auto_compact();
 }
 
 template <typename T>
-typename CircularList<T>::iterator CircularList<T>::insert(iterator pos,
-                                                           const T& value) {
-    if (pos.node == nullptr || head == nullptr) {
-        push_back(value);
-        return iterator(head->prev, head);
-    }
-    Node* cur = pos.node;
-    Node* prev = cur->prev;
-    Node* node = new Node(value);
-    node->next = cur;
-    node->prev = prev;
-    prev->next = node;
-    cur->prev = node;
-    if (cur == head) head = node;
+constexpr typename CircularList<T>::iterator CircularList<T>::insert(
+    iterator pos, const T& value) {
+    Link* node = create_node(value);
+    link_before(node, pos.node ? pos.node : &sentinel);
     ++count;
-    return iterator(node, head);
+    maybe_auto_compact(&node);
+    return iterator(node);
 }
 
 template <typename T>
-typename CircularList<T>::iterator CircularList<T>::erase(iterator pos) {
+constexpr typename CircularList<T>::iterator CircularList<T>::erase(
+    iterator pos) {
     if (empty()) throw std::out_of_range("CircularList::erase: empty list");
-    if (pos.node == nullptr)
+    if (!pos.node || pos.node == &sentinel)
         throw std::invalid_argument("CircularList::erase: invalid iterator");
-    Node* node = pos.node;
-    iterator iter(node->next == head ? nullptr : node->next, head);
-    if (node->next == node) {
-        delete node;
-        head = nullptr;
+    Link* next = pos.node->next;
+    unlink(pos.node);
+    destroy_node(as_node(pos.node));
+    --count;
+    maybe_auto_compact(&next);
+    return iterator(next);
+}
+
+template <typename T>
+constexpr typename CircularList<T>::iterator CircularList<T>::erase(
+    iterator first, iterator last) {
+    if (first.node == last.node) return last;
+    if (!first.node || first.node == &sentinel || !last.node)
+        throw std::invalid_argument("CircularList::erase: invalid range");
+    Link* before = first.node->prev;
+    Link* after = last.node;
+    before->next = after;
+    after->prev = before;
+
+    // Внутренние связи диапазона не менялись: он по-прежнему ведёт к after
+    size_t removed = 0;
+    for (Link* current = first.node; current != after; ++removed) {
+        Link* next = current->next;
+        destroy_node(as_node(current));
+        current = next;
+    }
+    count -= removed;
+    maybe_auto_compact(&after);
+    return iterator(after);
+}
+
+template <typename T>
+constexpr void CircularList<T>::resize(size_t n)
+    requires std::is_default_constructible_v<T>
+{
+    if (n <= count) {
+        truncate(n);
     } else {
-        node->prev->next = node->next;
-        node->next->prev = node->prev;
-        if (node == head) head = node->next;
-        delete node;
+        resize(n, T());
     }
-    --count;
-    return iter;
 }
 
 template <typename T>
-CircularList<T>::const_iterator::const_iterator(Node* n, Node* h)
-    : node(n), head(h) {
+constexpr void CircularList<T>::resize(size_t n, const T& value) {
+    if (n <= count) {
+        truncate(n);
+        return;
+    }
+    while (count < n) push_back(value);
 }
 
 template <typename T>
-const T& CircularList<T>::const_iterator::operator*() const {
-    if (!node)
-        throw std::out_of_range(
-            "CircularList::const_iterator::operator*: dereferencing end "
-            "iterator");
-    return node->data;
+constexpr void CircularList<T>::truncate(size_t n) {
+    if (n == count) return;
+    // Начало отрезаемого хвоста ищется с ближайшего конца
+    Link* first = sentinel.next;
+    if (n <= count / 2) {
+        for (size_t i = 0; i < n; ++i) first = first->next;
+    } else {
+        first = sentinel.prev;
+        for (size_t i = count - 1; i > n; --i) first = first->prev;
+    }
+    erase(iterator(first), end());
+}
+
+template <typename T>
+constexpr CircularList<T>::const_iterator::const_iterator(const Link* n)
+    : node(n) {
+}
+
+template <typename T>
+constexpr CircularList<T>::const_iterator::const_iterator(
+    const iterator& other)
+    : node(other.node) {
+}
+
+template <typename T>
+constexpr const T& CircularList<T>::const_iterator::operator*() const {
+    return as_node(node)->data;
 }
 
 template <typename T>
-typename CircularList<T>::const_iterator&
+constexpr typename CircularList<T>::const_iterator&
 CircularList<T>::const_iterator::operator++() {
-    if (!node)
-        throw std::out_of_range(
-            "CircularList::const_iterator::operator++: incrementing end "
-            "iterator");
     node = node->next;
     return *this;
 }
 
 template <typename T>
-typename CircularList<T>::const_iterator&
+constexpr typename CircularList<T>::const_iterator&
 CircularList<T>::const_iterator::operator--() {
-    if (!head)
-        throw std::out_of_range(
-            "CircularList::const_iterator::operator--: no list");
-    if (!node) {
-        node = head->prev;
-    } else {
-        node = node->prev;
-    }
+    node = node->prev;
     return *this;
 }
 
 template <typename T>
-bool CircularList<T>::const_iterator::operator==(
+constexpr bool CircularList<T>::const_iterator::operator==(
     const const_iterator& other) const {
     return node == other.node;
 }
 
 template <typename T>
-bool CircularList<T>::const_iterator::operator!=(
+constexpr bool CircularList<T>::const_iterator::operator!=(
     const const_iterator& other) const {
     return node != other.node;
 }
 
 template <typename T>
-CircularList<T>::iterator::iterator(Node* n, Node* h) : node(n), head(h) {
+constexpr CircularList<T>::iterator::iterator(Link* n) : node(n) {
+}
+
+template <typename T>
+constexpr T& CircularList<T>::iterator::operator*() const {
+    return as_node(node)->data;
+}
+
+template <typename T>
+constexpr typename CircularList<T>::iterator&
+CircularList<T>::iterator::operator++() {
+    node = node->next;
+    return *this;
+}
+
+template <typename T>
+constexpr typename CircularList<T>::iterator&
+CircularList<T>::iterator::operator--() {
+    node = node->prev;
+    return *this;
+}
+
+template <typename T>
+constexpr bool CircularList<T>::iterator::operator==(
+    const iterator& other) const {
+    return node == other.node;
+}
+
+template <typename T>
+constexpr bool CircularList<T>::iterator::operator!=(
+    const iterator& other) const {
+    return node != other.node;
+}
+
+// Обратные итераторы
+template <typename T>
+constexpr CircularList<T>::reverse_iterator::reverse_iterator(Link* n)
+    : node(n) {
+}
+
+template <typename T>
+constexpr CircularList<T>::reverse_iterator::reverse_iterator(
+    const iterator& base)
+    : node(base.node ? base.node->prev : nullptr) {
+}
+
+template <typename T>
+constexpr typename CircularList<T>::iterator
+CircularList<T>::reverse_iterator::base() const {
+    return iterator(node ? node->next : nullptr);
+}
+
+template <typename T>
+constexpr T& CircularList<T>::reverse_iterator::operator*() const {
+    return as_node(node)->data;
+}
+
+template <typename T>
+constexpr typename CircularList<T>::reverse_iterator&
+CircularList<T>::reverse_iterator::operator++() {
+    node = node->prev;
+    return *this;
+}
+
+template <typename T>
+constexpr typename CircularList<T>::reverse_iterator&
+CircularList<T>::reverse_iterator::operator--() {
+    node = node->next;
+    return *this;
+}
+
+template <typename T>
+constexpr bool CircularList<T>::reverse_iterator::operator==(
+    const reverse_iterator& other) const {
+    return node == other.node;
+}
+
+template <typename T>
+constexpr bool CircularList<T>::reverse_iterator::operator!=(
+    const reverse_iterator& other) const {
+    return node != other.node;
+}
+
+template <typename T>
+constexpr CircularList<T>::const_reverse_iterator::const_reverse_iterator(
+    const Link* n)
+    : node(n) {
+}
+
+template <typename T>
+constexpr CircularList<T>::const_reverse_iterator::const_reverse_iterator(
+    const const_iterator& base)
+    : node(base.node ? base.node->prev : nullptr) {
 }
 
 template <typename T>
-T& CircularList<T>::iterator::operator*() {
-    if (!node)
+constexpr CircularList<T>::const_reverse_iterator::const_reverse_iterator(
+    const reverse_iterator& other)
+    : node(other.node) {
+}
+
+template <typename T>
+constexpr typename CircularList<T>::const_iterator
+CircularList<T>::const_reverse_iterator::base() const {
+    return const_iterator(node ? node->next : nullptr);
+}
+
+template <typename T>
+constexpr const T& CircularList<T>::const_reverse_iterator::operator*() const {
+    return as_node(node)->data;
+}
+
+template <typename T>
+constexpr typename CircularList<T>::const_reverse_iterator&
+CircularList<T>::const_reverse_iterator::operator++() {
+    node = node->prev;
+    return *this;
+}
+
+template <typename T>
+constexpr typename CircularList<T>::const_reverse_iterator&
+CircularList<T>::const_reverse_iterator::operator--() {
+    node = node->next;
+    return *this;
+}
+
+template <typename T>
+constexpr bool CircularList<T>::const_reverse_iterator::operator==(
+    const const_reverse_iterator& other) const {
+    return node == other.node;
+}
+
+template <typename T>
+constexpr bool CircularList<T>::const_reverse_iterator::operator!=(
+    const const_reverse_iterator& other) const {
+    return node != other.node;
+}
+
+// Сегментный обход
+template <typename T>
+constexpr typename CircularList<T>::segment_iterator
+CircularList<T>::segment_begin() {
+    return segment_iterator(sentinel.next, &sentinel);
+}
+
+template <typename T>
+constexpr typename CircularList<T>::segment_iterator
+CircularList<T>::segment_end() {
+    return segment_iterator(&sentinel, &sentinel);
+}
+
+template <typename T>
+constexpr typename CircularList<T>::const_segment_iterator
+CircularList<T>::segment_begin() const {
+    return const_segment_iterator(sentinel.next, &sentinel);
+}
+
+template <typename T>
+constexpr typename CircularList<T>::const_segment_iterator
+CircularList<T>::segment_end() const {
+    return const_segment_iterator(&sentinel, &sentinel);
+}
+
+template <typename T>
+template <typename Span, typename F>
+constexpr void CircularList<T>::visit_segments(Link* first, size_t n, F& f) {
+    Lookahead lookahead(first);
+    for (size_t i = 0; i < n; ++i) {
+        Link* next = first->next;
+        T& value = as_node(first)->data;
+        if constexpr (std::is_same_v<std::invoke_result_t<F&, Span>, bool>) {
+            if (!f(Span(&value, 1))) return;
+        } else {
+            f(Span(&value, 1));
+        }
+        first = next;
+        lookahead.advance();
+    }
+}
+
+template <typename T>
+template <typename F>
+constexpr void CircularList<T>::for_each_segment(F f) {
+    visit_segments<std::span<T>>(sentinel.next, count, f);
+}
+
+template <typename T>
+template <typename F>
+constexpr void CircularList<T>::for_each_segment(F f) const {
+    visit_segments<std::span<const T>>(sentinel.next, count, f);
+}
+
+template <typename T>
+template <typename F>
+constexpr void CircularList<T>::for_each(F f) {
+    for_each_segment([&f](std::span<T> segment) {
+        for (T& value : segment) f(value);
+    });
+}
+
+template <typename T>
+template <typename F>
+constexpr void CircularList<T>::for_each(F f) const {
+    for_each_segment([&f](std::span<const T> segment) {
+        for (const T& value : segment) f(value);
+    });
+}
+
+template <typename T>
+constexpr CircularList<T>::Lookahead::Lookahead(const Link* start)
+    : ahead(start) {
+    // При вычислении на этапе компиляции упреждать нечего
+    if (!ahead || std::is_constant_evaluated()) return;
+    for (size_t i = 0; i < kPrefetchDistance; ++i) advance();
+}
+
+template <typename T>
+constexpr void CircularList<T>::Lookahead::advance() {
+    if (std::is_constant_evaluated()) return;
+    ahead = ahead->next;
+#if defined(__GNUC__)
+    __builtin_prefetch(ahead);
+#endif
+}
+
+template <typename T>
+constexpr CircularList<T>::segment_iterator::segment_iterator(Link* n,
+                                                              const Link* s)
+    : node(n), last(s) {
+}
+
+template <typename T>
+constexpr std::span<T> CircularList<T>::segment_iterator::operator*() const {
+    if (node == last)
         throw std::out_of_range(
-            "CircularList::iterator::operator*: dereferencing end iterator");
-    return node->data;
+            "CircularList::segment_iterator::operator*: dereferencing end "
+            "iterator");
+    return std::span<T>(&as_node(node)->data, 1);
 }
 
 template <typename T>
-typename CircularList<T>::iterator& CircularList<T>::iterator::operator++() {
-    if (!node)
+constexpr typename CircularList<T>::segment_iterator&
+CircularList<T>::segment_iterator::operator++() {
+    if (node == last)
         throw std::out_of_range(
-            "CircularList::iterator::operator++: incrementing end iterator");
+            "CircularList::segment_iterator::operator++: incrementing end "
+            "iterator");
     node = node->next;
     return *this;
 }
 
 template <typename T>
-typename CircularList<T>::iterator& CircularList<T>::iterator::operator--() {
-    if (!head)
-        throw std::out_of_range("CircularList::iterator::operator--: no list");
-    if (!node) {
-        node = head->prev;
-    } else {
-        node = node->prev;
-    }
+constexpr typename CircularList<T>::iterator
+CircularList<T>::segment_iterator::to_iterator(size_t offset) const {
+    if (node == last || offset != 0)
+        throw std::out_of_range(
+            "CircularList::segment_iterator::to_iterator: offset out of "
+            "segment");
+    return iterator(node);
+}
+
+template <typename T>
+constexpr bool CircularList<T>::segment_iterator::operator==(
+    const segment_iterator& other) const {
+    return node == other.node;
+}
+
+template <typename T>
+constexpr bool CircularList<T>::segment_iterator::operator!=(
+    const segment_iterator& other) const {
+    return node != other.node;
+}
+
+template <typename T>
+constexpr CircularList<T>::const_segment_iterator::const_segment_iterator(
+    const Link* n, const Link* s)
+    : node(n), last(s) {
+}
+
+template <typename T>
+constexpr std::span<const T>
+CircularList<T>::const_segment_iterator::operator*() const {
+    if (node == last)
+        throw std::out_of_range(
+            "CircularList::const_segment_iterator::operator*: dereferencing "
+            "end iterator");
+    return std::span<const T>(&as_node(node)->data, 1);
+}
+
+template <typename T>
+constexpr typename CircularList<T>::const_segment_iterator&
+CircularList<T>::const_segment_iterator::operator++() {
+    if (node == last)
+        throw std::out_of_range(
+            "CircularList::const_segment_iterator::operator++: incrementing "
+            "end iterator");
+    node = node->next;
     return *this;
 }
 
 template <typename T>
-bool CircularList<T>::iterator::operator==(const iterator& other) const {
+constexpr typename CircularList<T>::const_iterator
+CircularList<T>::const_segment_iterator::to_iterator(size_t offset) const {
+    if (node == last || offset != 0)
+        throw std::out_of_range(
+            "CircularList::const_segment_iterator::to_iterator: offset out of "
+            "segment");
+    return const_iterator(node);
+}
+
+template <typename T>
+constexpr bool CircularList<T>::const_segment_iterator::operator==(
+    const const_segment_iterator& other) const {
     return node == other.node;
 }
 
 template <typename T>
-bool CircularList<T>::iterator::operator!=(const iterator& other) const {
+constexpr bool CircularList<T>::const_segment_iterator::operator!=(
+    const const_segment_iterator& other) const {
     return node != other.node;
 }
 
 // Размер и проверка на пустоту
 template <typename T>
-size_t CircularList<T>::size() const {
+constexpr size_t CircularList<T>::size() const {
     return count;
 }
 
 template <typename T>
-bool CircularList<T>::empty() const {
+constexpr bool CircularList<T>::empty() const {
     return count == 0;
 }
 
 // Доступ к элементам
 template <typename T>
-T& CircularList<T>::front() {
+constexpr T& CircularList<T>::front() {
     if (empty()) throw std::out_of_range("CircularList::front: empty list");
-    return head->data;
+    return as_node(sentinel.next)->data;
 }
 
 template <typename T>
-const T& CircularList<T>::front() const {
+constexpr const T& CircularList<T>::front() const {
     if (empty()) throw std::out_of_range("CircularList::front: empty list");
-    return head->data;
+    return as_node(sentinel.next)->data;
 }
 
 template <typename T>
-T& CircularList<T>::back() {
+constexpr T& CircularList<T>::back() {
     if (empty()) throw std::out_of_range("CircularList::back: empty list");
-    return head->prev->data;
+    return as_node(sentinel.prev)->data;
 }
 
 template <typename T>
-const T& CircularList<T>::back() const {
+constexpr const T& CircularList<T>::back() const {
     if (empty()) throw std::out_of_range("CircularList::back: empty list");
-    return head->prev->data;
+    return as_node(sentinel.prev)->data;
 }
 
 // Модификаторы
 template <typename T>
-void CircularList<T>::push_back(const T& value) {
-    Node* node = new Node(value);
-    if (!head) {
-        head = node;
-    } else {
-        Node* tail = head->prev;
-        tail->next = node;
-        node->prev = tail;
-        node->next = head;
-        head->prev = node;
-    }
+constexpr void CircularList<T>::push_back(const T& value) {
+    link_before(create_node(value), &sentinel);
     ++count;
+    maybe_auto_compact();
 }
 
 template <typename T>
-void CircularList<T>::push_front(const T& value) {
-    push_back(value);
-    head = head->prev;
+constexpr void CircularList<T>::push_front(const T& value) {
+    link_before(create_node(value), sentinel.next);
+    ++count;
+    maybe_auto_compact();
 }
 
 template <typename T>
-void CircularList<T>::clear() {
-    while (!empty()) {
-        pop_front();
+constexpr void CircularList<T>::clear() {
+    Link* current = sentinel.next;
+    while (current != &sentinel) {
+        Link* next = current->next;
+        destroy_node(as_node(current));
+        current = next;
     }
+    sentinel.next = sentinel.prev = &sentinel;
+    count = 0;
+    mutations_since_compact = 0;
 }
 
 template <typename T>
-void CircularList<T>::assign(size_t n, const T& value) {
+constexpr void CircularList<T>::assign(size_t n, const T& value) {
     clear();
     for (size_t i = 0; i < n; ++i) {
         push_back(value);
@@ -552,9 +1168,255 @@ void CircularList<T>::assign(size_t n, const T& value) {
 }
 
 template <typename T>
-void CircularList<T>::swap(CircularList& other) noexcept {
-    std::swap(head, other.head);
+constexpr void CircularList<T>::swap(CircularList& other) noexcept {
+    Link temp;
+    move_ring(temp, sentinel);
+    move_ring(sentinel, other.sentinel);
+    move_ring(other.sentinel, temp);
     std::swap(count, other.count);
+    std::swap(slabs, other.slabs);
+    std::swap(auto_compact_threshold, other.auto_compact_threshold);
+    std::swap(mutations_since_compact, other.mutations_since_compact);
+}
+
+template <typename T>
+constexpr void CircularList<T>::rotate(std::ptrdiff_t n) {
+    if (count < 2) return;
+    auto size = static_cast<std::ptrdiff_t>(count);
+    std::ptrdiff_t steps = n % size;
+    if (steps < 0) steps += size;
+    if (steps == 0) return;
+    // Без стража кольцо узлов замкнуто; страж встаёт перед новой головой
+    Link* first = sentinel.next;
+    unlink(&sentinel);
+    if (steps <= size / 2) {
+        for (std::ptrdiff_t i = 0; i < steps; ++i) first = first->next;
+    } else {
+        for (std::ptrdiff_t i = steps; i < size; ++i) first = first->prev;
+    }
+    link_before(&sentinel, first);
+}
+
+template <typename T>
+constexpr CircularList<T> CircularList<T>::split_at(iterator pos,
+                                                    size_t index) {
+    if (index > count)
+        throw std::out_of_range("CircularList::split_at: bad index");
+    if ((pos.node == &sentinel) != (index == count) ||
+        (pos.node == sentinel.next) != (index == 0)) {
+        throw std::invalid_argument(
+            "CircularList::split_at: index does not match iterator");
+    }
+    CircularList tail;
+    tail.auto_compact_threshold = auto_compact_threshold;
+    if (index == count) return tail;
+    if (index == 0) {
+        move_ring(tail.sentinel, sentinel);
+        tail.count = count;
+        tail.slabs = std::move(slabs);
+        slabs.clear();
+        count = 0;
+        return tail;
+    }
+    // Узлы обеих частей могут лежать в одних блоках уплотнения: узлы
+    // хвоста в каждом блоке считаются обходом меньшей из частей, и каждая
+    // часть ссылается только на блоки со своими узлами. Без блоков разрез
+    // остаётся O(1)
+    std::vector<size_t> moved;
+    if (!slabs.empty()) {
+        moved.assign(slabs.size(), 0);
+        tail.slabs.reserve(slabs.size());
+        bool walk_tail = count - index <= index;
+        Link* stop = walk_tail ? &sentinel : pos.node;
+        for (Link* current = walk_tail ? pos.node : sentinel.next;
+             current != stop; current = current->next) {
+            size_t i = slab_index(as_node(current));
+            if (i < slabs.size()) ++moved[i];
+        }
+        if (!walk_tail) {
+            for (size_t i = 0; i < slabs.size(); ++i)
+                moved[i] = slabs[i].live - moved[i];
+        }
+    }
+    for (size_t i = 0; i < moved.size(); ++i) {
+        if (moved[i] == 0) continue;
+        tail.slabs.push_back({slabs[i].slab, moved[i]});
+        slabs[i].live -= moved[i];
+    }
+    std::erase_if(slabs, [](const SlabUse& use) { return use.live == 0; });
+    Link* first = pos.node;
+    Link* before = first->prev;
+    Link* last = sentinel.prev;
+    before->next = &sentinel;
+    sentinel.prev = before;
+    tail.sentinel.next = first;
+    first->prev = &tail.sentinel;
+    tail.sentinel.prev = last;
+    last->next = &tail.sentinel;
+    tail.count = count - index;
+    count = index;
+    return tail;
+}
+
+template <typename T>
+constexpr CircularList<T> CircularList<T>::split_at(iterator pos) {
+    size_t index = 0;
+    for (Link* current = sentinel.next;
+         current != pos.node && current != &sentinel;
+         current = current->next) {
+        ++index;
+    }
+    return split_at(pos, index);
+}
+
+template <typename T>
+constexpr void CircularList<T>::concat(CircularList&& other) {
+    if (&other == this || other.empty()) return;
+    slabs.reserve(slabs.size() + other.slabs.size());
+    for (auto& use : other.slabs) {
+        auto same = std::find_if(
+            slabs.begin(), slabs.end(),
+            [&use](const SlabUse& own) { return own.slab == use.slab; });
+        if (same == slabs.end()) {
+            slabs.push_back(std::move(use));
+        } else {
+            same->live += use.live;
+        }
+    }
+    other.slabs.clear();
+    Link* first = other.sentinel.next;
+    Link* last = other.sentinel.prev;
+    Link* tail = sentinel.prev;
+    tail->next = first;
+    first->prev = tail;
+    last->next = &sentinel;
+    sentinel.prev = last;
+    other.sentinel.next = other.sentinel.prev = &other.sentinel;
+    count += other.count;
+    other.count = 0;
+}
+
+// Уплотнение
+template <typename T>
+CircularList<T>::Slab::Slab(size_t n)
+    : nodes(std::allocator<Node>().allocate(n)), capacity(n) {
+}
+
+template <typename T>
+CircularList<T>::Slab::~Slab() {
+    std::allocator<Node>().deallocate(nodes, capacity);
+}
+
+template <typename T>
+bool CircularList<T>::Slab::contains(const Node* node) const {
+    return !std::less<const Node*>()(node, nodes) &&
+           std::less<const Node*>()(node, nodes + capacity);
+}
+
+template <typename T>
+constexpr typename CircularList<T>::Node* CircularList<T>::create_node(
+    const T& value) {
+    return new Node(value);
+}
+
+template <typename T>
+constexpr void CircularList<T>::destroy_node(Node* node) noexcept {
+    size_t i = slab_index(node);
+    if (i == slabs.size()) {
+        delete node;
+        return;
+    }
+    node->~Node();
+    if (--slabs[i].live == 0) slabs.erase(slabs.begin() + i);
+}
+
+template <typename T>
+constexpr size_t CircularList<T>::slab_index(const Node* node) const noexcept {
+    size_t i = 0;
+    while (i < slabs.size() && !slabs[i].slab->contains(node)) ++i;
+    return i;
+}
+
+template <typename T>
+void CircularList<T>::compact()
+    requires std::is_nothrow_move_constructible_v<T>
+{
+    compact_nodes(nullptr);
+}
+
+template <typename T>
+void CircularList<T>::compact_nodes(Link** tracked) {
+    mutations_since_compact = 0;
+    if (count == 0) return;
+
+    // Всё, что может бросить исключение, делаем до переноса узлов
+    auto slab = std::make_shared<Slab>(count);
+    slabs.reserve(slabs.size() + 1);
+
+    Node* nodes = slab->nodes;
+    Link* current = sentinel.next;
+    for (size_t i = 0; i < count; ++i) {
+        Link* next = current->next;
+        ::new (static_cast<void*>(nodes + i))
+            Node(std::move(as_node(current)->data));
+        if (tracked && *tracked == current) *tracked = nodes + i;
+        destroy_node(as_node(current));
+        current = next;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        nodes[i].next = i + 1 < count ? &nodes[i + 1] : &sentinel;
+        nodes[i].prev = i > 0 ? &nodes[i - 1] : &sentinel;
+    }
+    sentinel.next = nodes;
+    sentinel.prev = nodes + count - 1;
+    slabs.push_back({std::move(slab), count});
+}
+
+template <typename T>
+double CircularList<T>::locality() const {
+    if (count < 2) return 1.0;
+    size_t adjacent = 0;
+    const Link* current = sentinel.next;
+    for (size_t i = 0; i + 1 < count; ++i) {
+        auto from = reinterpret_cast<std::uintptr_t>(current);
+        auto to = reinterpret_cast<std::uintptr_t>(current->next);
+        if (to > from && to - from <= kLocalityWindow) ++adjacent;
+        current = current->next;
+    }
+    return double(adjacent) / double(count - 1);
+}
+
+template <typename T>
+size_t CircularList<T>::slab_count() const noexcept {
+    return slabs.size();
+}
+
+template <typename T>
+void CircularList<T>::set_auto_compact(double threshold)
+    requires std::is_nothrow_move_constructible_v<T>
+{
+    auto_compact_threshold = threshold;
+    mutations_since_compact = 0;
+}
+
+template <typename T>
+constexpr void CircularList<T>::maybe_auto_compact(Link** tracked) noexcept {
+    if constexpr (std::is_nothrow_move_constructible_v<T>) {
+        if (std::is_constant_evaluated()) return;
+        if (auto_compact_threshold <= 0) return;
+        if (++mutations_since_compact <
+            std::max(count, kAutoCompactMinMutations)) {
+            return;
+        }
+        mutations_since_compact = 0;
+        if (locality() >= auto_compact_threshold) return;
+        try {
+            compact_nodes(tracked);
+        } catch (const std::bad_alloc&) {
+            // Уплотнение - оптимизация: без памяти под блок список остаётся
+            // как есть
+        }
+    }
 }
 
 #endif
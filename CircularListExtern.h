@@ -0,0 +1,17 @@
+#ifndef CIRCULAR_LIST_EXTERN_H
+#define CIRCULAR_LIST_EXTERN_H
+
+#include <string>
+
+#include "CircularList.h"
+
+// Объявления явных инстанцирований из CircularList.cpp
+// (libcircularlist.a). Единица трансляции, подключившая этот заголовок
+// вместо CircularList.h, не инстанцирует заново не встраиваемые члены
+// CircularList<int> и CircularList<std::string>; при сборке с
+// оптимизацией компилятор по-прежнему может инстанцировать
+// constexpr-члены для встраивания.
+extern template class CircularList<int>;
+extern template class CircularList<std::string>;
+
+#endif
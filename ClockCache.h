@@ -0,0 +1,408 @@
+#ifndef CLOCK_CACHE_H
+#define CLOCK_CACHE_H
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "CircularList.h"
+
+// Кэш с вытеснением CLOCK (второй шанс). Записи лежат в кольце
+// CircularList, хэш-таблица ведёт от ключа к узлу кольца. Попадание
+// только выставляет бит обращения (relaxed-атомик) и не трогает связи,
+// поэтому get() можно вызывать параллельно под разделяемой блокировкой;
+// put() и erase() требуют исключительной. При вставке в полный кэш
+// стрелка идёт по кольцу, сбрасывая биты, и вытесняет первую запись со
+// сброшенным битом; новая запись встаёт перед стрелкой.
+template <typename K, typename V, typename Hash = std::hash<K>>
+class ClockCache {
+    private:
+        struct Entry {
+                K key;
+                V value;
+                mutable std::atomic<bool> referenced;
+                Entry(const K& k, const V& v)
+                    : key(k), value(v), referenced(false) {}
+                Entry(const Entry& other)
+                    : key(other.key), value(other.value),
+                      referenced(other.referenced.load(
+                          std::memory_order_relaxed)) {}
+        };
+
+        using Ring = CircularList<Entry>;
+        using Position = typename Ring::iterator;
+
+        size_t max_size;
+        Ring ring;
+        std::unordered_map<K, Position, Hash> index;
+        Position hand;  // end() только у пустого кэша
+
+        // Итератор CircularList разыменовывается только неконстантным
+        static Entry& entry(Position pos) { return *pos; }
+        void evict();
+
+    public:
+        explicit ClockCache(size_t capacity);
+        ClockCache(const ClockCache&) = delete;
+        ClockCache& operator=(const ClockCache&) = delete;
+
+        // Указатель на значение или nullptr; действителен до ближайшего
+        // put() или erase()
+        V* get(const K& key);
+        bool contains(const K& key) const;
+        // Вставка или замена значения; замена считается обращением
+        void put(const K& key, const V& value);
+        bool erase(const K& key);
+        void clear();
+
+        size_t size() const;
+        size_t capacity() const;
+        bool empty() const;
+};
+
+// CLOCK-Pro (Jiang, Chen, Zhang, 2005): резидентные записи делятся на
+// горячие и холодные, а вытесненные холодные ещё какое-то время остаются
+// в кольце без значения (тестовые) и помнят, что к ним недавно
+// обращались. Повторное обращение к тестовой записи возвращает её сразу
+// горячей и увеличивает долю холодных мест. Три стрелки (hot, cold, test)
+// идут по одному кольцу. Попадание, как и в ClockCache, только
+// выставляет бит. Кольцо хранит не более capacity резидентных и не более
+// capacity тестовых записей; capacity не меньше 2, и хотя бы одно место
+// всегда остаётся за горячими записями.
+//
+// Каждая стрелка делает за вызов один шаг и не запускает другие стрелки
+// (кроме сдвига тестовой стрелки горячей); циклы в add_entry ограничены
+// двумя оборотами по кольцу.
+template <typename K, typename V, typename Hash = std::hash<K>>
+class ClockProCache {
+    private:
+        enum class Kind { hot, cold, test };
+
+        struct Entry {
+                K key;
+                std::optional<V> value;  // пусто у тестовой записи
+                Kind kind;
+                mutable std::atomic<bool> referenced;
+                Entry(const K& k, const V& v, Kind t)
+                    : key(k), value(v), kind(t), referenced(false) {}
+                Entry(const Entry& other)
+                    : key(other.key), value(other.value), kind(other.kind),
+                      referenced(other.referenced.load(
+                          std::memory_order_relaxed)) {}
+        };
+
+        using Ring = CircularList<Entry>;
+        using Position = typename Ring::iterator;
+
+        size_t max_size;
+        size_t cold_target;  // желаемое число холодных резидентных мест
+        size_t hot_count;
+        size_t cold_count;
+        size_t test_count;
+        Ring ring;
+        std::unordered_map<K, Position, Hash> index;
+        Position hand_hot;
+        Position hand_cold;
+        Position hand_test;
+
+        static Entry& entry(Position pos) { return *pos; }
+        // Вставка записи перед hand_hot с освобождением места под неё
+        void add_entry(const K& key, const V& value, Kind kind);
+        void remove_entry(Position pos);
+        // Шаг стрелки: обработка записи под ней и сдвиг на одну позицию
+        void step_hand_cold();
+        void step_hand_hot();
+        void step_hand_test();
+
+    public:
+        // capacity < 2 - std::invalid_argument
+        explicit ClockProCache(size_t capacity);
+        ClockProCache(const ClockProCache&) = delete;
+        ClockProCache& operator=(const ClockProCache&) = delete;
+
+        V* get(const K& key);
+        bool contains(const K& key) const;
+        void put(const K& key, const V& value);
+        bool erase(const K& key);
+
+        // Число резидентных записей
+        size_t size() const;
+        size_t capacity() const;
+        bool empty() const;
+        size_t hot_size() const;
+        size_t test_size() const;
+};
+
+// ClockCache
+template <typename K, typename V, typename Hash>
+ClockCache<K, V, Hash>::ClockCache(size_t capacity) : max_size(capacity) {
+    if (capacity == 0)
+        throw std::invalid_argument("ClockCache: capacity must be > 0");
+    index.reserve(capacity);
+    hand = ring.end();
+}
+
+template <typename K, typename V, typename Hash>
+V* ClockCache<K, V, Hash>::get(const K& key) {
+    auto found = index.find(key);
+    if (found == index.end()) return nullptr;
+    Entry& found_entry = entry(found->second);
+    found_entry.referenced.store(true, std::memory_order_relaxed);
+    return &found_entry.value;
+}
+
+template <typename K, typename V, typename Hash>
+bool ClockCache<K, V, Hash>::contains(const K& key) const {
+    return index.find(key) != index.end();
+}
+
+template <typename K, typename V, typename Hash>
+void ClockCache<K, V, Hash>::evict() {
+    while (entry(hand).referenced.load(std::memory_order_relaxed)) {
+        entry(hand).referenced.store(false, std::memory_order_relaxed);
+        hand = ring.ring_next(hand);
+    }
+    index.erase(entry(hand).key);
+    Position victim = hand;
+    hand = ring.size() == 1 ? ring.end() : ring.ring_next(hand);
+    ring.erase(victim);
+}
+
+template <typename K, typename V, typename Hash>
+void ClockCache<K, V, Hash>::put(const K& key, const V& value) {
+    auto found = index.find(key);
+    if (found != index.end()) {
+        entry(found->second).value = value;
+        entry(found->second).referenced.store(true, std::memory_order_relaxed);
+        return;
+    }
+    if (ring.size() == max_size) evict();
+    Position pos = ring.insert(hand, Entry(key, value));
+    try {
+        index.emplace(key, pos);
+    } catch (...) {
+        ring.erase(pos);
+        throw;
+    }
+    if (hand == ring.end()) hand = pos;
+}
+
+template <typename K, typename V, typename Hash>
+bool ClockCache<K, V, Hash>::erase(const K& key) {
+    auto found = index.find(key);
+    if (found == index.end()) return false;
+    Position pos = found->second;
+    index.erase(found);
+    if (pos == hand) {
+        hand = ring.size() == 1 ? ring.end() : ring.ring_next(hand);
+    }
+    ring.erase(pos);
+    return true;
+}
+
+template <typename K, typename V, typename Hash>
+void ClockCache<K, V, Hash>::clear() {
+    index.clear();
+    ring.clear();
+    hand = ring.end();
+}
+
+template <typename K, typename V, typename Hash>
+size_t ClockCache<K, V, Hash>::size() const {
+    return ring.size();
+}
+
+template <typename K, typename V, typename Hash>
+size_t ClockCache<K, V, Hash>::capacity() const {
+    return max_size;
+}
+
+template <typename K, typename V, typename Hash>
+bool ClockCache<K, V, Hash>::empty() const {
+    return ring.empty();
+}
+
+// ClockProCache
+template <typename K, typename V, typename Hash>
+ClockProCache<K, V, Hash>::ClockProCache(size_t capacity)
+    : max_size(capacity), cold_target(capacity - 1), hot_count(0),
+      cold_count(0), test_count(0) {
+    // При одном месте горячей записи негде жить, а холодной - вытесняться
+    if (capacity < 2)
+        throw std::invalid_argument("ClockProCache: capacity must be >= 2");
+    index.reserve(2 * capacity);
+    hand_hot = hand_cold = hand_test = ring.end();
+}
+
+template <typename K, typename V, typename Hash>
+V* ClockProCache<K, V, Hash>::get(const K& key) {
+    auto found = index.find(key);
+    if (found == index.end()) return nullptr;
+    Entry& found_entry = entry(found->second);
+    if (found_entry.kind == Kind::test) return nullptr;
+    found_entry.referenced.store(true, std::memory_order_relaxed);
+    return &*found_entry.value;
+}
+
+template <typename K, typename V, typename Hash>
+bool ClockProCache<K, V, Hash>::contains(const K& key) const {
+    auto found = index.find(key);
+    return found != index.end() &&
+           entry(found->second).kind != Kind::test;
+}
+
+template <typename K, typename V, typename Hash>
+void ClockProCache<K, V, Hash>::put(const K& key, const V& value) {
+    auto found = index.find(key);
+    if (found == index.end()) {
+        add_entry(key, value, Kind::cold);
+        ++cold_count;
+        return;
+    }
+    Entry& found_entry = entry(found->second);
+    if (found_entry.kind != Kind::test) {
+        found_entry.value = value;
+        found_entry.referenced.store(true, std::memory_order_relaxed);
+        return;
+    }
+    // Обращение к недавно вытесненной записи: холодных мест было мало
+    if (cold_target < max_size - 1) ++cold_target;
+    remove_entry(found->second);
+    --test_count;
+    add_entry(key, value, Kind::hot);
+    ++hot_count;
+}
+
+template <typename K, typename V, typename Hash>
+bool ClockProCache<K, V, Hash>::erase(const K& key) {
+    auto found = index.find(key);
+    if (found == index.end()) return false;
+    Kind kind = entry(found->second).kind;
+    remove_entry(found->second);
+    if (kind == Kind::hot) --hot_count;
+    if (kind == Kind::cold) --cold_count;
+    if (kind == Kind::test) --test_count;
+    return kind != Kind::test;
+}
+
+template <typename K, typename V, typename Hash>
+void ClockProCache<K, V, Hash>::add_entry(const K& key, const V& value,
+                                          Kind kind) {
+    // Холодная стрелка освобождает место за два оборота: горячих записей
+    // не больше max_size - cold_target < max_size, и лишние понижаются
+    while (hot_count + cold_count >= max_size) {
+        step_hand_cold();
+        for (size_t steps = 0;
+             test_count > max_size && steps < 2 * ring.size(); ++steps)
+            step_hand_test();
+        for (size_t steps = 0; hot_count > max_size - cold_target &&
+                               steps < 2 * ring.size();
+             ++steps)
+            step_hand_hot();
+    }
+
+    Position pos = ring.insert(hand_hot, Entry(key, value, kind));
+    try {
+        index.emplace(key, pos);
+    } catch (...) {
+        ring.erase(pos);
+        throw;
+    }
+    if (hand_hot == ring.end()) {
+        hand_hot = hand_cold = hand_test = pos;
+    }
+    if (hand_cold == hand_hot) hand_cold = ring.ring_prev(hand_cold);
+}
+
+template <typename K, typename V, typename Hash>
+void ClockProCache<K, V, Hash>::remove_entry(Position pos) {
+    index.erase(entry(pos).key);
+    if (ring.size() == 1) {
+        hand_hot = hand_cold = hand_test = ring.end();
+    } else {
+        if (pos == hand_hot) hand_hot = ring.ring_prev(hand_hot);
+        if (pos == hand_cold) hand_cold = ring.ring_prev(hand_cold);
+        if (pos == hand_test) hand_test = ring.ring_prev(hand_test);
+    }
+    ring.erase(pos);
+}
+
+template <typename K, typename V, typename Hash>
+void ClockProCache<K, V, Hash>::step_hand_cold() {
+    Entry& current = entry(hand_cold);
+    if (current.kind == Kind::cold) {
+        if (current.referenced.load(std::memory_order_relaxed)) {
+            // Холодная запись, к которой обращались, становится горячей
+            current.kind = Kind::hot;
+            current.referenced.store(false, std::memory_order_relaxed);
+            --cold_count;
+            ++hot_count;
+        } else {
+            current.kind = Kind::test;
+            current.value.reset();
+            --cold_count;
+            ++test_count;
+        }
+    }
+    hand_cold = ring.ring_next(hand_cold);
+}
+
+template <typename K, typename V, typename Hash>
+void ClockProCache<K, V, Hash>::step_hand_hot() {
+    // Горячая стрелка не обгоняет тестовую, а толкает её перед собой
+    if (hand_hot == hand_test) step_hand_test();
+    Entry& current = entry(hand_hot);
+    if (current.kind == Kind::hot) {
+        if (current.referenced.load(std::memory_order_relaxed)) {
+            current.referenced.store(false, std::memory_order_relaxed);
+        } else {
+            current.kind = Kind::cold;
+            --hot_count;
+            ++cold_count;
+        }
+    }
+    hand_hot = ring.ring_next(hand_hot);
+}
+
+template <typename K, typename V, typename Hash>
+void ClockProCache<K, V, Hash>::step_hand_test() {
+    if (entry(hand_test).kind == Kind::test) {
+        Position expired = hand_test;
+        hand_test = ring.ring_prev(hand_test);
+        remove_entry(expired);
+        --test_count;
+        // Тестовая запись истекла без обращений: холодных мест хватает
+        if (cold_target > 1) --cold_target;
+    }
+    hand_test = ring.ring_next(hand_test);
+}
+
+template <typename K, typename V, typename Hash>
+size_t ClockProCache<K, V, Hash>::size() const {
+    return hot_count + cold_count;
+}
+
+template <typename K, typename V, typename Hash>
+size_t ClockProCache<K, V, Hash>::capacity() const {
+    return max_size;
+}
+
+template <typename K, typename V, typename Hash>
+bool ClockProCache<K, V, Hash>::empty() const {
+    return size() == 0;
+}
+
+template <typename K, typename V, typename Hash>
+size_t ClockProCache<K, V, Hash>::hot_size() const {
+    return hot_count;
+}
+
+template <typename K, typename V, typename Hash>
+size_t ClockProCache<K, V, Hash>::test_size() const {
+    return test_count;
+}
+
+#endif
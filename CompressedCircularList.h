@@ -0,0 +1,530 @@
+#ifndef COMPRESSED_CIRCULAR_LIST_H
+#define COMPRESSED_CIRCULAR_LIST_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+// Кольцевой список целых чисел, хранящий значения сжатыми блоками. Блок
+// держит первое значение целиком, а каждое следующее - как разность
+// соседних разностей ("delta-of-delta"), закодированную zigzag и varint.
+// Монотонные ряды с почти постоянным шагом (отметки времени, счётчики)
+// занимают 1-3 байта на элемент вместо 24+ байт узла CircularList.
+//
+// push_back и pop_front - O(1): блок помнит последнее значение и разность
+// для дописывания и первое живое значение с его разностью для снятия
+// головы. Обход распаковывает значения на лету. insert и erase в середине
+// распаковывают и заново сжимают один блок (O(kChunkElements)); pop_back
+// по той же причине тоже O(kChunkElements).
+//
+// Итераторы константные и действительны до любого изменения списка.
+template <typename T = uint64_t>
+class CompressedCircularList {
+        static_assert(std::is_integral_v<T> && sizeof(T) <= sizeof(uint64_t),
+                      "CompressedCircularList: T must be an integer type");
+
+    public:
+        using value_type = T;
+
+        // Наибольшее число значений в блоке
+        static constexpr size_t kChunkElements = 512;
+
+    private:
+        struct Chunk {
+                uint64_t head = 0;        // первое живое значение
+                uint64_t head_delta = 0;  // его разность с предыдущим
+                size_t head_offset = 0;   // начало кода следующего за head
+                uint64_t tail = 0;        // последнее значение
+                uint64_t tail_delta = 0;
+                uint32_t size = 0;     // живые значения
+                uint32_t encoded = 0;  // все записанные, включая снятые
+                std::vector<uint8_t> bytes;
+        };
+
+        std::deque<Chunk> chunks;
+        size_t count = 0;
+
+        static uint64_t zigzag(uint64_t delta);
+        static uint64_t unzigzag(uint64_t code);
+        static void put_varint(std::vector<uint8_t>& bytes, uint64_t code);
+        static uint64_t get_varint(const uint8_t*& p);
+        // Дописывание значения в блок, в котором есть место
+        static void append(Chunk& chunk, uint64_t value);
+        static Chunk make_chunk(const uint64_t* values, size_t n);
+        // Распаковка живых значений блока
+        static std::vector<uint64_t> unpack(const Chunk& chunk);
+        // Блок и номер в нём для элемента index
+        size_t locate(size_t& index) const;
+        // Замена блока c блоками из values (по kChunkElements / 2 и больше)
+        void repack(size_t c, const std::vector<uint64_t>& values);
+
+    public:
+        class const_iterator;
+        using iterator = const_iterator;
+
+        // Итераторы; разыменование распаковывает значение
+        const_iterator begin() const;
+        const_iterator end() const;
+        const_iterator cbegin() const;
+        const_iterator cend() const;
+
+        // Обход с распаковкой; если f возвращает bool, false прекращает
+        // обход
+        template <typename F>
+        void for_each(F f) const;
+
+        // Размер и проверка на пустоту
+        size_t size() const;
+        bool empty() const;
+        // Память под блоки и их коды в байтах
+        size_t memory_bytes() const;
+
+        // Доступ к элементам
+        T front() const;
+        T back() const;
+        // O(число блоков + kChunkElements)
+        T at(size_t index) const;
+
+        // Модификаторы
+        void push_back(T value);
+        void pop_front();
+        void pop_back();
+        void clear();
+        // Вставка перед элементом index (index == size() - в конец)
+        void insert(size_t index, T value);
+        void erase(size_t index);
+        // Сдвиг начала кольца на n позиций вперёд (назад при n < 0);
+        // O(n mod size()), так как значения переносятся из головы в хвост
+        void rotate(std::ptrdiff_t n);
+        void swap(CompressedCircularList& other) noexcept;
+
+        // Операторы сравнения
+        bool operator==(const CompressedCircularList& other) const;
+        bool operator!=(const CompressedCircularList& other) const;
+        bool operator<(const CompressedCircularList& other) const;
+        bool operator>(const CompressedCircularList& other) const;
+        bool operator<=(const CompressedCircularList& other) const;
+        bool operator>=(const CompressedCircularList& other) const;
+
+        class const_iterator {
+                const CompressedCircularList* list;
+                size_t chunk;
+                uint32_t left;  // значения блока после текущего
+                uint64_t value;
+                uint64_t delta;
+                const uint8_t* code;
+
+                void enter_chunk();
+
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using value_type = T;
+                using difference_type = std::ptrdiff_t;
+                using pointer = void;
+                using reference = T;
+                const_iterator();
+                const_iterator(const CompressedCircularList* l, size_t c);
+                T operator*() const;
+                const_iterator& operator++();
+                bool operator==(const const_iterator& other) const;
+                bool operator!=(const const_iterator& other) const;
+        };
+};
+
+// Кодирование
+template <typename T>
+uint64_t CompressedCircularList<T>::zigzag(uint64_t delta) {
+    return (delta << 1) ^ (0 - (delta >> 63));
+}
+
+template <typename T>
+uint64_t CompressedCircularList<T>::unzigzag(uint64_t code) {
+    return (code >> 1) ^ (0 - (code & 1));
+}
+
+template <typename T>
+void CompressedCircularList<T>::put_varint(std::vector<uint8_t>& bytes,
+                                           uint64_t code) {
+    while (code >= 0x80) {
+        bytes.push_back(uint8_t(code | 0x80));
+        code >>= 7;
+    }
+    bytes.push_back(uint8_t(code));
+}
+
+template <typename T>
+uint64_t CompressedCircularList<T>::get_varint(const uint8_t*& p) {
+    uint64_t code = 0;
+    for (unsigned shift = 0;; shift += 7) {
+        uint8_t byte = *p++;
+        code |= uint64_t(byte & 0x7f) << shift;
+        if (byte < 0x80) return code;
+    }
+}
+
+template <typename T>
+void CompressedCircularList<T>::append(Chunk& chunk, uint64_t value) {
+    if (chunk.size == 0) {
+        chunk = Chunk();
+        chunk.head = chunk.tail = value;
+        chunk.size = chunk.encoded = 1;
+        return;
+    }
+    uint64_t delta = value - chunk.tail;
+    put_varint(chunk.bytes, zigzag(delta - chunk.tail_delta));
+    chunk.tail = value;
+    chunk.tail_delta = delta;
+    ++chunk.size;
+    // Заполненный блок больше не растёт: запас ёмкости не нужен
+    if (++chunk.encoded == kChunkElements) chunk.bytes.shrink_to_fit();
+}
+
+template <typename T>
+typename CompressedCircularList<T>::Chunk
+CompressedCircularList<T>::make_chunk(const uint64_t* values, size_t n) {
+    Chunk chunk;
+    for (size_t i = 0; i < n; ++i) append(chunk, values[i]);
+    chunk.bytes.shrink_to_fit();
+    return chunk;
+}
+
+template <typename T>
+std::vector<uint64_t> CompressedCircularList<T>::unpack(const Chunk& chunk) {
+    std::vector<uint64_t> values;
+    values.reserve(chunk.size + 1);
+    uint64_t value = chunk.head;
+    uint64_t delta = chunk.head_delta;
+    const uint8_t* p = chunk.bytes.data() + chunk.head_offset;
+    values.push_back(value);
+    for (uint32_t i = 1; i < chunk.size; ++i) {
+        delta += unzigzag(get_varint(p));
+        value += delta;
+        values.push_back(value);
+    }
+    return values;
+}
+
+template <typename T>
+size_t CompressedCircularList<T>::locate(size_t& index) const {
+    size_t c = 0;
+    while (index >= chunks[c].size) index -= chunks[c++].size;
+    return c;
+}
+
+template <typename T>
+void CompressedCircularList<T>::repack(size_t c,
+                                       const std::vector<uint64_t>& values) {
+    std::vector<Chunk> packed;
+    for (size_t begin = 0; begin < values.size();) {
+        size_t n = std::min(values.size() - begin, kChunkElements / 2);
+        // Хвост короче половины блока присоединяется к последней части
+        if (values.size() - begin - n < kChunkElements / 2)
+            n = values.size() - begin;
+        packed.push_back(make_chunk(values.data() + begin, n));
+        begin += n;
+    }
+    chunks.erase(chunks.begin() + std::ptrdiff_t(c));
+    chunks.insert(chunks.begin() + std::ptrdiff_t(c),
+                  std::make_move_iterator(packed.begin()),
+                  std::make_move_iterator(packed.end()));
+}
+
+// Итераторы
+template <typename T>
+typename CompressedCircularList<T>::const_iterator
+CompressedCircularList<T>::begin() const {
+    return const_iterator(this, 0);
+}
+
+template <typename T>
+typename CompressedCircularList<T>::const_iterator
+CompressedCircularList<T>::end() const {
+    return const_iterator(this, chunks.size());
+}
+
+template <typename T>
+typename CompressedCircularList<T>::const_iterator
+CompressedCircularList<T>::cbegin() const {
+    return begin();
+}
+
+template <typename T>
+typename CompressedCircularList<T>::const_iterator
+CompressedCircularList<T>::cend() const {
+    return end();
+}
+
+template <typename T>
+CompressedCircularList<T>::const_iterator::const_iterator()
+    : list(nullptr), chunk(0), left(0), value(0), delta(0), code(nullptr) {
+}
+
+template <typename T>
+CompressedCircularList<T>::const_iterator::const_iterator(
+    const CompressedCircularList* l, size_t c)
+    : list(l), chunk(c), left(0), value(0), delta(0), code(nullptr) {
+    enter_chunk();
+}
+
+template <typename T>
+void CompressedCircularList<T>::const_iterator::enter_chunk() {
+    if (chunk >= list->chunks.size()) return;
+    const Chunk& current = list->chunks[chunk];
+    value = current.head;
+    delta = current.head_delta;
+    code = current.bytes.data() + current.head_offset;
+    left = current.size - 1;
+}
+
+template <typename T>
+T CompressedCircularList<T>::const_iterator::operator*() const {
+    if (!list || chunk >= list->chunks.size())
+        throw std::out_of_range(
+            "CompressedCircularList::const_iterator::operator*: "
+            "dereferencing end iterator");
+    return T(value);
+}
+
+template <typename T>
+typename CompressedCircularList<T>::const_iterator&
+CompressedCircularList<T>::const_iterator::operator++() {
+    if (!list || chunk >= list->chunks.size())
+        throw std::out_of_range(
+            "CompressedCircularList::const_iterator::operator++: "
+            "incrementing end iterator");
+    if (left == 0) {
+        ++chunk;
+        enter_chunk();
+    } else {
+        delta += unzigzag(get_varint(code));
+        value += delta;
+        --left;
+    }
+    return *this;
+}
+
+template <typename T>
+bool CompressedCircularList<T>::const_iterator::operator==(
+    const const_iterator& other) const {
+    return chunk == other.chunk && left == other.left;
+}
+
+template <typename T>
+bool CompressedCircularList<T>::const_iterator::operator!=(
+    const const_iterator& other) const {
+    return !(*this == other);
+}
+
+template <typename T>
+template <typename F>
+void CompressedCircularList<T>::for_each(F f) const {
+    for (const Chunk& chunk : chunks) {
+        uint64_t value = chunk.head;
+        uint64_t delta = chunk.head_delta;
+        const uint8_t* p = chunk.bytes.data() + chunk.head_offset;
+        for (uint32_t i = 0; i < chunk.size; ++i) {
+            if (i > 0) {
+                delta += unzigzag(get_varint(p));
+                value += delta;
+            }
+            if constexpr (std::is_same_v<std::invoke_result_t<F&, T>, bool>) {
+                if (!f(T(value))) return;
+            } else {
+                f(T(value));
+            }
+        }
+    }
+}
+
+// Размер и проверка на пустоту
+template <typename T>
+size_t CompressedCircularList<T>::size() const {
+    return count;
+}
+
+template <typename T>
+bool CompressedCircularList<T>::empty() const {
+    return count == 0;
+}
+
+template <typename T>
+size_t CompressedCircularList<T>::memory_bytes() const {
+    size_t bytes = 0;
+    for (const Chunk& chunk : chunks)
+        bytes += sizeof(Chunk) + chunk.bytes.capacity();
+    return bytes;
+}
+
+// Доступ к элементам
+template <typename T>
+T CompressedCircularList<T>::front() const {
+    if (empty())
+        throw std::out_of_range("CompressedCircularList::front: empty list");
+    return T(chunks.front().head);
+}
+
+template <typename T>
+T CompressedCircularList<T>::back() const {
+    if (empty())
+        throw std::out_of_range("CompressedCircularList::back: empty list");
+    return T(chunks.back().tail);
+}
+
+template <typename T>
+T CompressedCircularList<T>::at(size_t index) const {
+    if (index >= count)
+        throw std::out_of_range("CompressedCircularList::at: bad index");
+    size_t c = locate(index);
+    const_iterator it(this, c);
+    for (size_t i = 0; i < index; ++i) ++it;
+    return *it;
+}
+
+// Модификаторы
+template <typename T>
+void CompressedCircularList<T>::push_back(T value) {
+    if (chunks.empty() || chunks.back().encoded >= kChunkElements)
+        chunks.emplace_back();
+    append(chunks.back(), uint64_t(value));
+    ++count;
+}
+
+template <typename T>
+void CompressedCircularList<T>::pop_front() {
+    if (empty())
+        throw std::out_of_range(
+            "CompressedCircularList::pop_front: empty list");
+    Chunk& chunk = chunks.front();
+    if (chunk.size == 1) {
+        chunks.pop_front();
+    } else {
+        // Голова сдвигается на одно значение; коды снятых значений остаются
+        // в блоке до его освобождения
+        const uint8_t* p = chunk.bytes.data() + chunk.head_offset;
+        chunk.head_delta += unzigzag(get_varint(p));
+        chunk.head += chunk.head_delta;
+        chunk.head_offset = size_t(p - chunk.bytes.data());
+        --chunk.size;
+    }
+    --count;
+}
+
+template <typename T>
+void CompressedCircularList<T>::pop_back() {
+    if (empty())
+        throw std::out_of_range("CompressedCircularList::pop_back: empty list");
+    size_t last = chunks.size() - 1;
+    if (chunks[last].size == 1) {
+        chunks.pop_back();
+    } else {
+        std::vector<uint64_t> values = unpack(chunks[last]);
+        values.pop_back();
+        chunks[last] = make_chunk(values.data(), values.size());
+    }
+    --count;
+}
+
+template <typename T>
+void CompressedCircularList<T>::clear() {
+    chunks.clear();
+    count = 0;
+}
+
+template <typename T>
+void CompressedCircularList<T>::insert(size_t index, T value) {
+    if (index > count)
+        throw std::out_of_range("CompressedCircularList::insert: bad index");
+    if (index == count) {
+        push_back(value);
+        return;
+    }
+    size_t c = locate(index);
+    std::vector<uint64_t> values = unpack(chunks[c]);
+    values.insert(values.begin() + std::ptrdiff_t(index), uint64_t(value));
+    repack(c, values);
+    ++count;
+}
+
+template <typename T>
+void CompressedCircularList<T>::erase(size_t index) {
+    if (index >= count)
+        throw std::out_of_range("CompressedCircularList::erase: bad index");
+    if (index == 0) {
+        pop_front();
+        return;
+    }
+    size_t c = locate(index);
+    std::vector<uint64_t> values = unpack(chunks[c]);
+    values.erase(values.begin() + std::ptrdiff_t(index));
+    if (values.empty()) {
+        chunks.erase(chunks.begin() + std::ptrdiff_t(c));
+    } else {
+        repack(c, values);
+    }
+    --count;
+}
+
+template <typename T>
+void CompressedCircularList<T>::rotate(std::ptrdiff_t n) {
+    if (count < 2) return;
+    auto size = static_cast<std::ptrdiff_t>(count);
+    std::ptrdiff_t steps = n % size;
+    if (steps < 0) steps += size;
+    // Голова переносится в хвост по одному значению: обе операции O(1)
+    for (std::ptrdiff_t i = 0; i < steps; ++i) {
+        T value = front();
+        pop_front();
+        push_back(value);
+    }
+}
+
+template <typename T>
+void CompressedCircularList<T>::swap(CompressedCircularList& other) noexcept {
+    chunks.swap(other.chunks);
+    std::swap(count, other.count);
+}
+
+// Операторы сравнения
+template <typename T>
+bool CompressedCircularList<T>::operator==(
+    const CompressedCircularList& other) const {
+    return size() == other.size() && std::equal(begin(), end(), other.begin());
+}
+
+template <typename T>
+bool CompressedCircularList<T>::operator!=(
+    const CompressedCircularList& other) const {
+    return !(*this == other);
+}
+
+template <typename T>
+bool CompressedCircularList<T>::operator<(
+    const CompressedCircularList& other) const {
+    return std::lexicographical_compare(begin(), end(), other.begin(),
+                                        other.end());
+}
+
+template <typename T>
+bool CompressedCircularList<T>::operator>(
+    const CompressedCircularList& other) const {
+    return other < *this;
+}
+
+template <typename T>
+bool CompressedCircularList<T>::operator<=(
+    const CompressedCircularList& other) const {
+    return !(other < *this);
+}
+
+template <typename T>
+bool CompressedCircularList<T>::operator>=(
+    const CompressedCircularList& other) const {
+    return !(*this < other);
+}
+
+#endif
@@ -0,0 +1,386 @@
+#ifndef CONSISTENT_HASH_RING_H
+#define CONSISTENT_HASH_RING_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "CircularList.h"
+
+// Кольцо согласованного хэширования. Токены (виртуальные узлы) лежат в
+// CircularList в порядке возрастания позиции, std::map по позициям даёт
+// поиск преемника ключа за O(log n); дальше по часовой стрелке идут по
+// связям кольца. Число токенов бэкенда пропорционально его весу.
+//
+// assign() распределяет ключи с ограничением нагрузки (Mirrokni, Thorup,
+// Zadimoghaddam, 2018): бэкенд с весом w принимает не больше
+// ceil(c * (m + 1) * w / W) ключей, где m - число уже назначенных
+// ключей, W - суммарный вес; занятые бэкенды пропускаются по часовой
+// стрелке. add() и remove() принимают как один бэкенд, так и пакет и
+// возвращают долю пространства ключей, сменившую владельца.
+template <typename Backend, typename Hash = std::hash<Backend>>
+class ConsistentHashRing {
+    private:
+        struct Member {
+                double weight;
+                size_t load;
+        };
+
+        using Members = std::unordered_map<Backend, Member, Hash>;
+
+        struct Token {
+                uint64_t position;
+                const Backend* backend;  // ключ в members, адрес стабилен
+        };
+
+        using Ring = CircularList<Token>;
+        using Position = typename Ring::iterator;
+
+        // Владелец точки кольца: (позиция токена, бэкенд)
+        using Snapshot = std::vector<std::pair<uint64_t, const Backend*>>;
+
+        size_t tokens_per_weight;
+        double load_factor;
+        double total_weight;
+        size_t assigned;
+        Members members;
+        Ring ring;
+        std::map<uint64_t, Position> index;
+
+        static uint64_t mix(uint64_t x);
+        template <typename Key>
+        static uint64_t key_position(const Key& key);
+        // Первый токен с позицией >= point, с переходом через ноль
+        Position successor(uint64_t point) const;
+        void insert_tokens(const Backend* backend, double weight);
+        void erase_tokens(const Backend* backend);
+        Snapshot snapshot() const;
+        static double moved_fraction(const Snapshot& before,
+                                     const Snapshot& after);
+
+    public:
+        static constexpr size_t default_tokens_per_weight = 160;
+
+        // load_factor - коэффициент c ограничения нагрузки, не меньше 1
+        explicit ConsistentHashRing(
+            size_t tokens_per_weight = default_tokens_per_weight,
+            double load_factor = 1.25);
+        ConsistentHashRing(const ConsistentHashRing&) = delete;
+        ConsistentHashRing& operator=(const ConsistentHashRing&) = delete;
+
+        // Изменение состава; возвращают долю пространства ключей, у
+        // которой сменился владелец (1, если кольцо было или стало
+        // пустым). Повторное добавление и удаление отсутствующего бэкенда
+        // бросают std::invalid_argument; при ошибке в пакете кольцо не
+        // меняется.
+        double add(const Backend& backend, double weight = 1.0);
+        double add(const std::vector<std::pair<Backend, double>>& batch);
+        double remove(const Backend& backend);
+        double remove(const std::vector<Backend>& batch);
+
+        // Владелец ключа без учёта нагрузки
+        template <typename Key>
+        const Backend& locate(const Key& key) const;
+        // Назначение ключа с ограничением нагрузки; release() снимает
+        // один назначенный ключ с бэкенда
+        template <typename Key>
+        const Backend& assign(const Key& key);
+        void release(const Backend& backend);
+
+        bool contains(const Backend& backend) const;
+        size_t load(const Backend& backend) const;
+        size_t total_load() const;
+        size_t size() const;
+        bool empty() const;
+        size_t token_count() const;
+};
+
+// Хэширование
+template <typename Backend, typename Hash>
+uint64_t ConsistentHashRing<Backend, Hash>::mix(uint64_t x) {
+    // Финализатор splitmix64
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+template <typename Backend, typename Hash>
+template <typename Key>
+uint64_t ConsistentHashRing<Backend, Hash>::key_position(const Key& key) {
+    return mix(std::hash<Key>()(key));
+}
+
+template <typename Backend, typename Hash>
+typename ConsistentHashRing<Backend, Hash>::Position
+ConsistentHashRing<Backend, Hash>::successor(uint64_t point) const {
+    if (index.empty())
+        throw std::out_of_range("ConsistentHashRing: no backends");
+    auto found = index.lower_bound(point);
+    return found == index.end() ? index.begin()->second : found->second;
+}
+
+template <typename Backend, typename Hash>
+void ConsistentHashRing<Backend, Hash>::insert_tokens(const Backend* backend,
+                                                      double weight) {
+    size_t count = std::max<size_t>(
+        1, size_t(std::llround(weight * double(tokens_per_weight))));
+    uint64_t seed = mix(Hash()(*backend));
+    for (size_t i = 0; i < count; ++i) {
+        uint64_t position = mix(seed + i);
+        // Совпадение позиций двух токенов разрешаем сдвигом
+        while (index.count(position)) ++position;
+        auto next = index.upper_bound(position);
+        Position at = ring.insert(
+            next == index.end() ? ring.end() : next->second,
+            Token{position, backend});
+        try {
+            index.emplace(position, at);
+        } catch (...) {
+            ring.erase(at);
+            throw;
+        }
+    }
+}
+
+template <typename Backend, typename Hash>
+void ConsistentHashRing<Backend, Hash>::erase_tokens(const Backend* backend) {
+    for (auto it = index.begin(); it != index.end();) {
+        Position at = it->second;
+        if ((*at).backend == backend) {
+            ring.erase(at);
+            it = index.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+template <typename Backend, typename Hash>
+typename ConsistentHashRing<Backend, Hash>::Snapshot
+ConsistentHashRing<Backend, Hash>::snapshot() const {
+    Snapshot owners;
+    owners.reserve(ring.size());
+    ring.for_each([&owners](const Token& token) {
+        owners.emplace_back(token.position, token.backend);
+    });
+    return owners;
+}
+
+template <typename Backend, typename Hash>
+double ConsistentHashRing<Backend, Hash>::moved_fraction(
+    const Snapshot& before, const Snapshot& after) {
+    if (before.empty() || after.empty()) return 1.0;
+
+    // Между соседними границами обоих разбиений владелец постоянен;
+    // дуга (prev, point] принадлежит первому токену с позицией >= point
+    std::vector<uint64_t> points;
+    points.reserve(before.size() + after.size());
+    for (const auto& owner : before) points.push_back(owner.first);
+    for (const auto& owner : after) points.push_back(owner.first);
+    std::sort(points.begin(), points.end());
+    points.erase(std::unique(points.begin(), points.end()), points.end());
+
+    long double moved = 0;
+    size_t b = 0;
+    size_t a = 0;
+    uint64_t prev = points.back();
+    for (uint64_t point : points) {
+        while (b < before.size() && before[b].first < point) ++b;
+        while (a < after.size() && after[a].first < point) ++a;
+        const Backend* old_owner = before[b == before.size() ? 0 : b].second;
+        const Backend* new_owner = after[a == after.size() ? 0 : a].second;
+        if (old_owner != new_owner) {
+            uint64_t arc = point - prev;
+            moved += arc == 0 ? 0x1p64L : (long double)arc;
+        }
+        prev = point;
+    }
+    return double(moved / 0x1p64L);
+}
+
+// Конструктор
+template <typename Backend, typename Hash>
+ConsistentHashRing<Backend, Hash>::ConsistentHashRing(size_t tokens,
+                                                      double factor)
+    : tokens_per_weight(tokens), load_factor(factor), total_weight(0),
+      assigned(0) {
+    if (tokens_per_weight == 0)
+        throw std::invalid_argument(
+            "ConsistentHashRing: tokens_per_weight must be > 0");
+    if (!(load_factor >= 1.0))
+        throw std::invalid_argument(
+            "ConsistentHashRing: load_factor must be >= 1");
+}
+
+// Изменение состава
+template <typename Backend, typename Hash>
+double ConsistentHashRing<Backend, Hash>::add(const Backend& backend,
+                                              double weight) {
+    return add(std::vector<std::pair<Backend, double>>{{backend, weight}});
+}
+
+template <typename Backend, typename Hash>
+double ConsistentHashRing<Backend, Hash>::add(
+    const std::vector<std::pair<Backend, double>>& batch) {
+    for (size_t i = 0; i < batch.size(); ++i) {
+        if (!(batch[i].second > 0))
+            throw std::invalid_argument(
+                "ConsistentHashRing::add: weight must be > 0");
+        if (members.count(batch[i].first))
+            throw std::invalid_argument(
+                "ConsistentHashRing::add: backend already present");
+        for (size_t j = 0; j < i; ++j) {
+            if (batch[j].first == batch[i].first)
+                throw std::invalid_argument(
+                    "ConsistentHashRing::add: duplicate backend in batch");
+        }
+    }
+
+    Snapshot before = snapshot();
+    std::vector<const Backend*> added;
+    try {
+        for (const auto& [backend, weight] : batch) {
+            auto member = members.emplace(backend, Member{weight, 0}).first;
+            added.push_back(&member->first);
+            insert_tokens(&member->first, weight);
+            total_weight += weight;
+        }
+    } catch (...) {
+        for (const Backend* backend : added) {
+            erase_tokens(backend);
+            members.erase(members.find(*backend));
+        }
+        total_weight = 0;
+        for (const auto& member : members) {
+            total_weight += member.second.weight;
+        }
+        throw;
+    }
+    return moved_fraction(before, snapshot());
+}
+
+template <typename Backend, typename Hash>
+double ConsistentHashRing<Backend, Hash>::remove(const Backend& backend) {
+    return remove(std::vector<Backend>{backend});
+}
+
+template <typename Backend, typename Hash>
+double ConsistentHashRing<Backend, Hash>::remove(
+    const std::vector<Backend>& batch) {
+    std::vector<typename Members::iterator> removed;
+    for (const Backend& backend : batch) {
+        auto member = members.find(backend);
+        if (member == members.end() ||
+            std::find(removed.begin(), removed.end(), member) !=
+                removed.end())
+            throw std::invalid_argument(
+                "ConsistentHashRing::remove: unknown backend");
+        removed.push_back(member);
+    }
+
+    Snapshot before = snapshot();
+    // Токены удаляются одним проходом по индексу
+    for (auto it = index.begin(); it != index.end();) {
+        Position at = it->second;
+        const Backend* owner = (*at).backend;
+        bool gone = std::any_of(removed.begin(), removed.end(),
+                                [owner](const auto& member) {
+                                    return &member->first == owner;
+                                });
+        if (gone) {
+            ring.erase(at);
+            it = index.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    // Снимок до освобождения бэкендов: их адреса ещё не переиспользованы
+    double moved = moved_fraction(before, snapshot());
+    for (auto member : removed) {
+        total_weight -= member->second.weight;
+        assigned -= member->second.load;
+        members.erase(member);
+    }
+    if (members.empty()) total_weight = 0;
+    return moved;
+}
+
+// Поиск
+template <typename Backend, typename Hash>
+template <typename Key>
+const Backend& ConsistentHashRing<Backend, Hash>::locate(
+    const Key& key) const {
+    Position at = successor(key_position(key));
+    return *(*at).backend;
+}
+
+template <typename Backend, typename Hash>
+template <typename Key>
+const Backend& ConsistentHashRing<Backend, Hash>::assign(const Key& key) {
+    Position at = successor(key_position(key));
+    double per_weight = load_factor * double(assigned + 1) / total_weight;
+    for (size_t step = 0; step < ring.size(); ++step) {
+        const Backend* backend = (*at).backend;
+        Member& member = members.find(*backend)->second;
+        if (double(member.load) < std::ceil(per_weight * member.weight)) {
+            ++member.load;
+            ++assigned;
+            return *backend;
+        }
+        at = ring.ring_next(at);
+    }
+    // Недостижимо: суммарная ёмкость c * (m + 1) > m
+    throw std::logic_error("ConsistentHashRing::assign: all backends full");
+}
+
+template <typename Backend, typename Hash>
+void ConsistentHashRing<Backend, Hash>::release(const Backend& backend) {
+    auto member = members.find(backend);
+    if (member == members.end() || member->second.load == 0)
+        throw std::invalid_argument(
+            "ConsistentHashRing::release: backend has no assigned keys");
+    --member->second.load;
+    --assigned;
+}
+
+template <typename Backend, typename Hash>
+bool ConsistentHashRing<Backend, Hash>::contains(
+    const Backend& backend) const {
+    return members.count(backend) != 0;
+}
+
+template <typename Backend, typename Hash>
+size_t ConsistentHashRing<Backend, Hash>::load(const Backend& backend) const {
+    auto member = members.find(backend);
+    return member == members.end() ? 0 : member->second.load;
+}
+
+template <typename Backend, typename Hash>
+size_t ConsistentHashRing<Backend, Hash>::total_load() const {
+    return assigned;
+}
+
+template <typename Backend, typename Hash>
+size_t ConsistentHashRing<Backend, Hash>::size() const {
+    return members.size();
+}
+
+template <typename Backend, typename Hash>
+bool ConsistentHashRing<Backend, Hash>::empty() const {
+    return members.empty();
+}
+
+template <typename Backend, typename Hash>
+size_t ConsistentHashRing<Backend, Hash>::token_count() const {
+    return ring.size();
+}
+
+#endif
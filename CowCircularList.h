@@ -0,0 +1,401 @@
+#ifndef COW_CIRCULAR_LIST_H
+#define COW_CIRCULAR_LIST_H
+
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+#include "CircularList.h"
+
+// Описатель CircularList с копированием при записи. Копии описателя
+// разделяют одно кольцо под атомарным счётчиком описателей, так что
+// копирование - O(1). Первая изменяющая операция над описателем, кольцо
+// которого разделено, копирует кольцо целиком; последующие изменения идут
+// без копирования. Описатель, последний оставшийся у кольца, читает
+// счётчик с acquire, поэтому его запись упорядочена после чтений
+// описателей, отпущенных в других потоках.
+//
+// Итераторы и ссылки, полученные через const-методы, остаются
+// действительными, пока кольцо не будет скопировано или изменено этим
+// описателем. Изменяемого доступа к кольцу описатель не даёт: вставка,
+// удаление и присваивание элемента по итератору - его собственные методы,
+// поэтому запись не может попасть в кольцо, разделённое с копией.
+template <typename T>
+class CowCircularList {
+    private:
+        // Кольцо и число описателей, разделяющих его
+        struct Shared {
+                CircularList<T> list;
+                std::atomic<long> owners;
+        };
+
+        Shared* ring;
+
+        // Отпускает кольцо; последний описатель удаляет его
+        static void release(Shared* shared) noexcept;
+
+        // Пустое кольцо для описателей, ещё не создавших своё
+        static const CircularList<T>& empty_ring();
+        const CircularList<T>& view() const;
+        // Кольцо в единоличном владении; копирует его, если оно разделено
+        CircularList<T>& mutate();
+        // Изменяемый итератор на элемент pos в кольце после mutate()
+        typename CircularList<T>::iterator writable(
+            typename CircularList<T>::const_iterator pos);
+
+    public:
+        using const_iterator = typename CircularList<T>::const_iterator;
+        using const_reverse_iterator =
+            typename CircularList<T>::const_reverse_iterator;
+        using const_segment_iterator =
+            typename CircularList<T>::const_segment_iterator;
+
+        // Конструкторы
+        CowCircularList();
+        explicit CowCircularList(CircularList<T> list);
+        CowCircularList(const CowCircularList& other);
+        CowCircularList(CowCircularList&& other) noexcept;
+        ~CowCircularList();
+
+        CowCircularList& operator=(const CowCircularList& other);
+        CowCircularList& operator=(CowCircularList&& other) noexcept;
+
+        // Разделение
+        // Число описателей, разделяющих кольцо (0 для пустого описателя)
+        long use_count() const;
+        bool shared() const;
+        const CircularList<T>& get() const;
+
+        // Итераторы только для чтения
+        const_iterator begin() const;
+        const_iterator end() const;
+        const_iterator cbegin() const;
+        const_iterator cend() const;
+        const_reverse_iterator rbegin() const;
+        const_reverse_iterator rend() const;
+        const_segment_iterator segment_begin() const;
+        const_segment_iterator segment_end() const;
+
+        template <typename F>
+        void for_each(F f) const;
+        template <typename F>
+        void for_each_segment(F f) const;
+
+        // Размер и доступ к элементам
+        size_t size() const;
+        bool empty() const;
+        const T& front() const;
+        const T& back() const;
+
+        // Модификаторы
+        void push_back(const T& value);
+        void push_front(const T& value);
+        void pop_back();
+        void pop_front();
+        void clear();
+        void assign(size_t n, const T& value);
+        void rotate(std::ptrdiff_t n);
+        void swap(CowCircularList& other) noexcept;
+        // Изменения по итератору pos, полученному от этого описателя;
+        // возвращают итератор на вставленный или следующий за удалённым
+        // элемент
+        const_iterator insert(const_iterator pos, const T& value);
+        const_iterator erase(const_iterator pos);
+        void set(const_iterator pos, const T& value);
+
+        // Операторы сравнения
+        bool operator==(const CowCircularList& other) const;
+        bool operator!=(const CowCircularList& other) const;
+        bool operator<(const CowCircularList& other) const;
+        bool operator>(const CowCircularList& other) const;
+        bool operator<=(const CowCircularList& other) const;
+        bool operator>=(const CowCircularList& other) const;
+};
+
+template <typename T>
+const CircularList<T>& CowCircularList<T>::empty_ring() {
+    static const CircularList<T> empty;
+    return empty;
+}
+
+template <typename T>
+const CircularList<T>& CowCircularList<T>::view() const {
+    return ring ? ring->list : empty_ring();
+}
+
+template <typename T>
+void CowCircularList<T>::release(Shared* shared) noexcept {
+    // release передаёт чтения кольца описателю, который удалит или
+    // изменит его следующим
+    if (shared && shared->owners.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        delete shared;
+}
+
+// Конструкторы
+template <typename T>
+CowCircularList<T>::CowCircularList() : ring(nullptr) {
+}
+
+template <typename T>
+CowCircularList<T>::CowCircularList(CircularList<T> list)
+    : ring(new Shared{std::move(list), 1}) {
+}
+
+template <typename T>
+CowCircularList<T>::CowCircularList(const CowCircularList& other)
+    : ring(other.ring) {
+    if (ring) ring->owners.fetch_add(1, std::memory_order_relaxed);
+}
+
+template <typename T>
+CowCircularList<T>::CowCircularList(CowCircularList&& other) noexcept
+    : ring(std::exchange(other.ring, nullptr)) {
+}
+
+template <typename T>
+CowCircularList<T>::~CowCircularList() {
+    release(ring);
+}
+
+template <typename T>
+CowCircularList<T>& CowCircularList<T>::operator=(
+    const CowCircularList& other) {
+    CowCircularList(other).swap(*this);
+    return *this;
+}
+
+template <typename T>
+CowCircularList<T>& CowCircularList<T>::operator=(
+    CowCircularList&& other) noexcept {
+    CowCircularList(std::move(other)).swap(*this);
+    return *this;
+}
+
+// Разделение
+template <typename T>
+long CowCircularList<T>::use_count() const {
+    return ring ? ring->owners.load(std::memory_order_relaxed) : 0;
+}
+
+template <typename T>
+bool CowCircularList<T>::shared() const {
+    return use_count() > 1;
+}
+
+template <typename T>
+CircularList<T>& CowCircularList<T>::mutate() {
+    if (!ring) {
+        ring = new Shared{CircularList<T>(), 1};
+    } else if (ring->owners.load(std::memory_order_acquire) != 1) {
+        // Другой владелец мог уже отпустить кольцо; лишняя копия в этом
+        // случае безопасна
+        Shared* copy = new Shared{ring->list, 1};
+        release(ring);
+        ring = copy;
+    }
+    return ring->list;
+}
+
+template <typename T>
+typename CircularList<T>::iterator CowCircularList<T>::writable(
+    typename CircularList<T>::const_iterator pos) {
+    const CircularList<T>* before = ring ? &ring->list : nullptr;
+    // Номер считается до копирования, пока разделённое кольцо ещё живо
+    std::ptrdiff_t index =
+        shared() ? std::distance(view().begin(), pos) : 0;
+    CircularList<T>& own = mutate();
+    if (&own == before) return own.mutable_iterator(pos);
+    return std::next(own.begin(), index);
+}
+
+template <typename T>
+const CircularList<T>& CowCircularList<T>::get() const {
+    return view();
+}
+
+// Итераторы
+template <typename T>
+typename CowCircularList<T>::const_iterator CowCircularList<T>::begin()
+    const {
+    return view().begin();
+}
+
+template <typename T>
+typename CowCircularList<T>::const_iterator CowCircularList<T>::end() const {
+    return view().end();
+}
+
+template <typename T>
+typename CowCircularList<T>::const_iterator CowCircularList<T>::cbegin()
+    const {
+    return begin();
+}
+
+template <typename T>
+typename CowCircularList<T>::const_iterator CowCircularList<T>::cend()
+    const {
+    return end();
+}
+
+template <typename T>
+typename CowCircularList<T>::const_reverse_iterator
+CowCircularList<T>::rbegin() const {
+    return view().rbegin();
+}
+
+template <typename T>
+typename CowCircularList<T>::const_reverse_iterator
+CowCircularList<T>::rend() const {
+    return view().rend();
+}
+
+template <typename T>
+typename CowCircularList<T>::const_segment_iterator
+CowCircularList<T>::segment_begin() const {
+    return view().segment_begin();
+}
+
+template <typename T>
+typename CowCircularList<T>::const_segment_iterator
+CowCircularList<T>::segment_end() const {
+    return view().segment_end();
+}
+
+template <typename T>
+template <typename F>
+void CowCircularList<T>::for_each(F f) const {
+    view().for_each(std::move(f));
+}
+
+template <typename T>
+template <typename F>
+void CowCircularList<T>::for_each_segment(F f) const {
+    view().for_each_segment(std::move(f));
+}
+
+// Размер и доступ к элементам
+template <typename T>
+size_t CowCircularList<T>::size() const {
+    return view().size();
+}
+
+template <typename T>
+bool CowCircularList<T>::empty() const {
+    return view().empty();
+}
+
+template <typename T>
+const T& CowCircularList<T>::front() const {
+    return view().front();
+}
+
+template <typename T>
+const T& CowCircularList<T>::back() const {
+    return view().back();
+}
+
+// Модификаторы
+template <typename T>
+void CowCircularList<T>::push_back(const T& value) {
+    mutate().push_back(value);
+}
+
+template <typename T>
+void CowCircularList<T>::push_front(const T& value) {
+    mutate().push_front(value);
+}
+
+template <typename T>
+void CowCircularList<T>::pop_back() {
+    if (empty())
+        throw std::out_of_range("CowCircularList::pop_back: empty list");
+    mutate().pop_back();
+}
+
+template <typename T>
+void CowCircularList<T>::pop_front() {
+    if (empty())
+        throw std::out_of_range("CowCircularList::pop_front: empty list");
+    mutate().pop_front();
+}
+
+template <typename T>
+void CowCircularList<T>::clear() {
+    // Разделённое кольцо не копируется, а просто отпускается
+    release(std::exchange(ring, nullptr));
+}
+
+template <typename T>
+void CowCircularList<T>::assign(size_t n, const T& value) {
+    if (shared()) release(std::exchange(ring, nullptr));
+    mutate().assign(n, value);
+}
+
+template <typename T>
+void CowCircularList<T>::rotate(std::ptrdiff_t n) {
+    if (size() < 2) return;
+    mutate().rotate(n);
+}
+
+template <typename T>
+void CowCircularList<T>::swap(CowCircularList& other) noexcept {
+    std::swap(ring, other.ring);
+}
+
+template <typename T>
+typename CowCircularList<T>::const_iterator CowCircularList<T>::insert(
+    const_iterator pos, const T& value) {
+    auto it = writable(pos);
+    return ring->list.insert(it, value);
+}
+
+template <typename T>
+typename CowCircularList<T>::const_iterator CowCircularList<T>::erase(
+    const_iterator pos) {
+    if (pos == end())
+        throw std::invalid_argument("CowCircularList::erase: end iterator");
+    auto it = writable(pos);
+    return ring->list.erase(it);
+}
+
+template <typename T>
+void CowCircularList<T>::set(const_iterator pos, const T& value) {
+    if (pos == end())
+        throw std::invalid_argument("CowCircularList::set: end iterator");
+    *writable(pos) = value;
+}
+
+// Операторы сравнения
+template <typename T>
+bool CowCircularList<T>::operator==(const CowCircularList& other) const {
+    return ring == other.ring || view() == other.view();
+}
+
+template <typename T>
+bool CowCircularList<T>::operator!=(const CowCircularList& other) const {
+    return !(*this == other);
+}
+
+template <typename T>
+bool CowCircularList<T>::operator<(const CowCircularList& other) const {
+    return view() < other.view();
+}
+
+template <typename T>
+bool CowCircularList<T>::operator>(const CowCircularList& other) const {
+    return other < *this;
+}
+
+template <typename T>
+bool CowCircularList<T>::operator<=(const CowCircularList& other) const {
+    return !(other < *this);
+}
+
+template <typename T>
+bool CowCircularList<T>::operator>=(const CowCircularList& other) const {
+    return !(*this < other);
+}
+
+#endif
@@ -0,0 +1,690 @@
+#ifndef DURABLE_CIRCULAR_LIST_H
+#define DURABLE_CIRCULAR_LIST_H
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "SlotCircularList.h"
+
+// Когда журнал DurableCircularList сбрасывается на носитель
+enum class FsyncPolicy {
+    always,  // fdatasync после каждого изменения
+    group,   // один fdatasync на группу изменений
+    none     // запись без fdatasync: переживает падение процесса, но не
+             // отключение питания
+};
+
+struct WalOptions {
+        FsyncPolicy fsync = FsyncPolicy::group;
+        // Группа фиксируется fdatasync, набрав group_size изменений или
+        // когда первому из них исполнилось group_delay. Таймера нет: срок
+        // проверяется при следующем изменении, поэтому последние изменения
+        // простаивающего списка надёжны только после sync()
+        size_t group_size = 64;
+        std::chrono::microseconds group_delay{1000};
+        // Журнал длиннее checkpoint_bytes сворачивается в снимок; 0 - только
+        // явным checkpoint()
+        size_t checkpoint_bytes = size_t(64) << 20;
+};
+
+// Кольцевой список, переживающий перезапуск процесса. Каждое изменение
+// (push, pop, insert перед описателем, erase) применяется к
+// SlotCircularList в памяти и сразу дописывается записью фиксированного
+// размера с CRC32 в журнал предзаписи (каталог/wal), так что переживает
+// падение процесса. Группируется только fdatasync: один на группу
+// изменений (group commit).
+//
+// checkpoint() записывает снимок во временный файл, атомарно
+// переименовывает его в каталог/snapshot и очищает журнал. При открытии
+// загружается снимок, затем воспроизводятся записи журнала с номерами
+// больше номера снимка; оборванная или повреждённая запись в конце
+// журнала (запись, прерванная падением) отбрасывается вместе с хвостом.
+//
+// Описатели - 64-битные номера элементов; они не переиспользуются и
+// остаются действительными после восстановления. Значения пишутся
+// побайтно, поэтому T должен быть тривиально копируемым. Изменение,
+// которое не удалось записать в журнал, остаётся в памяти, а
+// std::system_error сообщает, что оно не надёжно; запись повторяется при
+// следующем изменении или sync(). После ошибки fdatasync повтор ничего не
+// доказывает (ядро сбрасывает ошибку, сообщив о ней), поэтому
+// durable_sequence() больше не растёт, а sync() бросает исключение, пока
+// checkpoint() не запишет всё состояние заново.
+template <typename T>
+class DurableCircularList {
+        static_assert(std::is_trivially_copyable_v<T> &&
+                          std::is_default_constructible_v<T>,
+                      "DurableCircularList: T must be trivially copyable");
+
+    public:
+        using Handle = uint64_t;
+        using value_type = T;
+
+    private:
+        enum class Op : uint8_t {
+            push_back,
+            push_front,
+            pop_back,
+            pop_front,
+            insert,
+            erase
+        };
+
+        struct Record {
+                uint64_t sequence;
+                Op op;
+                Handle id;
+                Handle pos;  // для insert
+                T value;
+        };
+
+        struct Entry {
+                Handle id;
+                T value;
+        };
+
+        using List = SlotCircularList<Entry>;
+
+        // Номер записи, операция, номер элемента, позиция, значение, CRC32
+        static constexpr size_t kRecordBytes =
+            sizeof(uint64_t) + 1 + 2 * sizeof(Handle) + sizeof(T) +
+            sizeof(uint32_t);
+        static constexpr uint64_t kSnapshotMagic = 0x31504e5344524344ULL;
+
+        std::string directory;
+        WalOptions options;
+        List list;
+        std::unordered_map<Handle, typename List::Handle> index;
+        Handle next_id;
+        uint64_t sequence;  // номер последней записи
+        uint64_t durable;   // номер последней записи на диске
+        int wal_fd;
+        size_t wal_size;  // байты журнала в файле
+        std::vector<char> pending;  // записи, которые не удалось записать
+        size_t unsynced_records;    // записи после последнего fdatasync
+        std::chrono::steady_clock::time_point unsynced_since;
+        int sync_error;  // errno неудавшегося fdatasync или 0
+        size_t syncs;
+
+        static uint32_t crc32(const char* data, size_t n, uint32_t crc = 0);
+        static void write_all(int fd, const char* data, size_t n,
+                              size_t offset);
+        static std::vector<char> read_all(int fd);
+        static void sync_directory(const std::string& path);
+
+        std::string wal_path() const;
+        std::string snapshot_path() const;
+        void load_snapshot();
+        void replay_wal();
+        // Изменение списка по записи; при ошибке список не меняется
+        void apply(const Record& record);
+        // Применение новой записи, запись в журнал и постановка в группу
+        void log(Record record);
+        // Запись pending в конец журнала
+        void write_pending();
+        void encode(const Record& record);
+        static Record decode(const char* bytes);
+
+    public:
+        // Открывает или создаёт каталог и восстанавливает список
+        explicit DurableCircularList(std::string directory,
+                                     WalOptions options = WalOptions());
+        DurableCircularList(const DurableCircularList&) = delete;
+        DurableCircularList& operator=(const DurableCircularList&) = delete;
+        // Фиксирует неполную группу; ошибки записи при этом теряются
+        ~DurableCircularList();
+
+        // Если f возвращает bool, false прекращает обход
+        template <typename F>
+        void for_each(F f) const;
+
+        // Размер и проверка на пустоту
+        size_t size() const;
+        bool empty() const;
+
+        // Доступ к элементам
+        const T& front() const;
+        const T& back() const;
+        Handle front_handle() const;
+        Handle back_handle() const;
+        // nullptr, если элемент удалён
+        const T* get(Handle handle) const;
+        bool contains(Handle handle) const;
+
+        // Модификаторы
+        Handle push_back(const T& value);
+        Handle push_front(const T& value);
+        void pop_back();
+        void pop_front();
+        // Вставка перед элементом pos; удалённый pos - std::invalid_argument
+        Handle insert(Handle pos, const T& value);
+        // false, если элемент уже удалён
+        bool erase(Handle handle);
+
+        // Журнал
+        // Запись неудавшихся записей и fdatasync неполной группы (без
+        // fdatasync при none)
+        void sync();
+        // Снимок списка и очистка журнала; после ошибки fdatasync
+        // возвращает список в рабочее состояние
+        void checkpoint();
+        // Номер последнего изменения и последнего, дошедшего до диска
+        uint64_t last_sequence() const;
+        uint64_t durable_sequence() const;
+        size_t wal_bytes() const;
+        size_t sync_count() const;
+};
+
+// Файлы
+template <typename T>
+uint32_t DurableCircularList<T>::crc32(const char* data, size_t n,
+                                       uint32_t crc) {
+    static constexpr auto table = [] {
+        std::array<uint32_t, 256> result{};
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int bit = 0; bit < 8; ++bit)
+                c = c & 1 ? 0xedb88320u ^ (c >> 1) : c >> 1;
+            result[i] = c;
+        }
+        return result;
+    }();
+    crc = ~crc;
+    for (size_t i = 0; i < n; ++i)
+        crc = table[(crc ^ uint8_t(data[i])) & 0xff] ^ (crc >> 8);
+    return ~crc;
+}
+
+template <typename T>
+void DurableCircularList<T>::write_all(int fd, const char* data, size_t n,
+                                       size_t offset) {
+    while (n > 0) {
+        ssize_t done = ::pwrite(fd, data, n, off_t(offset));
+        if (done < 0) {
+            if (errno == EINTR) continue;
+            throw std::system_error(errno, std::generic_category(),
+                                    "DurableCircularList: write");
+        }
+        data += done;
+        n -= size_t(done);
+        offset += size_t(done);
+    }
+}
+
+template <typename T>
+std::vector<char> DurableCircularList<T>::read_all(int fd) {
+    std::vector<char> bytes;
+    char buffer[1 << 16];
+    ssize_t n;
+    while ((n = ::read(fd, buffer, sizeof(buffer))) != 0) {
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            throw std::system_error(errno, std::generic_category(),
+                                    "DurableCircularList: read");
+        }
+        bytes.insert(bytes.end(), buffer, buffer + n);
+    }
+    return bytes;
+}
+
+template <typename T>
+void DurableCircularList<T>::sync_directory(const std::string& path) {
+    // Имя нового или переименованного файла надёжно после fsync каталога
+    int fd = ::open(path.c_str(), O_RDONLY | O_DIRECTORY);
+    if (fd < 0 || ::fsync(fd) != 0) {
+        int error = errno;
+        if (fd >= 0) ::close(fd);
+        throw std::system_error(error, std::generic_category(),
+                                "DurableCircularList: fsync " + path);
+    }
+    ::close(fd);
+}
+
+template <typename T>
+std::string DurableCircularList<T>::wal_path() const {
+    return directory + "/wal";
+}
+
+template <typename T>
+std::string DurableCircularList<T>::snapshot_path() const {
+    return directory + "/snapshot";
+}
+
+// Снимок: магическое число, номер записи, следующий номер элемента, число
+// элементов, элементы (номер, значение), CRC32 всего предыдущего
+template <typename T>
+void DurableCircularList<T>::load_snapshot() {
+    int fd = ::open(snapshot_path().c_str(), O_RDONLY);
+    if (fd < 0) {
+        if (errno == ENOENT) return;
+        throw std::system_error(errno, std::generic_category(),
+                                "DurableCircularList: open snapshot");
+    }
+    std::vector<char> bytes;
+    try {
+        bytes = read_all(fd);
+    } catch (...) {
+        ::close(fd);
+        throw;
+    }
+    ::close(fd);
+
+    const size_t header = 4 * sizeof(uint64_t);
+    uint64_t fields[4] = {};
+    if (bytes.size() >= header + sizeof(uint32_t))
+        std::memcpy(fields, bytes.data(), header);
+    size_t entry_bytes = sizeof(Handle) + sizeof(T);
+    if (fields[0] != kSnapshotMagic ||
+        bytes.size() != header + fields[3] * entry_bytes + sizeof(uint32_t))
+        throw std::runtime_error("DurableCircularList: bad snapshot");
+    uint32_t stored;
+    std::memcpy(&stored, bytes.data() + bytes.size() - sizeof(stored),
+                sizeof(stored));
+    if (crc32(bytes.data(), bytes.size() - sizeof(stored)) != stored)
+        throw std::runtime_error("DurableCircularList: snapshot checksum");
+
+    sequence = durable = fields[1];
+    next_id = fields[2];
+    list.reserve(fields[3]);
+    const char* p = bytes.data() + header;
+    for (uint64_t i = 0; i < fields[3]; ++i, p += entry_bytes) {
+        Entry entry;
+        std::memcpy(&entry.id, p, sizeof(Handle));
+        std::memcpy(&entry.value, p + sizeof(Handle), sizeof(T));
+        index[entry.id] = list.push_back(entry);
+    }
+}
+
+template <typename T>
+void DurableCircularList<T>::replay_wal() {
+    std::vector<char> bytes = read_all(wal_fd);
+    size_t offset = 0;
+    for (; offset + kRecordBytes <= bytes.size(); offset += kRecordBytes) {
+        const char* p = bytes.data() + offset;
+        uint32_t stored;
+        std::memcpy(&stored, p + kRecordBytes - sizeof(stored),
+                    sizeof(stored));
+        if (crc32(p, kRecordBytes - sizeof(stored)) != stored) break;
+        Record record = decode(p);
+        // Записи до снимка остаются, если падение случилось между
+        // переименованием снимка и очисткой журнала
+        if (record.sequence <= sequence) continue;
+        if (record.sequence != sequence + 1) break;
+        apply(record);
+        sequence = durable = record.sequence;
+    }
+    if (offset != bytes.size() && ::ftruncate(wal_fd, off_t(offset)) != 0)
+        throw std::system_error(errno, std::generic_category(),
+                                "DurableCircularList: truncate wal");
+    wal_size = offset;
+}
+
+// Записи журнала
+template <typename T>
+void DurableCircularList<T>::apply(const Record& record) {
+    auto lookup = [this](Handle id) {
+        auto it = index.find(id);
+        if (it == index.end())
+            throw std::invalid_argument("DurableCircularList: stale handle");
+        return it->second;
+    };
+    switch (record.op) {
+        case Op::push_back:
+        case Op::push_front:
+        case Op::insert: {
+            typename List::Handle at;
+            if (record.op == Op::insert) at = lookup(record.pos);
+            // Место в index занимается до изменения списка, чтобы после
+            // него ничего не бросало
+            auto [slot, inserted] =
+                index.emplace(record.id, typename List::Handle());
+            if (!inserted)
+                throw std::invalid_argument(
+                    "DurableCircularList: duplicate handle");
+            Entry entry{record.id, record.value};
+            try {
+                slot->second = record.op == Op::push_back ? list.push_back(entry)
+                               : record.op == Op::push_front
+                                   ? list.push_front(entry)
+                                   : list.insert(at, entry);
+            } catch (...) {
+                index.erase(slot);
+                throw;
+            }
+            next_id = std::max(next_id, record.id + 1);
+            break;
+        }
+        case Op::pop_back:
+        case Op::pop_front: {
+            if (list.empty())
+                throw std::out_of_range("DurableCircularList: empty list");
+            Handle id = record.op == Op::pop_back ? list.back().id
+                                                  : list.front().id;
+            if (record.op == Op::pop_back)
+                list.pop_back();
+            else
+                list.pop_front();
+            index.erase(id);
+            break;
+        }
+        case Op::erase:
+            list.erase(lookup(record.id));
+            index.erase(record.id);
+            break;
+    }
+}
+
+template <typename T>
+void DurableCircularList<T>::encode(const Record& record) {
+    size_t start = pending.size();
+    pending.resize(start + kRecordBytes);
+    char* p = pending.data() + start;
+    std::memcpy(p, &record.sequence, sizeof(uint64_t));
+    p[sizeof(uint64_t)] = char(record.op);
+    p += sizeof(uint64_t) + 1;
+    std::memcpy(p, &record.id, sizeof(Handle));
+    std::memcpy(p + sizeof(Handle), &record.pos, sizeof(Handle));
+    std::memcpy(p + 2 * sizeof(Handle), &record.value, sizeof(T));
+    uint32_t crc =
+        crc32(pending.data() + start, kRecordBytes - sizeof(uint32_t));
+    std::memcpy(pending.data() + start + kRecordBytes - sizeof(crc), &crc,
+                sizeof(crc));
+}
+
+template <typename T>
+typename DurableCircularList<T>::Record DurableCircularList<T>::decode(
+    const char* p) {
+    Record record;
+    std::memcpy(&record.sequence, p, sizeof(uint64_t));
+    record.op = Op(uint8_t(p[sizeof(uint64_t)]));
+    p += sizeof(uint64_t) + 1;
+    std::memcpy(&record.id, p, sizeof(Handle));
+    std::memcpy(&record.pos, p + sizeof(Handle), sizeof(Handle));
+    std::memcpy(&record.value, p + 2 * sizeof(Handle), sizeof(T));
+    return record;
+}
+
+template <typename T>
+void DurableCircularList<T>::log(Record record) {
+    record.sequence = sequence + 1;
+    pending.reserve(pending.size() + kRecordBytes);
+    apply(record);
+    ++sequence;
+    encode(record);
+    if (unsynced_records++ == 0)
+        unsynced_since = std::chrono::steady_clock::now();
+    if (options.fsync != FsyncPolicy::group ||
+        unsynced_records >= options.group_size ||
+        std::chrono::steady_clock::now() - unsynced_since >=
+            options.group_delay)
+        sync();
+    else
+        write_pending();
+}
+
+template <typename T>
+void DurableCircularList<T>::write_pending() {
+    if (pending.empty()) return;
+    // Записи пишутся с конца целых записей: после оборванной попытки
+    // повтор затирает её хвост, а не дописывается за ним
+    try {
+        write_all(wal_fd, pending.data(), pending.size(), wal_size);
+    } catch (...) {
+        // Ошибка обрезки не страшна: повтор всё равно пишет с wal_size
+        int truncated = ::ftruncate(wal_fd, off_t(wal_size));
+        (void)truncated;
+        throw;
+    }
+    wal_size += pending.size();
+    pending.clear();
+}
+
+// Конструкторы
+template <typename T>
+DurableCircularList<T>::DurableCircularList(std::string directory,
+                                            WalOptions options)
+    : directory(std::move(directory)), options(options), next_id(0),
+      sequence(0), durable(0), wal_fd(-1), wal_size(0), unsynced_records(0),
+      sync_error(0), syncs(0) {
+    if (this->options.group_size == 0)
+        throw std::invalid_argument(
+            "DurableCircularList: group_size must be > 0");
+    std::filesystem::create_directories(this->directory);
+    load_snapshot();
+    wal_fd = ::open(wal_path().c_str(), O_RDWR | O_CREAT, 0644);
+    if (wal_fd < 0)
+        throw std::system_error(errno, std::generic_category(),
+                                "DurableCircularList: open wal");
+    try {
+        replay_wal();
+        sync_directory(this->directory);
+    } catch (...) {
+        ::close(wal_fd);
+        throw;
+    }
+}
+
+template <typename T>
+DurableCircularList<T>::~DurableCircularList() {
+    try {
+        sync();
+    } catch (...) {
+    }
+    ::close(wal_fd);
+}
+
+template <typename T>
+template <typename F>
+void DurableCircularList<T>::for_each(F f) const {
+    list.for_each([&f](const Entry& entry) {
+        if constexpr (std::is_same_v<std::invoke_result_t<F&, const T&>,
+                                     bool>) {
+            return f(entry.value);
+        } else {
+            f(entry.value);
+        }
+    });
+}
+
+// Размер и проверка на пустоту
+template <typename T>
+size_t DurableCircularList<T>::size() const {
+    return list.size();
+}
+
+template <typename T>
+bool DurableCircularList<T>::empty() const {
+    return list.empty();
+}
+
+// Доступ к элементам
+template <typename T>
+const T& DurableCircularList<T>::front() const {
+    if (empty())
+        throw std::out_of_range("DurableCircularList::front: empty list");
+    return list.front().value;
+}
+
+template <typename T>
+const T& DurableCircularList<T>::back() const {
+    if (empty())
+        throw std::out_of_range("DurableCircularList::back: empty list");
+    return list.back().value;
+}
+
+template <typename T>
+typename DurableCircularList<T>::Handle DurableCircularList<T>::front_handle()
+    const {
+    if (empty())
+        throw std::out_of_range(
+            "DurableCircularList::front_handle: empty list");
+    return list.front().id;
+}
+
+template <typename T>
+typename DurableCircularList<T>::Handle DurableCircularList<T>::back_handle()
+    const {
+    if (empty())
+        throw std::out_of_range("DurableCircularList::back_handle: empty list");
+    return list.back().id;
+}
+
+template <typename T>
+const T* DurableCircularList<T>::get(Handle handle) const {
+    auto it = index.find(handle);
+    return it == index.end() ? nullptr : &list.get(it->second)->value;
+}
+
+template <typename T>
+bool DurableCircularList<T>::contains(Handle handle) const {
+    return index.count(handle) != 0;
+}
+
+// Модификаторы
+template <typename T>
+typename DurableCircularList<T>::Handle DurableCircularList<T>::push_back(
+    const T& value) {
+    Handle id = next_id;
+    log(Record{0, Op::push_back, id, 0, value});
+    return id;
+}
+
+template <typename T>
+typename DurableCircularList<T>::Handle DurableCircularList<T>::push_front(
+    const T& value) {
+    Handle id = next_id;
+    log(Record{0, Op::push_front, id, 0, value});
+    return id;
+}
+
+template <typename T>
+void DurableCircularList<T>::pop_back() {
+    log(Record{0, Op::pop_back, 0, 0, T{}});
+}
+
+template <typename T>
+void DurableCircularList<T>::pop_front() {
+    log(Record{0, Op::pop_front, 0, 0, T{}});
+}
+
+template <typename T>
+typename DurableCircularList<T>::Handle DurableCircularList<T>::insert(
+    Handle pos, const T& value) {
+    Handle id = next_id;
+    log(Record{0, Op::insert, id, pos, value});
+    return id;
+}
+
+template <typename T>
+bool DurableCircularList<T>::erase(Handle handle) {
+    if (!contains(handle)) return false;
+    log(Record{0, Op::erase, handle, 0, T{}});
+    return true;
+}
+
+// Журнал
+template <typename T>
+void DurableCircularList<T>::sync() {
+    write_pending();
+    if (unsynced_records == 0) return;
+    if (options.fsync != FsyncPolicy::none) {
+        if (sync_error != 0)
+            throw std::system_error(
+                sync_error, std::generic_category(),
+                "DurableCircularList: fdatasync failed, checkpoint required");
+        if (::fdatasync(wal_fd) != 0) {
+            sync_error = errno;
+            throw std::system_error(sync_error, std::generic_category(),
+                                    "DurableCircularList: fdatasync");
+        }
+        ++syncs;
+    }
+    unsynced_records = 0;
+    durable = sequence;
+    if (options.checkpoint_bytes != 0 && wal_size >= options.checkpoint_bytes)
+        checkpoint();
+}
+
+template <typename T>
+void DurableCircularList<T>::checkpoint() {
+    std::vector<char> bytes;
+    size_t entry_bytes = sizeof(Handle) + sizeof(T);
+    bytes.reserve(4 * sizeof(uint64_t) + list.size() * entry_bytes +
+                  sizeof(uint32_t));
+    uint64_t header[4] = {kSnapshotMagic, sequence, next_id, list.size()};
+    bytes.insert(bytes.end(), reinterpret_cast<const char*>(header),
+                 reinterpret_cast<const char*>(header) + sizeof(header));
+    list.for_each([&bytes](const Entry& entry) {
+        const char* id = reinterpret_cast<const char*>(&entry.id);
+        const char* value = reinterpret_cast<const char*>(&entry.value);
+        bytes.insert(bytes.end(), id, id + sizeof(Handle));
+        bytes.insert(bytes.end(), value, value + sizeof(T));
+    });
+    uint32_t crc = crc32(bytes.data(), bytes.size());
+    const char* crc_bytes = reinterpret_cast<const char*>(&crc);
+    bytes.insert(bytes.end(), crc_bytes, crc_bytes + sizeof(crc));
+
+    std::string temp = snapshot_path() + ".tmp";
+    int fd = ::open(temp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        throw std::system_error(errno, std::generic_category(),
+                                "DurableCircularList: create snapshot");
+    try {
+        write_all(fd, bytes.data(), bytes.size(), 0);
+        if (::fdatasync(fd) != 0)
+            throw std::system_error(errno, std::generic_category(),
+                                    "DurableCircularList: fdatasync snapshot");
+    } catch (...) {
+        ::close(fd);
+        throw;
+    }
+    ::close(fd);
+    std::filesystem::rename(temp, snapshot_path());
+    sync_directory(directory);
+
+    // Снимок уже содержит все записи, в том числе неудавшиеся
+    pending.clear();
+    unsynced_records = 0;
+    sync_error = 0;
+    durable = sequence;
+    if (::ftruncate(wal_fd, 0) != 0 || ::fdatasync(wal_fd) != 0)
+        throw std::system_error(errno, std::generic_category(),
+                                "DurableCircularList: truncate wal");
+    wal_size = 0;
+}
+
+template <typename T>
+uint64_t DurableCircularList<T>::last_sequence() const {
+    return sequence;
+}
+
+template <typename T>
+uint64_t DurableCircularList<T>::durable_sequence() const {
+    return durable;
+}
+
+template <typename T>
+size_t DurableCircularList<T>::wal_bytes() const {
+    return wal_size;
+}
+
+template <typename T>
+size_t DurableCircularList<T>::sync_count() const {
+    return syncs;
+}
+
+#endif
@@ -0,0 +1,602 @@
+#ifndef PERSISTENT_CIRCULAR_LIST_H
+#define PERSISTENT_CIRCULAR_LIST_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "CircularList.h"
+
+// Неизменяемый кольцевой список со структурным разделением. Элементы
+// хранятся в неявном декартовом дереве (treap) по позиции; изменение
+// копирует только путь от корня, остальные узлы разделяются со старой
+// версией через shared_ptr. Кольцо задаётся смещением начала: rotate()
+// меняет только его.
+//
+// Копирование - O(1) (один атомарный инкремент), доступ по индексу,
+// вставка и удаление - O(log n) в среднем, обход for_each - O(n).
+// Узлы никогда не меняются, поэтому версии можно без блокировок читать
+// из разных потоков.
+template <typename T>
+class PersistentCircularList {
+    private:
+        struct Node;
+        using Link = std::shared_ptr<const Node>;
+
+        struct Node {
+                T value;
+                uint64_t priority;
+                size_t size;
+                Link left;
+                Link right;
+                Node(const T& v, uint64_t p, Link l, Link r)
+                    : value(v), priority(p),
+                      size(1 + subtree_size(l) + subtree_size(r)),
+                      left(std::move(l)), right(std::move(r)) {}
+        };
+
+        Link root;
+        size_t offset;  // физический номер первого элемента кольца
+
+        PersistentCircularList(Link r, size_t o);
+
+        static size_t subtree_size(const Link& node);
+        static uint64_t next_priority();
+        static Link make_node(const T& value, uint64_t priority, Link left,
+                              Link right);
+        static Link merge(const Link& a, const Link& b);
+        // Первые count элементов и остаток
+        static std::pair<Link, Link> split(const Link& node, size_t count);
+        static const T& at_physical(const Node* node, size_t index);
+        static Link assign_physical(const Link& node, size_t index,
+                                    const T& value);
+        template <typename F>
+        static bool visit(const Node* node, size_t& skip, size_t& left,
+                          F& f);
+        // Дерево, в котором первый элемент кольца стоит на позиции 0
+        Link normalized() const;
+        size_t physical(size_t index) const;
+
+    public:
+        class const_iterator;
+        using iterator = const_iterator;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+        using reverse_iterator = const_reverse_iterator;
+
+        // Конструкторы
+        PersistentCircularList();
+        // Построение за O(n)
+        explicit PersistentCircularList(const CircularList<T>& list);
+        CircularList<T> to_circular_list() const;
+
+        // Размер и доступ к элементам
+        size_t size() const;
+        bool empty() const;
+        const T& front() const;
+        const T& back() const;
+        const T& at(size_t index) const;
+        const T& operator[](size_t index) const;
+
+        const_iterator begin() const;
+        const_iterator end() const;
+        const_iterator cbegin() const;
+        const_iterator cend() const;
+        const_reverse_iterator rbegin() const;
+        const_reverse_iterator rend() const;
+
+        // Обход за O(n); если f возвращает bool, false прекращает обход
+        template <typename F>
+        void for_each(F f) const;
+
+        // Модификаторы возвращают новую версию, не меняя текущую
+        PersistentCircularList push_back(const T& value) const;
+        PersistentCircularList push_front(const T& value) const;
+        PersistentCircularList pop_back() const;
+        PersistentCircularList pop_front() const;
+        PersistentCircularList insert(size_t index, const T& value) const;
+        PersistentCircularList erase(size_t index) const;
+        PersistentCircularList set(size_t index, const T& value) const;
+        // Сдвиг начала кольца на n позиций вперёд (назад при n < 0), O(1)
+        PersistentCircularList rotate(std::ptrdiff_t n) const;
+
+        // Операторы сравнения
+        bool operator==(const PersistentCircularList& other) const;
+        bool operator!=(const PersistentCircularList& other) const;
+        bool operator<(const PersistentCircularList& other) const;
+        bool operator>(const PersistentCircularList& other) const;
+        bool operator<=(const PersistentCircularList& other) const;
+        bool operator>=(const PersistentCircularList& other) const;
+
+        // Итератор хранит номер элемента; разыменование - O(log n),
+        // поэтому для полного обхода предпочтителен for_each
+        class const_iterator {
+                const PersistentCircularList* list;
+                size_t index;
+
+            public:
+                using iterator_category = std::bidirectional_iterator_tag;
+                using value_type = T;
+                using difference_type = std::ptrdiff_t;
+                using pointer = const T*;
+                using reference = const T&;
+                const_iterator(const PersistentCircularList* l = nullptr,
+                               size_t i = 0);
+                const T& operator*() const;
+                const_iterator& operator++();
+                const_iterator& operator--();
+                bool operator==(const const_iterator& other) const;
+                bool operator!=(const const_iterator& other) const;
+        };
+};
+
+// Дерево
+template <typename T>
+size_t PersistentCircularList<T>::subtree_size(const Link& node) {
+    return node ? node->size : 0;
+}
+
+template <typename T>
+uint64_t PersistentCircularList<T>::next_priority() {
+    // splitmix64 с отдельным состоянием на поток
+    thread_local uint64_t state = 0x9e3779b97f4a7c15ULL ^
+                                  reinterpret_cast<uintptr_t>(&state);
+    uint64_t x = (state += 0x9e3779b97f4a7c15ULL);
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+template <typename T>
+typename PersistentCircularList<T>::Link PersistentCircularList<T>::make_node(
+    const T& value, uint64_t priority, Link left, Link right) {
+    return std::make_shared<const Node>(value, priority, std::move(left),
+                                        std::move(right));
+}
+
+template <typename T>
+typename PersistentCircularList<T>::Link PersistentCircularList<T>::merge(
+    const Link& a, const Link& b) {
+    if (!a) return b;
+    if (!b) return a;
+    if (a->priority > b->priority) {
+        return make_node(a->value, a->priority, a->left, merge(a->right, b));
+    }
+    return make_node(b->value, b->priority, merge(a, b->left), b->right);
+}
+
+template <typename T>
+std::pair<typename PersistentCircularList<T>::Link,
+          typename PersistentCircularList<T>::Link>
+PersistentCircularList<T>::split(const Link& node, size_t count) {
+    if (!node) return {nullptr, nullptr};
+    if (count == 0) return {nullptr, node};
+    if (count >= node->size) return {node, nullptr};
+    size_t left_size = subtree_size(node->left);
+    if (count <= left_size) {
+        auto [first, rest] = split(node->left, count);
+        return {first, make_node(node->value, node->priority, rest,
+                                 node->right)};
+    }
+    auto [first, rest] = split(node->right, count - left_size - 1);
+    return {make_node(node->value, node->priority, node->left, first), rest};
+}
+
+template <typename T>
+const T& PersistentCircularList<T>::at_physical(const Node* node,
+                                                size_t index) {
+    while (true) {
+        size_t left_size = subtree_size(node->left);
+        if (index < left_size) {
+            node = node->left.get();
+        } else if (index == left_size) {
+            return node->value;
+        } else {
+            index -= left_size + 1;
+            node = node->right.get();
+        }
+    }
+}
+
+template <typename T>
+typename PersistentCircularList<T>::Link
+PersistentCircularList<T>::assign_physical(const Link& node, size_t index,
+                                           const T& value) {
+    size_t left_size = subtree_size(node->left);
+    if (index < left_size) {
+        return make_node(node->value, node->priority,
+                         assign_physical(node->left, index, value),
+                         node->right);
+    }
+    if (index == left_size) {
+        return make_node(value, node->priority, node->left, node->right);
+    }
+    return make_node(node->value, node->priority, node->left,
+                     assign_physical(node->right, index - left_size - 1,
+                                     value));
+}
+
+template <typename T>
+template <typename F>
+bool PersistentCircularList<T>::visit(const Node* node, size_t& skip,
+                                      size_t& left, F& f) {
+    if (!node || left == 0) return true;
+    if (skip >= node->size) {
+        skip -= node->size;
+        return true;
+    }
+    if (!visit(node->left.get(), skip, left, f)) return false;
+    if (left == 0) return true;
+    if (skip > 0) {
+        --skip;
+    } else {
+        --left;
+        if constexpr (std::is_same_v<std::invoke_result_t<F&, const T&>,
+                                     bool>) {
+            if (!f(node->value)) return false;
+        } else {
+            f(node->value);
+        }
+    }
+    return visit(node->right.get(), skip, left, f);
+}
+
+template <typename T>
+typename PersistentCircularList<T>::Link
+PersistentCircularList<T>::normalized() const {
+    if (offset == 0) return root;
+    auto [first, rest] = split(root, offset);
+    return merge(rest, first);
+}
+
+template <typename T>
+size_t PersistentCircularList<T>::physical(size_t index) const {
+    size_t n = size();
+    return offset + index < n ? offset + index : offset + index - n;
+}
+
+// Конструкторы
+template <typename T>
+PersistentCircularList<T>::PersistentCircularList(Link r, size_t o)
+    : root(std::move(r)), offset(o) {
+}
+
+template <typename T>
+PersistentCircularList<T>::PersistentCircularList()
+    : root(nullptr), offset(0) {
+}
+
+template <typename T>
+PersistentCircularList<T>::PersistentCircularList(const CircularList<T>& list)
+    : root(nullptr), offset(0) {
+    // Декартово дерево по последовательности строится стеком правой
+    // ветви. Узлы неизменяемы, поэтому сначала собираются значения и
+    // приоритеты, а затем дерево создаётся снизу вверх по найденным
+    // родителям.
+    size_t n = list.size();
+    if (n == 0) return;
+    std::vector<const T*> values;
+    std::vector<uint64_t> priorities;
+    values.reserve(n);
+    priorities.reserve(n);
+    list.for_each([&](const T& value) {
+        values.push_back(&value);
+        priorities.push_back(next_priority());
+    });
+
+    constexpr size_t none = size_t(-1);
+    std::vector<size_t> left(n, none);
+    std::vector<size_t> right(n, none);
+    std::vector<size_t> stack;
+    for (size_t i = 0; i < n; ++i) {
+        size_t last = none;
+        while (!stack.empty() && priorities[stack.back()] < priorities[i]) {
+            last = stack.back();
+            stack.pop_back();
+        }
+        left[i] = last;
+        if (!stack.empty()) right[stack.back()] = i;
+        stack.push_back(i);
+    }
+
+    // Обратный обход в глубину: дети создаются раньше родителей
+    std::vector<Link> built(n);
+    std::vector<std::pair<size_t, bool>> pending{{stack.front(), false}};
+    while (!pending.empty()) {
+        auto [i, children_done] = pending.back();
+        pending.pop_back();
+        if (children_done) {
+            built[i] = make_node(*values[i], priorities[i],
+                                 left[i] == none ? nullptr : built[left[i]],
+                                 right[i] == none ? nullptr
+                                                  : built[right[i]]);
+            if (left[i] != none) built[left[i]].reset();
+            if (right[i] != none) built[right[i]].reset();
+            continue;
+        }
+        pending.emplace_back(i, true);
+        if (left[i] != none) pending.emplace_back(left[i], false);
+        if (right[i] != none) pending.emplace_back(right[i], false);
+    }
+    root = std::move(built[stack.front()]);
+}
+
+template <typename T>
+CircularList<T> PersistentCircularList<T>::to_circular_list() const {
+    CircularList<T> list;
+    for_each([&list](const T& value) { list.push_back(value); });
+    return list;
+}
+
+// Размер и доступ к элементам
+template <typename T>
+size_t PersistentCircularList<T>::size() const {
+    return subtree_size(root);
+}
+
+template <typename T>
+bool PersistentCircularList<T>::empty() const {
+    return !root;
+}
+
+template <typename T>
+const T& PersistentCircularList<T>::front() const {
+    if (empty())
+        throw std::out_of_range("PersistentCircularList::front: empty list");
+    return at_physical(root.get(), offset);
+}
+
+template <typename T>
+const T& PersistentCircularList<T>::back() const {
+    if (empty())
+        throw std::out_of_range("PersistentCircularList::back: empty list");
+    return at_physical(root.get(), physical(size() - 1));
+}
+
+template <typename T>
+const T& PersistentCircularList<T>::at(size_t index) const {
+    if (index >= size())
+        throw std::out_of_range("PersistentCircularList::at: bad index");
+    return at_physical(root.get(), physical(index));
+}
+
+template <typename T>
+const T& PersistentCircularList<T>::operator[](size_t index) const {
+    return at_physical(root.get(), physical(index));
+}
+
+template <typename T>
+typename PersistentCircularList<T>::const_iterator
+PersistentCircularList<T>::begin() const {
+    return const_iterator(this, 0);
+}
+
+template <typename T>
+typename PersistentCircularList<T>::const_iterator
+PersistentCircularList<T>::end() const {
+    return const_iterator(this, size());
+}
+
+template <typename T>
+typename PersistentCircularList<T>::const_iterator
+PersistentCircularList<T>::cbegin() const {
+    return begin();
+}
+
+template <typename T>
+typename PersistentCircularList<T>::const_iterator
+PersistentCircularList<T>::cend() const {
+    return end();
+}
+
+template <typename T>
+typename PersistentCircularList<T>::const_reverse_iterator
+PersistentCircularList<T>::rbegin() const {
+    return const_reverse_iterator(end());
+}
+
+template <typename T>
+typename PersistentCircularList<T>::const_reverse_iterator
+PersistentCircularList<T>::rend() const {
+    return const_reverse_iterator(begin());
+}
+
+template <typename T>
+template <typename F>
+void PersistentCircularList<T>::for_each(F f) const {
+    size_t n = size();
+    // Сначала физические [offset, n), затем [0, offset)
+    size_t skip = offset;
+    size_t left = n - offset;
+    if (!visit(root.get(), skip, left, f)) return;
+    skip = 0;
+    left = offset;
+    visit(root.get(), skip, left, f);
+}
+
+// Модификаторы
+template <typename T>
+PersistentCircularList<T> PersistentCircularList<T>::push_back(
+    const T& value) const {
+    return insert(size(), value);
+}
+
+template <typename T>
+PersistentCircularList<T> PersistentCircularList<T>::push_front(
+    const T& value) const {
+    return insert(0, value);
+}
+
+template <typename T>
+PersistentCircularList<T> PersistentCircularList<T>::pop_back() const {
+    if (empty())
+        throw std::out_of_range(
+            "PersistentCircularList::pop_back: empty list");
+    return erase(size() - 1);
+}
+
+template <typename T>
+PersistentCircularList<T> PersistentCircularList<T>::pop_front() const {
+    if (empty())
+        throw std::out_of_range(
+            "PersistentCircularList::pop_front: empty list");
+    return erase(0);
+}
+
+template <typename T>
+PersistentCircularList<T> PersistentCircularList<T>::insert(
+    size_t index, const T& value) const {
+    if (index > size())
+        throw std::out_of_range("PersistentCircularList::insert: bad index");
+    auto [first, rest] = split(normalized(), index);
+    Link node = make_node(value, next_priority(), nullptr, nullptr);
+    return PersistentCircularList(merge(merge(first, node), rest), 0);
+}
+
+template <typename T>
+PersistentCircularList<T> PersistentCircularList<T>::erase(
+    size_t index) const {
+    if (index >= size())
+        throw std::out_of_range("PersistentCircularList::erase: bad index");
+    auto [first, rest] = split(normalized(), index);
+    return PersistentCircularList(merge(first, split(rest, 1).second), 0);
+}
+
+template <typename T>
+PersistentCircularList<T> PersistentCircularList<T>::set(
+    size_t index, const T& value) const {
+    if (index >= size())
+        throw std::out_of_range("PersistentCircularList::set: bad index");
+    return PersistentCircularList(
+        assign_physical(root, physical(index), value), offset);
+}
+
+template <typename T>
+PersistentCircularList<T> PersistentCircularList<T>::rotate(
+    std::ptrdiff_t n) const {
+    if (size() < 2) return *this;
+    auto count = static_cast<std::ptrdiff_t>(size());
+    std::ptrdiff_t steps = n % count;
+    if (steps < 0) steps += count;
+    return PersistentCircularList(root,
+                                  physical(static_cast<size_t>(steps)));
+}
+
+// Операторы сравнения
+template <typename T>
+bool PersistentCircularList<T>::operator==(
+    const PersistentCircularList& other) const {
+    if (size() != other.size()) return false;
+    if (root == other.root && offset == other.offset) return true;
+    std::vector<const T*> values;
+    values.reserve(size());
+    for_each([&values](const T& value) { values.push_back(&value); });
+    size_t i = 0;
+    bool equal = true;
+    other.for_each([&](const T& value) {
+        equal = *values[i++] == value;
+        return equal;
+    });
+    return equal;
+}
+
+template <typename T>
+bool PersistentCircularList<T>::operator!=(
+    const PersistentCircularList& other) const {
+    return !(*this == other);
+}
+
+template <typename T>
+bool PersistentCircularList<T>::operator<(
+    const PersistentCircularList& other) const {
+    std::vector<const T*> values;
+    values.reserve(size());
+    for_each([&values](const T& value) { values.push_back(&value); });
+    size_t i = 0;
+    int order = 0;
+    other.for_each([&](const T& value) {
+        if (i == values.size()) {
+            order = -1;
+        } else if (*values[i] < value) {
+            order = -1;
+        } else if (value < *values[i]) {
+            order = 1;
+        }
+        ++i;
+        return order == 0;
+    });
+    return order == 0 ? values.size() < other.size() : order < 0;
+}
+
+template <typename T>
+bool PersistentCircularList<T>::operator>(
+    const PersistentCircularList& other) const {
+    return other < *this;
+}
+
+template <typename T>
+bool PersistentCircularList<T>::operator<=(
+    const PersistentCircularList& other) const {
+    return !(other < *this);
+}
+
+template <typename T>
+bool PersistentCircularList<T>::operator>=(
+    const PersistentCircularList& other) const {
+    return !(*this < other);
+}
+
+// Итератор
+template <typename T>
+PersistentCircularList<T>::const_iterator::const_iterator(
+    const PersistentCircularList* l, size_t i)
+    : list(l), index(i) {
+}
+
+template <typename T>
+const T& PersistentCircularList<T>::const_iterator::operator*() const {
+    if (index >= list->size())
+        throw std::out_of_range(
+            "PersistentCircularList::const_iterator::operator*: "
+            "dereferencing end iterator");
+    return (*list)[index];
+}
+
+template <typename T>
+typename PersistentCircularList<T>::const_iterator&
+PersistentCircularList<T>::const_iterator::operator++() {
+    if (index >= list->size())
+        throw std::out_of_range(
+            "PersistentCircularList::const_iterator::operator++: "
+            "incrementing end iterator");
+    ++index;
+    return *this;
+}
+
+template <typename T>
+typename PersistentCircularList<T>::const_iterator&
+PersistentCircularList<T>::const_iterator::operator--() {
+    if (list->empty())
+        throw std::out_of_range(
+            "PersistentCircularList::const_iterator::operator--: empty list");
+    index = index == 0 ? list->size() - 1 : index - 1;
+    return *this;
+}
+
+template <typename T>
+bool PersistentCircularList<T>::const_iterator::operator==(
+    const const_iterator& other) const {
+    return index == other.index;
+}
+
+template <typename T>
+bool PersistentCircularList<T>::const_iterator::operator!=(
+    const const_iterator& other) const {
+    return index != other.index;
+}
+
+#endif
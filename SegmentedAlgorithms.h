@@ -0,0 +1,606 @@
+#ifndef SEGMENTED_ALGORITHMS_H
+#define SEGMENTED_ALGORITHMS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SEGMENTED_HAS_X86_KERNELS 1
+#define SEGMENTED_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+// Алгоритмы поверх сегментного протокола (segment_begin/segment_end,
+// segment_iterator::to_iterator). Для int32_t и float длинные сегменты
+// обрабатываются векторными ядрами AVX2 или SSE4.1, которые выбираются во
+// время выполнения по CPUID; для остальных типов и коротких сегментов
+// используется скалярный цикл. Для float с NaN результат min_element и
+// max_element не определён, а accumulate суммирует в другом порядке, чем
+// std::accumulate.
+namespace segmented {
+namespace detail {
+
+enum class SimdLevel { scalar, sse41, avx2 };
+
+// Сегменты короче этого порога обрабатываются скалярно
+constexpr size_t kSimdThreshold = 16;
+
+inline SimdLevel detect_simd_level() {
+#ifdef SEGMENTED_HAS_X86_KERNELS
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return SimdLevel::avx2;
+    if (__builtin_cpu_supports("sse4.1")) return SimdLevel::sse41;
+#endif
+    return SimdLevel::scalar;
+}
+
+inline SimdLevel simd_level() {
+    static const SimdLevel level = detect_simd_level();
+    return level;
+}
+
+template <typename T>
+constexpr bool has_simd_kernels =
+    std::is_same_v<T, int32_t> || std::is_same_v<T, float>;
+
+// Скалярный цикл сравнивает elem == value в общем типе C. Ядро для T можно
+// применить, если C совпадает с T или каждое значение T точно представимо
+// в C (знаковое целое или вещественное с не меньшей мантиссой)
+template <typename T, typename U>
+constexpr bool kernel_compatible() {
+    if constexpr (!has_simd_kernels<T> || !std::is_arithmetic_v<U>) {
+        return false;
+    } else {
+        using C = std::common_type_t<T, U>;
+        return std::is_same_v<C, T> ||
+               (std::numeric_limits<C>::is_signed &&
+                std::numeric_limits<C>::digits >=
+                    std::numeric_limits<T>::digits);
+    }
+}
+
+// Приводит value к T для ядра. Возвращает false, если value не равно ни
+// одному значению T; диапазон и NaN проверяются до преобразования
+template <typename T, typename U>
+bool to_kernel_value(const U& value, T& out) {
+    using C = std::common_type_t<T, U>;
+    if constexpr (std::is_same_v<C, T>) {
+        out = static_cast<T>(value);
+        return true;
+    } else {
+        const C wide = static_cast<C>(value);
+        if constexpr (std::is_floating_point_v<T>) {
+            if (wide == std::numeric_limits<C>::infinity() ||
+                wide == -std::numeric_limits<C>::infinity()) {
+                out = static_cast<T>(wide);
+                return true;
+            }
+        }
+        if (!(wide >= static_cast<C>(std::numeric_limits<T>::lowest()) &&
+              wide <= static_cast<C>(std::numeric_limits<T>::max()))) {
+            return false;
+        }
+        out = static_cast<T>(wide);
+        return static_cast<C>(out) == wide;
+    }
+}
+
+// Скалярные ядра
+namespace scalar {
+
+template <typename T, typename U>
+size_t find(const T* data, size_t n, const U& value) {
+    for (size_t i = 0; i < n; ++i) {
+        if (data[i] == value) return i;
+    }
+    return n;
+}
+
+template <typename T, typename U>
+size_t count(const T* data, size_t n, const U& value) {
+    size_t result = 0;
+    for (size_t i = 0; i < n; ++i) {
+        if (data[i] == value) ++result;
+    }
+    return result;
+}
+
+template <typename T>
+size_t min_index(const T* data, size_t n) {
+    size_t best = 0;
+    for (size_t i = 1; i < n; ++i) {
+        if (data[i] < data[best]) best = i;
+    }
+    return best;
+}
+
+template <typename T>
+size_t max_index(const T* data, size_t n) {
+    size_t best = 0;
+    for (size_t i = 1; i < n; ++i) {
+        if (data[best] < data[i]) best = i;
+    }
+    return best;
+}
+
+template <typename T, typename Acc>
+Acc accumulate(const T* data, size_t n, Acc init) {
+    for (size_t i = 0; i < n; ++i) init = init + data[i];
+    return init;
+}
+
+}  // namespace scalar
+
+#ifdef SEGMENTED_HAS_X86_KERNELS
+namespace sse41 {
+
+SEGMENTED_TARGET("sse4.1")
+inline __m128i load(const int32_t* data) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+}
+
+SEGMENTED_TARGET("sse4.1")
+inline size_t find(const int32_t* data, size_t n, int32_t value) {
+    const __m128i needle = _mm_set1_epi32(value);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i block = load(data + i);
+        int mask = _mm_movemask_ps(
+            _mm_castsi128_ps(_mm_cmpeq_epi32(block, needle)));
+        if (mask) return i + __builtin_ctz(mask);
+    }
+    return i + scalar::find(data + i, n - i, value);
+}
+
+SEGMENTED_TARGET("sse4.1")
+inline size_t find(const float* data, size_t n, float value) {
+    const __m128 needle = _mm_set1_ps(value);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        int mask =
+            _mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(data + i), needle));
+        if (mask) return i + __builtin_ctz(mask);
+    }
+    return i + scalar::find(data + i, n - i, value);
+}
+
+SEGMENTED_TARGET("sse4.1")
+inline size_t count(const int32_t* data, size_t n, int32_t value) {
+    const __m128i needle = _mm_set1_epi32(value);
+    size_t result = 0;
+    size_t i = 0;
+    while (i + 4 <= n) {
+        // Счётчики в полосах 32-битные, поэтому сбрасываем их блоками
+        __m128i acc = _mm_setzero_si128();
+        size_t block_end = i + (size_t(1) << 30);
+        for (; i + 4 <= n && i < block_end; i += 4) {
+            __m128i block = load(data + i);
+            acc = _mm_sub_epi32(acc, _mm_cmpeq_epi32(block, needle));
+        }
+        alignas(16) uint32_t lanes[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+        result += size_t(lanes[0]) + lanes[1] + lanes[2] + lanes[3];
+    }
+    return result + scalar::count(data + i, n - i, value);
+}
+
+SEGMENTED_TARGET("sse4.1")
+inline size_t count(const float* data, size_t n, float value) {
+    const __m128 needle = _mm_set1_ps(value);
+    size_t result = 0;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        int mask =
+            _mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(data + i), needle));
+        result += __builtin_popcount(mask);
+    }
+    return result + scalar::count(data + i, n - i, value);
+}
+
+SEGMENTED_TARGET("sse4.1")
+inline int32_t min_value(const int32_t* data, size_t n) {
+    __m128i acc = _mm_set1_epi32(data[0]);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) acc = _mm_min_epi32(acc, load(data + i));
+    acc = _mm_min_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(1, 0, 3, 2)));
+    acc = _mm_min_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(2, 3, 0, 1)));
+    int32_t result = _mm_cvtsi128_si32(acc);
+    for (; i < n; ++i) result = data[i] < result ? data[i] : result;
+    return result;
+}
+
+SEGMENTED_TARGET("sse4.1")
+inline int32_t max_value(const int32_t* data, size_t n) {
+    __m128i acc = _mm_set1_epi32(data[0]);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) acc = _mm_max_epi32(acc, load(data + i));
+    acc = _mm_max_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(1, 0, 3, 2)));
+    acc = _mm_max_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(2, 3, 0, 1)));
+    int32_t result = _mm_cvtsi128_si32(acc);
+    for (; i < n; ++i) result = result < data[i] ? data[i] : result;
+    return result;
+}
+
+SEGMENTED_TARGET("sse4.1")
+inline float min_value(const float* data, size_t n) {
+    __m128 acc = _mm_set1_ps(data[0]);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) acc = _mm_min_ps(acc, _mm_loadu_ps(data + i));
+    acc = _mm_min_ps(acc, _mm_shuffle_ps(acc, acc, _MM_SHUFFLE(1, 0, 3, 2)));
+    acc = _mm_min_ps(acc, _mm_shuffle_ps(acc, acc, _MM_SHUFFLE(2, 3, 0, 1)));
+    float result = _mm_cvtss_f32(acc);
+    for (; i < n; ++i) result = data[i] < result ? data[i] : result;
+    return result;
+}
+
+SEGMENTED_TARGET("sse4.1")
+inline float max_value(const float* data, size_t n) {
+    __m128 acc = _mm_set1_ps(data[0]);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) acc = _mm_max_ps(acc, _mm_loadu_ps(data + i));
+    acc = _mm_max_ps(acc, _mm_shuffle_ps(acc, acc, _MM_SHUFFLE(1, 0, 3, 2)));
+    acc = _mm_max_ps(acc, _mm_shuffle_ps(acc, acc, _MM_SHUFFLE(2, 3, 0, 1)));
+    float result = _mm_cvtss_f32(acc);
+    for (; i < n; ++i) result = result < data[i] ? data[i] : result;
+    return result;
+}
+
+SEGMENTED_TARGET("sse4.1")
+inline int32_t sum(const int32_t* data, size_t n) {
+    __m128i acc = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) acc = _mm_add_epi32(acc, load(data + i));
+    acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(1, 0, 3, 2)));
+    acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(2, 3, 0, 1)));
+    uint32_t result = uint32_t(_mm_cvtsi128_si32(acc));
+    for (; i < n; ++i) result += uint32_t(data[i]);
+    return int32_t(result);
+}
+
+SEGMENTED_TARGET("sse4.1")
+inline float sum(const float* data, size_t n) {
+    __m128 acc = _mm_setzero_ps();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) acc = _mm_add_ps(acc, _mm_loadu_ps(data + i));
+    acc = _mm_add_ps(acc, _mm_shuffle_ps(acc, acc, _MM_SHUFFLE(1, 0, 3, 2)));
+    acc = _mm_add_ps(acc, _mm_shuffle_ps(acc, acc, _MM_SHUFFLE(2, 3, 0, 1)));
+    float result = _mm_cvtss_f32(acc);
+    for (; i < n; ++i) result += data[i];
+    return result;
+}
+
+}  // namespace sse41
+
+namespace avx2 {
+
+SEGMENTED_TARGET("avx2")
+inline __m256i load(const int32_t* data) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+}
+
+SEGMENTED_TARGET("avx2")
+inline size_t find(const int32_t* data, size_t n, int32_t value) {
+    const __m256i needle = _mm256_set1_epi32(value);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i block = load(data + i);
+        int mask = _mm256_movemask_ps(
+            _mm256_castsi256_ps(_mm256_cmpeq_epi32(block, needle)));
+        if (mask) return i + __builtin_ctz(mask);
+    }
+    return i + scalar::find(data + i, n - i, value);
+}
+
+SEGMENTED_TARGET("avx2")
+inline size_t find(const float* data, size_t n, float value) {
+    const __m256 needle = _mm256_set1_ps(value);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        int mask = _mm256_movemask_ps(
+            _mm256_cmp_ps(_mm256_loadu_ps(data + i), needle, _CMP_EQ_OQ));
+        if (mask) return i + __builtin_ctz(mask);
+    }
+    return i + scalar::find(data + i, n - i, value);
+}
+
+SEGMENTED_TARGET("avx2")
+inline size_t count(const int32_t* data, size_t n, int32_t value) {
+    const __m256i needle = _mm256_set1_epi32(value);
+    size_t result = 0;
+    size_t i = 0;
+    while (i + 8 <= n) {
+        __m256i acc = _mm256_setzero_si256();
+        size_t block_end = i + (size_t(1) << 30);
+        for (; i + 8 <= n && i < block_end; i += 8) {
+            __m256i block = load(data + i);
+            acc = _mm256_sub_epi32(acc, _mm256_cmpeq_epi32(block, needle));
+        }
+        alignas(32) uint32_t lanes[8];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+        for (uint32_t lane : lanes) result += lane;
+    }
+    return result + scalar::count(data + i, n - i, value);
+}
+
+SEGMENTED_TARGET("avx2")
+inline size_t count(const float* data, size_t n, float value) {
+    const __m256 needle = _mm256_set1_ps(value);
+    size_t result = 0;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        int mask = _mm256_movemask_ps(
+            _mm256_cmp_ps(_mm256_loadu_ps(data + i), needle, _CMP_EQ_OQ));
+        result += __builtin_popcount(mask);
+    }
+    return result + scalar::count(data + i, n - i, value);
+}
+
+SEGMENTED_TARGET("avx2")
+inline int32_t min_value(const int32_t* data, size_t n) {
+    __m256i acc = _mm256_set1_epi32(data[0]);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) acc = _mm256_min_epi32(acc, load(data + i));
+    __m128i v = _mm_min_epi32(_mm256_castsi256_si128(acc),
+                              _mm256_extracti128_si256(acc, 1));
+    v = _mm_min_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+    v = _mm_min_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+    int32_t result = _mm_cvtsi128_si32(v);
+    for (; i < n; ++i) result = data[i] < result ? data[i] : result;
+    return result;
+}
+
+SEGMENTED_TARGET("avx2")
+inline int32_t max_value(const int32_t* data, size_t n) {
+    __m256i acc = _mm256_set1_epi32(data[0]);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) acc = _mm256_max_epi32(acc, load(data + i));
+    __m128i v = _mm_max_epi32(_mm256_castsi256_si128(acc),
+                              _mm256_extracti128_si256(acc, 1));
+    v = _mm_max_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+    v = _mm_max_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+    int32_t result = _mm_cvtsi128_si32(v);
+    for (; i < n; ++i) result = result < data[i] ? data[i] : result;
+    return result;
+}
+
+SEGMENTED_TARGET("avx2")
+inline float min_value(const float* data, size_t n) {
+    __m256 acc = _mm256_set1_ps(data[0]);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        acc = _mm256_min_ps(acc, _mm256_loadu_ps(data + i));
+    }
+    __m128 v = _mm_min_ps(_mm256_castps256_ps128(acc),
+                          _mm256_extractf128_ps(acc, 1));
+    v = _mm_min_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+    v = _mm_min_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+    float result = _mm_cvtss_f32(v);
+    for (; i < n; ++i) result = data[i] < result ? data[i] : result;
+    return result;
+}
+
+SEGMENTED_TARGET("avx2")
+inline float max_value(const float* data, size_t n) {
+    __m256 acc = _mm256_set1_ps(data[0]);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        acc = _mm256_max_ps(acc, _mm256_loadu_ps(data + i));
+    }
+    __m128 v = _mm_max_ps(_mm256_castps256_ps128(acc),
+                          _mm256_extractf128_ps(acc, 1));
+    v = _mm_max_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+    v = _mm_max_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+    float result = _mm_cvtss_f32(v);
+    for (; i < n; ++i) result = result < data[i] ? data[i] : result;
+    return result;
+}
+
+SEGMENTED_TARGET("avx2")
+inline int32_t sum(const int32_t* data, size_t n) {
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) acc = _mm256_add_epi32(acc, load(data + i));
+    __m128i v = _mm_add_epi32(_mm256_castsi256_si128(acc),
+                              _mm256_extracti128_si256(acc, 1));
+    v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+    v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+    uint32_t result = uint32_t(_mm_cvtsi128_si32(v));
+    for (; i < n; ++i) result += uint32_t(data[i]);
+    return int32_t(result);
+}
+
+SEGMENTED_TARGET("avx2")
+inline float sum(const float* data, size_t n) {
+    __m256 acc = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        acc = _mm256_add_ps(acc, _mm256_loadu_ps(data + i));
+    }
+    __m128 v = _mm_add_ps(_mm256_castps256_ps128(acc),
+                          _mm256_extractf128_ps(acc, 1));
+    v = _mm_add_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+    v = _mm_add_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+    float result = _mm_cvtss_f32(v);
+    for (; i < n; ++i) result += data[i];
+    return result;
+}
+
+}  // namespace avx2
+#endif
+
+// Диспетчеризация: векторное ядро для int32_t/float на длинных сегментах,
+// иначе скалярный цикл
+template <typename T, typename U>
+size_t find_index(const T* data, size_t n, const U& value) {
+#ifdef SEGMENTED_HAS_X86_KERNELS
+    if constexpr (kernel_compatible<T, U>()) {
+        T needle;
+        if (!to_kernel_value(value, needle)) return n;
+        if (n >= kSimdThreshold) {
+            switch (simd_level()) {
+                case SimdLevel::avx2:
+                    return avx2::find(data, n, needle);
+                case SimdLevel::sse41:
+                    return sse41::find(data, n, needle);
+                case SimdLevel::scalar:
+                    break;
+            }
+        }
+    }
+#endif
+    return scalar::find(data, n, value);
+}
+
+template <typename T, typename U>
+size_t count(const T* data, size_t n, const U& value) {
+#ifdef SEGMENTED_HAS_X86_KERNELS
+    if constexpr (kernel_compatible<T, U>()) {
+        T needle;
+        if (!to_kernel_value(value, needle)) return 0;
+        if (n >= kSimdThreshold) {
+            switch (simd_level()) {
+                case SimdLevel::avx2:
+                    return avx2::count(data, n, needle);
+                case SimdLevel::sse41:
+                    return sse41::count(data, n, needle);
+                case SimdLevel::scalar:
+                    break;
+            }
+        }
+    }
+#endif
+    return scalar::count(data, n, value);
+}
+
+template <typename T>
+size_t min_index(const T* data, size_t n) {
+#ifdef SEGMENTED_HAS_X86_KERNELS
+    if constexpr (has_simd_kernels<T>) {
+        if (n >= kSimdThreshold) {
+            switch (simd_level()) {
+                case SimdLevel::avx2:
+                    return avx2::find(data, n, avx2::min_value(data, n));
+                case SimdLevel::sse41:
+                    return sse41::find(data, n, sse41::min_value(data, n));
+                case SimdLevel::scalar:
+                    break;
+            }
+        }
+    }
+#endif
+    return scalar::min_index(data, n);
+}
+
+template <typename T>
+size_t max_index(const T* data, size_t n) {
+#ifdef SEGMENTED_HAS_X86_KERNELS
+    if constexpr (has_simd_kernels<T>) {
+        if (n >= kSimdThreshold) {
+            switch (simd_level()) {
+                case SimdLevel::avx2:
+                    return avx2::find(data, n, avx2::max_value(data, n));
+                case SimdLevel::sse41:
+                    return sse41::find(data, n, sse41::max_value(data, n));
+                case SimdLevel::scalar:
+                    break;
+            }
+        }
+    }
+#endif
+    return scalar::max_index(data, n);
+}
+
+template <typename T, typename Acc>
+Acc accumulate(const T* data, size_t n, Acc init) {
+#ifdef SEGMENTED_HAS_X86_KERNELS
+    if constexpr (has_simd_kernels<T> && std::is_same_v<T, Acc>) {
+        if (n >= kSimdThreshold) {
+            switch (simd_level()) {
+                case SimdLevel::avx2:
+                    return init + avx2::sum(data, n);
+                case SimdLevel::sse41:
+                    return init + sse41::sum(data, n);
+                case SimdLevel::scalar:
+                    break;
+            }
+        }
+    }
+#endif
+    return scalar::accumulate(data, n, init);
+}
+
+}  // namespace detail
+
+// Первый элемент, равный value, или end()
+template <typename List, typename U>
+auto find(List& list, const U& value) -> decltype(list.begin()) {
+    for (auto seg = list.segment_begin(); seg != list.segment_end(); ++seg) {
+        auto span = *seg;
+        size_t i = detail::find_index(span.data(), span.size(), value);
+        if (i != span.size()) return seg.to_iterator(i);
+    }
+    return list.end();
+}
+
+template <typename List, typename U>
+size_t count(const List& list, const U& value) {
+    size_t result = 0;
+    list.for_each_segment([&](auto span) {
+        result += detail::count(span.data(), span.size(), value);
+    });
+    return result;
+}
+
+// Первый наименьший элемент или end() для пустого списка
+template <typename List>
+auto min_element(List& list) -> decltype(list.begin()) {
+    auto best_seg = list.segment_end();
+    size_t best_index = 0;
+    using Span = decltype(*list.segment_begin());
+    const typename Span::element_type* best = nullptr;
+    for (auto seg = list.segment_begin(); seg != list.segment_end(); ++seg) {
+        auto span = *seg;
+        if (span.empty()) continue;
+        size_t i = detail::min_index(span.data(), span.size());
+        if (!best || span[i] < *best) {
+            best = &span[i];
+            best_seg = seg;
+            best_index = i;
+        }
+    }
+    return best ? best_seg.to_iterator(best_index) : list.end();
+}
+
+// Первый наибольший элемент или end() для пустого списка
+template <typename List>
+auto max_element(List& list) -> decltype(list.begin()) {
+    auto best_seg = list.segment_end();
+    size_t best_index = 0;
+    using Span = decltype(*list.segment_begin());
+    const typename Span::element_type* best = nullptr;
+    for (auto seg = list.segment_begin(); seg != list.segment_end(); ++seg) {
+        auto span = *seg;
+        if (span.empty()) continue;
+        size_t i = detail::max_index(span.data(), span.size());
+        if (!best || *best < span[i]) {
+            best = &span[i];
+            best_seg = seg;
+            best_index = i;
+        }
+    }
+    return best ? best_seg.to_iterator(best_index) : list.end();
+}
+
+template <typename List, typename Acc>
+Acc accumulate(const List& list, Acc init) {
+    list.for_each_segment([&](auto span) {
+        init = detail::accumulate(span.data(), span.size(), init);
+    });
+    return init;
+}
+
+}  // namespace segmented
+
+#endif
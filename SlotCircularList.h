@@ -0,0 +1,695 @@
+#ifndef SLOT_CIRCULAR_LIST_H
+#define SLOT_CIRCULAR_LIST_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Кольцевой список с устойчивыми описателями элементов. Узлы лежат в
+// общем пуле (std::vector) и связаны 32-битными номерами; освобождённые
+// узлы образуют односвязный список и используются повторно.
+//
+// Описатель - номер узла и поколение, всего 8 байт. Поколение узла
+// увеличивается при каждом занятии и освобождении (нечётное - узел
+// занят), поэтому описатель удалённого элемента распознаётся за O(1) и
+// не путается с элементом, занявшим тот же узел позже. Узел, поколение
+// которого исчерпано, больше не выдаётся.
+//
+// Описатели остаются действительными при любых изменениях других
+// элементов и при копировании списка (в копии они указывают на те же
+// элементы). Рост пула делает недействительными указатели и ссылки,
+// полученные через get(), но не описатели.
+template <typename T>
+class SlotCircularList {
+    public:
+        struct Handle {
+                uint32_t slot = UINT32_MAX;
+                uint32_t generation = 0;
+                bool operator==(const Handle& other) const = default;
+        };
+
+    private:
+        static constexpr uint32_t npos = UINT32_MAX;
+
+        struct Slot {
+                union {
+                        T value;
+                };
+                uint32_t next;
+                uint32_t prev;
+                uint32_t generation;
+                Slot() : next(npos), prev(npos), generation(0) {}
+                Slot(const Slot& other);
+                Slot(Slot&& other) noexcept(
+                    std::is_nothrow_move_constructible_v<T>);
+                Slot& operator=(const Slot&) = delete;
+                ~Slot();
+                bool live() const { return generation & 1; }
+        };
+
+        std::vector<Slot> slots;
+        uint32_t head;
+        uint32_t count;
+        uint32_t free_head;
+
+        // Создаёт значение в свободном узле; при исключении узел остаётся
+        // свободным
+        uint32_t construct_node(const T& value);
+        void destroy_node(uint32_t node) noexcept;
+        // Вставка узла перед pos (npos - в конец)
+        void link_before(uint32_t node, uint32_t pos) noexcept;
+        void unlink(uint32_t node) noexcept;
+        // Номер узла живого элемента; npos для устаревшего описателя
+        uint32_t resolve(Handle handle) const;
+        uint32_t checked(Handle handle, const char* message) const;
+        Handle handle_of(uint32_t node) const;
+
+        template <bool Const>
+        class basic_iterator;
+
+    public:
+        // Конструкторы
+        SlotCircularList();
+        SlotCircularList(const SlotCircularList& other) = default;
+        SlotCircularList(SlotCircularList&& other) noexcept;
+        ~SlotCircularList() = default;
+
+        // Операторы присваивания
+        SlotCircularList& operator=(const SlotCircularList& other);
+        SlotCircularList& operator=(SlotCircularList&& other) noexcept;
+
+        // Итераторы; handle() возвращает описатель текущего элемента
+        using iterator = basic_iterator<false>;
+        using const_iterator = basic_iterator<true>;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+        iterator begin();
+        iterator end();
+        const_iterator begin() const;
+        const_iterator end() const;
+        const_iterator cbegin() const;
+        const_iterator cend() const;
+        reverse_iterator rbegin();
+        reverse_iterator rend();
+        const_reverse_iterator rbegin() const;
+        const_reverse_iterator rend() const;
+
+        // Если f возвращает bool, false прекращает обход
+        template <typename F>
+        void for_each(F f);
+        template <typename F>
+        void for_each(F f) const;
+
+        // Размер и проверка на пустоту
+        size_t size() const;
+        bool empty() const;
+        // Число узлов в пуле, включая свободные
+        size_t capacity() const;
+        void reserve(size_t n);
+
+        // Доступ по описателю: nullptr, если элемент уже удалён
+        T* get(Handle handle);
+        const T* get(Handle handle) const;
+        bool contains(Handle handle) const;
+
+        // Доступ к элементам
+        T& front();
+        const T& front() const;
+        T& back();
+        const T& back() const;
+        Handle front_handle() const;
+        Handle back_handle() const;
+        // Соседи по кольцу: за последним элементом следует первый.
+        // Устаревший описатель - std::invalid_argument
+        Handle next(Handle handle) const;
+        Handle prev(Handle handle) const;
+
+        // Модификаторы
+        Handle push_back(const T& value);
+        Handle push_front(const T& value);
+        // Вставка перед элементом pos
+        Handle insert(Handle pos, const T& value);
+        // false, если элемент уже удалён
+        bool erase(Handle handle);
+        void pop_back();
+        void pop_front();
+        // Все описатели становятся устаревшими; пул сохраняется
+        void clear();
+        void swap(SlotCircularList& other) noexcept;
+
+        // Операторы сравнения
+        bool operator==(const SlotCircularList& other) const;
+        bool operator!=(const SlotCircularList& other) const;
+        bool operator<(const SlotCircularList& other) const;
+        bool operator>(const SlotCircularList& other) const;
+        bool operator<=(const SlotCircularList& other) const;
+        bool operator>=(const SlotCircularList& other) const;
+
+    private:
+        template <bool Const>
+        class basic_iterator {
+                using List = std::conditional_t<Const, const SlotCircularList,
+                                                SlotCircularList>;
+
+                List* list;
+                uint32_t node;  // npos - конец
+
+            public:
+                using iterator_category = std::bidirectional_iterator_tag;
+                using value_type = T;
+                using difference_type = std::ptrdiff_t;
+                using pointer = std::conditional_t<Const, const T*, T*>;
+                using reference = std::conditional_t<Const, const T&, T&>;
+                basic_iterator(List* l = nullptr, uint32_t n = npos);
+                // Неконстантный итератор приводится к константному
+                template <bool OtherConst>
+                    requires(Const && !OtherConst)
+                basic_iterator(const basic_iterator<OtherConst>& other);
+                reference operator*() const;
+                basic_iterator& operator++();
+                basic_iterator& operator--();
+                Handle handle() const;
+                bool operator==(const basic_iterator& other) const;
+                bool operator!=(const basic_iterator& other) const;
+                template <bool>
+                friend class basic_iterator;
+        };
+};
+
+// Узлы
+template <typename T>
+SlotCircularList<T>::Slot::Slot(const Slot& other)
+    : next(other.next), prev(other.prev), generation(other.generation) {
+    if (other.live()) std::construct_at(&value, other.value);
+}
+
+template <typename T>
+SlotCircularList<T>::Slot::Slot(Slot&& other) noexcept(
+    std::is_nothrow_move_constructible_v<T>)
+    : next(other.next), prev(other.prev), generation(other.generation) {
+    if (other.live()) std::construct_at(&value, std::move(other.value));
+}
+
+template <typename T>
+SlotCircularList<T>::Slot::~Slot() {
+    if (live()) std::destroy_at(&value);
+}
+
+template <typename T>
+uint32_t SlotCircularList<T>::construct_node(const T& value) {
+    uint32_t node = free_head;
+    if (node == npos) {
+        if (slots.size() >= npos)
+            throw std::length_error("SlotCircularList: too many slots");
+        auto append = [this](auto&& source) {
+            slots.emplace_back();
+            uint32_t index = uint32_t(slots.size() - 1);
+            try {
+                std::construct_at(&slots[index].value,
+                                  std::forward<decltype(source)>(source));
+            } catch (...) {
+                slots.pop_back();
+                throw;
+            }
+            return index;
+        };
+        if (slots.size() == slots.capacity()) {
+            // Рост пула освобождает старый буфер, а value может лежать в
+            // нём: значение копируется до переезда
+            T copy(value);
+            node = append(std::move(copy));
+        } else {
+            node = append(value);
+        }
+    } else {
+        std::construct_at(&slots[node].value, value);
+        free_head = slots[node].next;
+    }
+    ++slots[node].generation;
+    return node;
+}
+
+template <typename T>
+void SlotCircularList<T>::destroy_node(uint32_t node) noexcept {
+    Slot& slot = slots[node];
+    std::destroy_at(&slot.value);
+    // После UINT32_MAX поколение начнётся заново, и старые описатели
+    // стали бы снова действительны: такой узел выводится из оборота
+    if (++slot.generation == 0) {
+        slot.generation = UINT32_MAX - 1;
+        return;
+    }
+    slot.next = free_head;
+    free_head = node;
+}
+
+template <typename T>
+void SlotCircularList<T>::link_before(uint32_t node, uint32_t pos) noexcept {
+    if (head == npos) {
+        slots[node].next = node;
+        slots[node].prev = node;
+        head = node;
+    } else {
+        uint32_t next = pos == npos ? head : pos;
+        uint32_t prev = slots[next].prev;
+        slots[node].next = next;
+        slots[node].prev = prev;
+        slots[prev].next = node;
+        slots[next].prev = node;
+        if (pos == head) head = node;
+    }
+    ++count;
+}
+
+template <typename T>
+void SlotCircularList<T>::unlink(uint32_t node) noexcept {
+    if (slots[node].next == node) {
+        head = npos;
+    } else {
+        slots[slots[node].prev].next = slots[node].next;
+        slots[slots[node].next].prev = slots[node].prev;
+        if (node == head) head = slots[node].next;
+    }
+    --count;
+}
+
+template <typename T>
+uint32_t SlotCircularList<T>::resolve(Handle handle) const {
+    if (handle.slot >= slots.size() || !(handle.generation & 1) ||
+        slots[handle.slot].generation != handle.generation) {
+        return npos;
+    }
+    return handle.slot;
+}
+
+template <typename T>
+uint32_t SlotCircularList<T>::checked(Handle handle,
+                                      const char* message) const {
+    uint32_t node = resolve(handle);
+    if (node == npos) throw std::invalid_argument(message);
+    return node;
+}
+
+template <typename T>
+typename SlotCircularList<T>::Handle SlotCircularList<T>::handle_of(
+    uint32_t node) const {
+    return Handle{node, slots[node].generation};
+}
+
+// Конструкторы
+template <typename T>
+SlotCircularList<T>::SlotCircularList()
+    : head(npos), count(0), free_head(npos) {
+}
+
+template <typename T>
+SlotCircularList<T>::SlotCircularList(SlotCircularList&& other) noexcept
+    : SlotCircularList() {
+    swap(other);
+}
+
+// Операторы присваивания
+template <typename T>
+SlotCircularList<T>& SlotCircularList<T>::operator=(
+    const SlotCircularList& other) {
+    if (this != &other) {
+        SlotCircularList temp(other);
+        swap(temp);
+    }
+    return *this;
+}
+
+template <typename T>
+SlotCircularList<T>& SlotCircularList<T>::operator=(
+    SlotCircularList&& other) noexcept {
+    if (this != &other) {
+        SlotCircularList temp(std::move(other));
+        swap(temp);
+    }
+    return *this;
+}
+
+// Итераторы
+template <typename T>
+typename SlotCircularList<T>::iterator SlotCircularList<T>::begin() {
+    return iterator(this, head);
+}
+
+template <typename T>
+typename SlotCircularList<T>::iterator SlotCircularList<T>::end() {
+    return iterator(this, npos);
+}
+
+template <typename T>
+typename SlotCircularList<T>::const_iterator SlotCircularList<T>::begin()
+    const {
+    return const_iterator(this, head);
+}
+
+template <typename T>
+typename SlotCircularList<T>::const_iterator SlotCircularList<T>::end()
+    const {
+    return const_iterator(this, npos);
+}
+
+template <typename T>
+typename SlotCircularList<T>::const_iterator SlotCircularList<T>::cbegin()
+    const {
+    return begin();
+}
+
+template <typename T>
+typename SlotCircularList<T>::const_iterator SlotCircularList<T>::cend()
+    const {
+    return end();
+}
+
+template <typename T>
+typename SlotCircularList<T>::reverse_iterator SlotCircularList<T>::rbegin() {
+    return reverse_iterator(end());
+}
+
+template <typename T>
+typename SlotCircularList<T>::reverse_iterator SlotCircularList<T>::rend() {
+    return reverse_iterator(begin());
+}
+
+template <typename T>
+typename SlotCircularList<T>::const_reverse_iterator
+SlotCircularList<T>::rbegin() const {
+    return const_reverse_iterator(end());
+}
+
+template <typename T>
+typename SlotCircularList<T>::const_reverse_iterator
+SlotCircularList<T>::rend() const {
+    return const_reverse_iterator(begin());
+}
+
+template <typename T>
+template <bool Const>
+SlotCircularList<T>::basic_iterator<Const>::basic_iterator(List* l,
+                                                           uint32_t n)
+    : list(l), node(n) {
+}
+
+template <typename T>
+template <bool Const>
+template <bool OtherConst>
+    requires(Const && !OtherConst)
+SlotCircularList<T>::basic_iterator<Const>::basic_iterator(
+    const basic_iterator<OtherConst>& other)
+    : list(other.list), node(other.node) {
+}
+
+template <typename T>
+template <bool Const>
+typename SlotCircularList<T>::template basic_iterator<Const>::reference
+SlotCircularList<T>::basic_iterator<Const>::operator*() const {
+    if (node == npos)
+        throw std::out_of_range(
+            "SlotCircularList::iterator::operator*: dereferencing end "
+            "iterator");
+    return list->slots[node].value;
+}
+
+template <typename T>
+template <bool Const>
+typename SlotCircularList<T>::template basic_iterator<Const>&
+SlotCircularList<T>::basic_iterator<Const>::operator++() {
+    if (node == npos)
+        throw std::out_of_range(
+            "SlotCircularList::iterator::operator++: incrementing end "
+            "iterator");
+    node = list->slots[node].next == list->head ? npos : list->slots[node].next;
+    return *this;
+}
+
+template <typename T>
+template <bool Const>
+typename SlotCircularList<T>::template basic_iterator<Const>&
+SlotCircularList<T>::basic_iterator<Const>::operator--() {
+    if (list->head == npos)
+        throw std::out_of_range(
+            "SlotCircularList::iterator::operator--: empty list");
+    node = list->slots[node == npos ? list->head : node].prev;
+    return *this;
+}
+
+template <typename T>
+template <bool Const>
+typename SlotCircularList<T>::Handle
+SlotCircularList<T>::basic_iterator<Const>::handle() const {
+    if (node == npos)
+        throw std::out_of_range(
+            "SlotCircularList::iterator::handle: end iterator");
+    return list->handle_of(node);
+}
+
+template <typename T>
+template <bool Const>
+bool SlotCircularList<T>::basic_iterator<Const>::operator==(
+    const basic_iterator& other) const {
+    return node == other.node;
+}
+
+template <typename T>
+template <bool Const>
+bool SlotCircularList<T>::basic_iterator<Const>::operator!=(
+    const basic_iterator& other) const {
+    return node != other.node;
+}
+
+template <typename T>
+template <typename F>
+void SlotCircularList<T>::for_each(F f) {
+    uint32_t current = head;
+    for (uint32_t i = 0; i < count; ++i) {
+        uint32_t next = slots[current].next;
+        if constexpr (std::is_same_v<std::invoke_result_t<F&, T&>, bool>) {
+            if (!f(slots[current].value)) return;
+        } else {
+            f(slots[current].value);
+        }
+        current = next;
+    }
+}
+
+template <typename T>
+template <typename F>
+void SlotCircularList<T>::for_each(F f) const {
+    uint32_t current = head;
+    for (uint32_t i = 0; i < count; ++i) {
+        if constexpr (std::is_same_v<std::invoke_result_t<F&, const T&>,
+                                     bool>) {
+            if (!f(slots[current].value)) return;
+        } else {
+            f(slots[current].value);
+        }
+        current = slots[current].next;
+    }
+}
+
+// Размер и проверка на пустоту
+template <typename T>
+size_t SlotCircularList<T>::size() const {
+    return count;
+}
+
+template <typename T>
+bool SlotCircularList<T>::empty() const {
+    return count == 0;
+}
+
+template <typename T>
+size_t SlotCircularList<T>::capacity() const {
+    return slots.size();
+}
+
+template <typename T>
+void SlotCircularList<T>::reserve(size_t n) {
+    slots.reserve(std::min<size_t>(n, npos));
+}
+
+// Доступ по описателю
+template <typename T>
+T* SlotCircularList<T>::get(Handle handle) {
+    uint32_t node = resolve(handle);
+    return node == npos ? nullptr : &slots[node].value;
+}
+
+template <typename T>
+const T* SlotCircularList<T>::get(Handle handle) const {
+    uint32_t node = resolve(handle);
+    return node == npos ? nullptr : &slots[node].value;
+}
+
+template <typename T>
+bool SlotCircularList<T>::contains(Handle handle) const {
+    return resolve(handle) != npos;
+}
+
+// Доступ к элементам
+template <typename T>
+T& SlotCircularList<T>::front() {
+    if (empty()) throw std::out_of_range("SlotCircularList::front: empty list");
+    return slots[head].value;
+}
+
+template <typename T>
+const T& SlotCircularList<T>::front() const {
+    if (empty()) throw std::out_of_range("SlotCircularList::front: empty list");
+    return slots[head].value;
+}
+
+template <typename T>
+T& SlotCircularList<T>::back() {
+    if (empty()) throw std::out_of_range("SlotCircularList::back: empty list");
+    return slots[slots[head].prev].value;
+}
+
+template <typename T>
+const T& SlotCircularList<T>::back() const {
+    if (empty()) throw std::out_of_range("SlotCircularList::back: empty list");
+    return slots[slots[head].prev].value;
+}
+
+template <typename T>
+typename SlotCircularList<T>::Handle SlotCircularList<T>::front_handle()
+    const {
+    if (empty())
+        throw std::out_of_range("SlotCircularList::front_handle: empty list");
+    return handle_of(head);
+}
+
+template <typename T>
+typename SlotCircularList<T>::Handle SlotCircularList<T>::back_handle()
+    const {
+    if (empty())
+        throw std::out_of_range("SlotCircularList::back_handle: empty list");
+    return handle_of(slots[head].prev);
+}
+
+template <typename T>
+typename SlotCircularList<T>::Handle SlotCircularList<T>::next(
+    Handle handle) const {
+    uint32_t node = checked(handle, "SlotCircularList::next: stale handle");
+    return handle_of(slots[node].next);
+}
+
+template <typename T>
+typename SlotCircularList<T>::Handle SlotCircularList<T>::prev(
+    Handle handle) const {
+    uint32_t node = checked(handle, "SlotCircularList::prev: stale handle");
+    return handle_of(slots[node].prev);
+}
+
+// Модификаторы
+template <typename T>
+typename SlotCircularList<T>::Handle SlotCircularList<T>::push_back(
+    const T& value) {
+    uint32_t node = construct_node(value);
+    link_before(node, npos);
+    return handle_of(node);
+}
+
+template <typename T>
+typename SlotCircularList<T>::Handle SlotCircularList<T>::push_front(
+    const T& value) {
+    uint32_t node = construct_node(value);
+    link_before(node, head);
+    return handle_of(node);
+}
+
+template <typename T>
+typename SlotCircularList<T>::Handle SlotCircularList<T>::insert(
+    Handle pos, const T& value) {
+    uint32_t before =
+        checked(pos, "SlotCircularList::insert: stale handle");
+    uint32_t node = construct_node(value);
+    link_before(node, before);
+    return handle_of(node);
+}
+
+template <typename T>
+bool SlotCircularList<T>::erase(Handle handle) {
+    uint32_t node = resolve(handle);
+    if (node == npos) return false;
+    unlink(node);
+    destroy_node(node);
+    return true;
+}
+
+template <typename T>
+void SlotCircularList<T>::pop_back() {
+    if (empty())
+        throw std::out_of_range("SlotCircularList::pop_back: empty list");
+    uint32_t tail = slots[head].prev;
+    unlink(tail);
+    destroy_node(tail);
+}
+
+template <typename T>
+void SlotCircularList<T>::pop_front() {
+    if (empty())
+        throw std::out_of_range("SlotCircularList::pop_front: empty list");
+    uint32_t node = head;
+    unlink(node);
+    destroy_node(node);
+}
+
+template <typename T>
+void SlotCircularList<T>::clear() {
+    // Узлы освобождаются по одному: их поколения должны вырасти, чтобы
+    // старые описатели стали устаревшими
+    while (head != npos) pop_front();
+}
+
+template <typename T>
+void SlotCircularList<T>::swap(SlotCircularList& other) noexcept {
+    slots.swap(other.slots);
+    std::swap(head, other.head);
+    std::swap(count, other.count);
+    std::swap(free_head, other.free_head);
+}
+
+// Операторы сравнения
+template <typename T>
+bool SlotCircularList<T>::operator==(const SlotCircularList& other) const {
+    return size() == other.size() && std::equal(begin(), end(), other.begin());
+}
+
+template <typename T>
+bool SlotCircularList<T>::operator!=(const SlotCircularList& other) const {
+    return !(*this == other);
+}
+
+template <typename T>
+bool SlotCircularList<T>::operator<(const SlotCircularList& other) const {
+    return std::lexicographical_compare(begin(), end(), other.begin(),
+                                        other.end());
+}
+
+template <typename T>
+bool SlotCircularList<T>::operator>(const SlotCircularList& other) const {
+    return other < *this;
+}
+
+template <typename T>
+bool SlotCircularList<T>::operator<=(const SlotCircularList& other) const {
+    return !(other < *this);
+}
+
+template <typename T>
+bool SlotCircularList<T>::operator>=(const SlotCircularList& other) const {
+    return !(*this < other);
+}
+
+#endif
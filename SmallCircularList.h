@@ -0,0 +1,738 @@
+#ifndef SMALL_CIRCULAR_LIST_H
+#define SMALL_CIRCULAR_LIST_H
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+#include "CircularList.h"
+
+// Кольцевой список, хранящий до N элементов прямо в объекте (кольцевой
+// массив) без обращений к куче. При переполнении все элементы переносятся
+// в узлы CircularList; когда список снова становится пустым, он
+// возвращается во встроенный режим. Любой переход между режимами делает
+// итераторы недействительными.
+template <typename T, size_t N>
+class SmallCircularList {
+        static_assert(N > 0, "SmallCircularList: inline capacity must be > 0");
+
+    private:
+        alignas(T) std::byte storage[N * sizeof(T)];
+        size_t first;  // физический номер первого элемента в кольце
+        size_t count;  // число элементов во встроенном кольце
+        bool spilled;
+        CircularList<T> heap;
+
+        T* slots();
+        const T* slots() const;
+        // Элемент с логическим номером index во встроенном кольце
+        T& slot(size_t index);
+        const T& slot(size_t index) const;
+        // Длина первого непрерывного участка встроенного кольца
+        size_t first_run() const;
+        void destroy_inline() noexcept;
+        void move_from(SmallCircularList& other);
+        // Перенос встроенных элементов в кучу с добавлением value в
+        // начало или конец
+        void spill_with(const T& value, bool at_front);
+
+        template <bool Const>
+        class basic_iterator;
+        template <bool Const>
+        class basic_segment_iterator;
+
+    public:
+        static constexpr size_t inline_capacity = N;
+
+        // Конструкторы
+        SmallCircularList();
+        SmallCircularList(const SmallCircularList& other);
+        SmallCircularList(SmallCircularList&& other) noexcept(
+            std::is_nothrow_move_constructible_v<T>);
+        ~SmallCircularList();
+
+        // Операторы присваивания
+        SmallCircularList& operator=(const SmallCircularList& other);
+        SmallCircularList& operator=(SmallCircularList&& other) noexcept(
+            std::is_nothrow_move_constructible_v<T>);
+
+        // Итераторы
+        using iterator = basic_iterator<false>;
+        using const_iterator = basic_iterator<true>;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+        iterator begin();
+        iterator end();
+        const_iterator begin() const;
+        const_iterator end() const;
+        const_iterator cbegin() const;
+        const_iterator cend() const;
+        reverse_iterator rbegin();
+        reverse_iterator rend();
+        const_reverse_iterator rbegin() const;
+        const_reverse_iterator rend() const;
+
+        // Сегментный обход: во встроенном режиме не больше двух сегментов
+        using segment_iterator = basic_segment_iterator<false>;
+        using const_segment_iterator = basic_segment_iterator<true>;
+
+        segment_iterator segment_begin();
+        segment_iterator segment_end();
+        const_segment_iterator segment_begin() const;
+        const_segment_iterator segment_end() const;
+
+        template <typename F>
+        void for_each_segment(F f);
+        template <typename F>
+        void for_each_segment(F f) const;
+
+        // Размер и проверка на пустоту
+        size_t size() const;
+        bool empty() const;
+        // true, пока элементы хранятся во встроенном кольце
+        bool is_inline() const;
+
+        // Доступ к элементам
+        T& front();
+        const T& front() const;
+        T& back();
+        const T& back() const;
+
+        // Модификаторы
+        void push_back(const T& value);
+        void push_front(const T& value);
+        void pop_back();
+        void pop_front();
+        void clear();
+        void swap(SmallCircularList& other);
+
+        // Операторы сравнения
+        bool operator==(const SmallCircularList& other) const;
+        bool operator!=(const SmallCircularList& other) const;
+        bool operator<(const SmallCircularList& other) const;
+        bool operator>(const SmallCircularList& other) const;
+        bool operator<=(const SmallCircularList& other) const;
+        bool operator>=(const SmallCircularList& other) const;
+
+    private:
+        // Во встроенном режиме итератор хранит логический номер элемента,
+        // после переполнения - итератор CircularList
+        template <bool Const>
+        class basic_iterator {
+                using List = std::conditional_t<Const, const SmallCircularList,
+                                                SmallCircularList>;
+                using HeapIterator =
+                    std::conditional_t<Const,
+                                       typename CircularList<T>::const_iterator,
+                                       typename CircularList<T>::iterator>;
+
+                List* list;
+                size_t index;
+                mutable HeapIterator node;
+
+            public:
+                using iterator_category = std::bidirectional_iterator_tag;
+                using value_type = T;
+                using difference_type = std::ptrdiff_t;
+                using pointer = std::conditional_t<Const, const T*, T*>;
+                using reference = std::conditional_t<Const, const T&, T&>;
+                basic_iterator(List* l = nullptr, size_t i = 0,
+                               HeapIterator n = HeapIterator());
+                // Неконстантный итератор приводится к константному
+                template <bool OtherConst>
+                    requires(Const && !OtherConst)
+                basic_iterator(const basic_iterator<OtherConst>& other);
+                reference operator*() const;
+                basic_iterator& operator++();
+                basic_iterator& operator--();
+                bool operator==(const basic_iterator& other) const;
+                bool operator!=(const basic_iterator& other) const;
+                friend class SmallCircularList;
+                template <bool>
+                friend class basic_iterator;
+        };
+
+        template <bool Const>
+        class basic_segment_iterator {
+                using List = std::conditional_t<Const, const SmallCircularList,
+                                                SmallCircularList>;
+                using HeapSegmentIterator = std::conditional_t<
+                    Const, typename CircularList<T>::const_segment_iterator,
+                    typename CircularList<T>::segment_iterator>;
+                using Span = std::span<std::conditional_t<Const, const T, T>>;
+
+                List* list;
+                size_t part;  // 0 или 1 во встроенном режиме
+                HeapSegmentIterator node;
+
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using value_type = Span;
+                using difference_type = std::ptrdiff_t;
+                basic_segment_iterator(
+                    List* l = nullptr, size_t p = 0,
+                    HeapSegmentIterator n = HeapSegmentIterator());
+                Span operator*() const;
+                basic_segment_iterator& operator++();
+                basic_iterator<Const> to_iterator(size_t offset) const;
+                bool operator==(const basic_segment_iterator& other) const;
+                bool operator!=(const basic_segment_iterator& other) const;
+                friend class SmallCircularList;
+        };
+};
+
+// Встроенное кольцо
+template <typename T, size_t N>
+T* SmallCircularList<T, N>::slots() {
+    return std::launder(reinterpret_cast<T*>(storage));
+}
+
+template <typename T, size_t N>
+const T* SmallCircularList<T, N>::slots() const {
+    return std::launder(reinterpret_cast<const T*>(storage));
+}
+
+template <typename T, size_t N>
+T& SmallCircularList<T, N>::slot(size_t index) {
+    return slots()[(first + index) % N];
+}
+
+template <typename T, size_t N>
+const T& SmallCircularList<T, N>::slot(size_t index) const {
+    return slots()[(first + index) % N];
+}
+
+template <typename T, size_t N>
+size_t SmallCircularList<T, N>::first_run() const {
+    return std::min(count, N - first);
+}
+
+template <typename T, size_t N>
+void SmallCircularList<T, N>::destroy_inline() noexcept {
+    for (size_t i = 0; i < count; ++i) std::destroy_at(&slot(i));
+    first = 0;
+    count = 0;
+}
+
+template <typename T, size_t N>
+void SmallCircularList<T, N>::move_from(SmallCircularList& other) {
+    if (other.spilled) {
+        heap = std::move(other.heap);
+        spilled = true;
+        other.spilled = false;
+        return;
+    }
+    for (; count < other.count; ++count) {
+        ::new (static_cast<void*>(slots() + count))
+            T(std::move(other.slot(count)));
+    }
+    other.destroy_inline();
+}
+
+template <typename T, size_t N>
+void SmallCircularList<T, N>::spill_with(const T& value, bool at_front) {
+    // value может ссылаться на встроенный элемент, поэтому копируем всё
+    // во временный список до разрушения кольца
+    CircularList<T> moved;
+    for (size_t i = 0; i < count; ++i) moved.push_back(slot(i));
+    if (at_front) {
+        moved.push_front(value);
+    } else {
+        moved.push_back(value);
+    }
+    destroy_inline();
+    heap.swap(moved);
+    spilled = true;
+}
+
+// Конструкторы
+template <typename T, size_t N>
+SmallCircularList<T, N>::SmallCircularList()
+    : first(0), count(0), spilled(false) {
+}
+
+template <typename T, size_t N>
+SmallCircularList<T, N>::SmallCircularList(const SmallCircularList& other)
+    : first(0), count(0), spilled(other.spilled) {
+    if (spilled) {
+        heap = other.heap;
+        return;
+    }
+    try {
+        for (; count < other.count; ++count) {
+            ::new (static_cast<void*>(slots() + count)) T(other.slot(count));
+        }
+    } catch (...) {
+        destroy_inline();
+        throw;
+    }
+}
+
+template <typename T, size_t N>
+SmallCircularList<T, N>::SmallCircularList(SmallCircularList&& other) noexcept(
+    std::is_nothrow_move_constructible_v<T>)
+    : first(0), count(0), spilled(false) {
+    move_from(other);
+}
+
+template <typename T, size_t N>
+SmallCircularList<T, N>::~SmallCircularList() {
+    destroy_inline();
+}
+
+// Операторы присваивания
+template <typename T, size_t N>
+SmallCircularList<T, N>& SmallCircularList<T, N>::operator=(
+    const SmallCircularList& other) {
+    if (this != &other) {
+        SmallCircularList temp(other);
+        clear();
+        move_from(temp);
+    }
+    return *this;
+}
+
+template <typename T, size_t N>
+SmallCircularList<T, N>& SmallCircularList<T, N>::operator=(
+    SmallCircularList&& other) noexcept(
+    std::is_nothrow_move_constructible_v<T>) {
+    if (this != &other) {
+        clear();
+        move_from(other);
+    }
+    return *this;
+}
+
+// Итераторы
+template <typename T, size_t N>
+typename SmallCircularList<T, N>::iterator SmallCircularList<T, N>::begin() {
+    return spilled ? iterator(this, 0, heap.begin()) : iterator(this, 0);
+}
+
+template <typename T, size_t N>
+typename SmallCircularList<T, N>::iterator SmallCircularList<T, N>::end() {
+    return spilled ? iterator(this, 0, heap.end()) : iterator(this, count);
+}
+
+template <typename T, size_t N>
+typename SmallCircularList<T, N>::const_iterator
+SmallCircularList<T, N>::begin() const {
+    return spilled ? const_iterator(this, 0, heap.begin())
+                   : const_iterator(this, 0);
+}
+
+template <typename T, size_t N>
+typename SmallCircularList<T, N>::const_iterator SmallCircularList<T, N>::end()
+    const {
+    return spilled ? const_iterator(this, 0, heap.end())
+                   : const_iterator(this, count);
+}
+
+template <typename T, size_t N>
+typename SmallCircularList<T, N>::const_iterator
+SmallCircularList<T, N>::cbegin() const {
+    return begin();
+}
+
+template <typename T, size_t N>
+typename SmallCircularList<T, N>::const_iterator SmallCircularList<T, N>::cend()
+    const {
+    return end();
+}
+
+template <typename T, size_t N>
+typename SmallCircularList<T, N>::reverse_iterator
+SmallCircularList<T, N>::rbegin() {
+    return reverse_iterator(end());
+}
+
+template <typename T, size_t N>
+typename SmallCircularList<T, N>::reverse_iterator
+SmallCircularList<T, N>::rend() {
+    return reverse_iterator(begin());
+}
+
+template <typename T, size_t N>
+typename SmallCircularList<T, N>::const_reverse_iterator
+SmallCircularList<T, N>::rbegin() const {
+    return const_reverse_iterator(end());
+}
+
+template <typename T, size_t N>
+typename SmallCircularList<T, N>::const_reverse_iterator
+SmallCircularList<T, N>::rend() const {
+    return const_reverse_iterator(begin());
+}
+
+template <typename T, size_t N>
+template <bool Const>
+SmallCircularList<T, N>::basic_iterator<Const>::basic_iterator(List* l,
+                                                               size_t i,
+                                                               HeapIterator n)
+    : list(l), index(i), node(n) {
+}
+
+template <typename T, size_t N>
+template <bool Const>
+template <bool OtherConst>
+    requires(Const && !OtherConst)
+SmallCircularList<T, N>::basic_iterator<Const>::basic_iterator(
+    const basic_iterator<OtherConst>& other)
+    : list(other.list), index(other.index), node(other.node) {
+}
+
+template <typename T, size_t N>
+template <bool Const>
+typename SmallCircularList<T, N>::template basic_iterator<Const>::reference
+SmallCircularList<T, N>::basic_iterator<Const>::operator*() const {
+    if (list->spilled) return *node;
+    if (index >= list->count)
+        throw std::out_of_range(
+            "SmallCircularList::iterator::operator*: dereferencing end "
+            "iterator");
+    return list->slot(index);
+}
+
+template <typename T, size_t N>
+template <bool Const>
+typename SmallCircularList<T, N>::template basic_iterator<Const>&
+SmallCircularList<T, N>::basic_iterator<Const>::operator++() {
+    if (list->spilled) {
+        ++node;
+        return *this;
+    }
+    if (index >= list->count)
+        throw std::out_of_range(
+            "SmallCircularList::iterator::operator++: incrementing end "
+            "iterator");
+    ++index;
+    return *this;
+}
+
+template <typename T, size_t N>
+template <bool Const>
+typename SmallCircularList<T, N>::template basic_iterator<Const>&
+SmallCircularList<T, N>::basic_iterator<Const>::operator--() {
+    if (list->spilled) {
+        --node;
+        return *this;
+    }
+    if (list->count == 0)
+        throw std::out_of_range(
+            "SmallCircularList::iterator::operator--: empty list");
+    index = index == 0 ? list->count - 1 : index - 1;
+    return *this;
+}
+
+template <typename T, size_t N>
+template <bool Const>
+bool SmallCircularList<T, N>::basic_iterator<Const>::operator==(
+    const basic_iterator& other) const {
+    return index == other.index && node == other.node;
+}
+
+template <typename T, size_t N>
+template <bool Const>
+bool SmallCircularList<T, N>::basic_iterator<Const>::operator!=(
+    const basic_iterator& other) const {
+    return !(*this == other);
+}
+
+// Сегментный обход
+template <typename T, size_t N>
+typename SmallCircularList<T, N>::segment_iterator
+SmallCircularList<T, N>::segment_begin() {
+    return spilled ? segment_iterator(this, 0, heap.segment_begin())
+                   : segment_iterator(this, 0);
+}
+
+template <typename T, size_t N>
+typename SmallCircularList<T, N>::segment_iterator
+SmallCircularList<T, N>::segment_end() {
+    if (spilled) return segment_iterator(this, 0, heap.segment_end());
+    return segment_iterator(this, count == 0 ? 0 : count > N - first ? 2 : 1);
+}
+
+template <typename T, size_t N>
+typename SmallCircularList<T, N>::const_segment_iterator
+SmallCircularList<T, N>::segment_begin() const {
+    return spilled ? const_segment_iterator(this, 0, heap.segment_begin())
+                   : const_segment_iterator(this, 0);
+}
+
+template <typename T, size_t N>
+typename SmallCircularList<T, N>::const_segment_iterator
+SmallCircularList<T, N>::segment_end() const {
+    if (spilled) return const_segment_iterator(this, 0, heap.segment_end());
+    return const_segment_iterator(this,
+                                  count == 0 ? 0 : count > N - first ? 2 : 1);
+}
+
+template <typename T, size_t N>
+template <typename F>
+void SmallCircularList<T, N>::for_each_segment(F f) {
+    if (spilled) {
+        heap.for_each_segment(f);
+        return;
+    }
+    for (auto seg = segment_begin(); seg != segment_end(); ++seg) {
+        if constexpr (std::is_same_v<std::invoke_result_t<F&, std::span<T>>,
+                                     bool>) {
+            if (!f(*seg)) return;
+        } else {
+            f(*seg);
+        }
+    }
+}
+
+template <typename T, size_t N>
+template <typename F>
+void SmallCircularList<T, N>::for_each_segment(F f) const {
+    if (spilled) {
+        heap.for_each_segment(f);
+        return;
+    }
+    for (auto seg = segment_begin(); seg != segment_end(); ++seg) {
+        if constexpr (std::is_same_v<
+                          std::invoke_result_t<F&, std::span<const T>>, bool>) {
+            if (!f(*seg)) return;
+        } else {
+            f(*seg);
+        }
+    }
+}
+
+template <typename T, size_t N>
+template <bool Const>
+SmallCircularList<T, N>::basic_segment_iterator<Const>::basic_segment_iterator(
+    List* l, size_t p, HeapSegmentIterator n)
+    : list(l), part(p), node(n) {
+}
+
+template <typename T, size_t N>
+template <bool Const>
+typename SmallCircularList<T, N>::template basic_segment_iterator<Const>::Span
+SmallCircularList<T, N>::basic_segment_iterator<Const>::operator*() const {
+    if (list->spilled) return *node;
+    if (*this == list->segment_end())
+        throw std::out_of_range(
+            "SmallCircularList::segment_iterator::operator*: dereferencing "
+            "end iterator");
+    size_t run = list->first_run();
+    if (part == 0) return Span(list->slots() + list->first, run);
+    return Span(list->slots(), list->count - run);
+}
+
+template <typename T, size_t N>
+template <bool Const>
+typename SmallCircularList<T, N>::template basic_segment_iterator<Const>&
+SmallCircularList<T, N>::basic_segment_iterator<Const>::operator++() {
+    if (list->spilled) {
+        ++node;
+        return *this;
+    }
+    if (*this == list->segment_end())
+        throw std::out_of_range(
+            "SmallCircularList::segment_iterator::operator++: incrementing "
+            "end iterator");
+    ++part;
+    return *this;
+}
+
+template <typename T, size_t N>
+template <bool Const>
+typename SmallCircularList<T, N>::template basic_iterator<Const>
+SmallCircularList<T, N>::basic_segment_iterator<Const>::to_iterator(
+    size_t offset) const {
+    if (list->spilled) {
+        return basic_iterator<Const>(list, 0, node.to_iterator(offset));
+    }
+    if (offset >= (**this).size())
+        throw std::out_of_range(
+            "SmallCircularList::segment_iterator::to_iterator: offset out of "
+            "segment");
+    return basic_iterator<Const>(
+        list, (part == 0 ? 0 : list->first_run()) + offset);
+}
+
+template <typename T, size_t N>
+template <bool Const>
+bool SmallCircularList<T, N>::basic_segment_iterator<Const>::operator==(
+    const basic_segment_iterator& other) const {
+    return part == other.part && node == other.node;
+}
+
+template <typename T, size_t N>
+template <bool Const>
+bool SmallCircularList<T, N>::basic_segment_iterator<Const>::operator!=(
+    const basic_segment_iterator& other) const {
+    return !(*this == other);
+}
+
+// Размер и проверка на пустоту
+template <typename T, size_t N>
+size_t SmallCircularList<T, N>::size() const {
+    return spilled ? heap.size() : count;
+}
+
+template <typename T, size_t N>
+bool SmallCircularList<T, N>::empty() const {
+    return size() == 0;
+}
+
+template <typename T, size_t N>
+bool SmallCircularList<T, N>::is_inline() const {
+    return !spilled;
+}
+
+// Доступ к элементам
+template <typename T, size_t N>
+T& SmallCircularList<T, N>::front() {
+    if (spilled) return heap.front();
+    if (empty())
+        throw std::out_of_range("SmallCircularList::front: empty list");
+    return slot(0);
+}
+
+template <typename T, size_t N>
+const T& SmallCircularList<T, N>::front() const {
+    if (spilled) return heap.front();
+    if (empty())
+        throw std::out_of_range("SmallCircularList::front: empty list");
+    return slot(0);
+}
+
+template <typename T, size_t N>
+T& SmallCircularList<T, N>::back() {
+    if (spilled) return heap.back();
+    if (empty()) throw std::out_of_range("SmallCircularList::back: empty list");
+    return slot(count - 1);
+}
+
+template <typename T, size_t N>
+const T& SmallCircularList<T, N>::back() const {
+    if (spilled) return heap.back();
+    if (empty()) throw std::out_of_range("SmallCircularList::back: empty list");
+    return slot(count - 1);
+}
+
+// Модификаторы
+template <typename T, size_t N>
+void SmallCircularList<T, N>::push_back(const T& value) {
+    if (spilled) {
+        heap.push_back(value);
+    } else if (count == N) {
+        spill_with(value, false);
+    } else {
+        ::new (static_cast<void*>(&slots()[(first + count) % N])) T(value);
+        ++count;
+    }
+}
+
+template <typename T, size_t N>
+void SmallCircularList<T, N>::push_front(const T& value) {
+    if (spilled) {
+        heap.push_front(value);
+    } else if (count == N) {
+        spill_with(value, true);
+    } else {
+        size_t index = (first + N - 1) % N;
+        ::new (static_cast<void*>(&slots()[index])) T(value);
+        first = index;
+        ++count;
+    }
+}
+
+template <typename T, size_t N>
+void SmallCircularList<T, N>::pop_back() {
+    if (spilled) {
+        heap.pop_back();
+        spilled = !heap.empty();
+        return;
+    }
+    if (empty())
+        throw std::out_of_range("SmallCircularList::pop_back: empty list");
+    std::destroy_at(&slot(count - 1));
+    --count;
+}
+
+template <typename T, size_t N>
+void SmallCircularList<T, N>::pop_front() {
+    if (spilled) {
+        heap.pop_front();
+        spilled = !heap.empty();
+        return;
+    }
+    if (empty())
+        throw std::out_of_range("SmallCircularList::pop_front: empty list");
+    std::destroy_at(&slot(0));
+    first = (first + 1) % N;
+    --count;
+}
+
+template <typename T, size_t N>
+void SmallCircularList<T, N>::clear() {
+    destroy_inline();
+    heap.clear();
+    spilled = false;
+}
+
+template <typename T, size_t N>
+void SmallCircularList<T, N>::swap(SmallCircularList& other) {
+    SmallCircularList temp(std::move(other));
+    other = std::move(*this);
+    *this = std::move(temp);
+}
+
+// Операторы сравнения
+template <typename T, size_t N>
+bool SmallCircularList<T, N>::operator==(const SmallCircularList& other) const {
+    if (size() != other.size()) return false;
+    auto it = other.begin();
+    bool equal = true;
+    for_each_segment([&](std::span<const T> segment) {
+        for (const T& value : segment) {
+            if (value != *it) {
+                equal = false;
+                return false;
+            }
+            ++it;
+        }
+        return true;
+    });
+    return equal;
+}
+
+template <typename T, size_t N>
+bool SmallCircularList<T, N>::operator!=(const SmallCircularList& other) const {
+    return !(*this == other);
+}
+
+template <typename T, size_t N>
+bool SmallCircularList<T, N>::operator<(const SmallCircularList& other) const {
+    return std::lexicographical_compare(begin(), end(), other.begin(),
+                                        other.end());
+}
+
+template <typename T, size_t N>
+bool SmallCircularList<T, N>::operator>(const SmallCircularList& other) const {
+    return other < *this;
+}
+
+template <typename T, size_t N>
+bool SmallCircularList<T, N>::operator<=(const SmallCircularList& other) const {
+    return !(other < *this);
+}
+
+template <typename T, size_t N>
+bool SmallCircularList<T, N>::operator>=(const SmallCircularList& other) const {
+    return !(*this < other);
+}
+
+#endif
@@ -0,0 +1,552 @@
+#ifndef SOA_CIRCULAR_LIST_H
+#define SOA_CIRCULAR_LIST_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <deque>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// Кольцевой список записей из полей Fields..., хранящий каждое поле своим
+// столбцом ("структура массивов"). Столбцы разбиты на блоки по kChunkSize
+// значений; блоки образуют двустороннюю очередь, поэтому вставка и
+// удаление с обоих концов - O(1), а порядок кольца совпадает с порядком
+// значений в блоках. for_each_segment<I> отдаёт столбец I непрерывными
+// std::span, и цикл по такому участку компилятор может векторизовать.
+//
+// Поля должны быть тривиально копируемыми и конструируемыми по умолчанию:
+// блоки создаются целиком, а значения копируются без конструкторов.
+// Ссылки на значения действительны до удаления элемента или его блока;
+// вставка на концах их не затрагивает.
+template <typename... Fields>
+class SoaCircularList {
+        static_assert(sizeof...(Fields) > 0,
+                      "SoaCircularList: at least one field is required");
+        static_assert((std::is_trivially_copyable_v<Fields> && ...),
+                      "SoaCircularList: fields must be trivially copyable");
+        static_assert((std::is_default_constructible_v<Fields> && ...),
+                      "SoaCircularList: fields must be default constructible");
+
+    public:
+        using value_type = std::tuple<Fields...>;
+        template <size_t I>
+        using field_type = std::tuple_element_t<I, value_type>;
+
+        // Число значений каждого поля в одном блоке
+        static constexpr size_t kChunkSize = 256;
+
+    private:
+        struct Chunk {
+                std::tuple<std::array<Fields, kChunkSize>...> columns;
+        };
+
+        std::deque<std::unique_ptr<Chunk>> chunks;
+        // Освобождённый блок, который используется повторно, чтобы
+        // чередование вставок и удалений на границе блока не обращалось к
+        // куче
+        std::unique_ptr<Chunk> spare;
+        size_t first;  // позиция первого элемента в chunks.front()
+        size_t count;
+
+        std::unique_ptr<Chunk> take_chunk();
+        void drop_chunk(std::unique_ptr<Chunk> chunk) noexcept;
+        void write(size_t position, const Fields&... values);
+        template <size_t... I>
+        void write(size_t position, std::index_sequence<I...>,
+                   const Fields&... values);
+        template <size_t... I>
+        value_type read(size_t position, std::index_sequence<I...>) const;
+        template <size_t I, typename List, typename F>
+        static void visit_segments(List& list, F& f);
+        void check_index(size_t index, const char* message) const;
+
+    public:
+        class const_iterator;
+        using iterator = const_iterator;
+
+        // Конструкторы
+        SoaCircularList();
+        SoaCircularList(const SoaCircularList& other);
+        SoaCircularList(SoaCircularList&& other) noexcept;
+
+        // Операторы присваивания
+        SoaCircularList& operator=(const SoaCircularList& other);
+        SoaCircularList& operator=(SoaCircularList&& other) noexcept;
+
+        // Итераторы по записям; разыменование возвращает копию записи
+        const_iterator begin() const;
+        const_iterator end() const;
+        const_iterator cbegin() const;
+        const_iterator cend() const;
+
+        // Сегментный обход столбца I: f принимает std::span<field_type<I>>;
+        // если f возвращает bool, false прекращает обход
+        template <size_t I, typename F>
+        void for_each_segment(F f);
+        template <size_t I, typename F>
+        void for_each_segment(F f) const;
+
+        // Обход по записям: f принимает ссылки на все поля элемента
+        template <typename F>
+        void for_each(F f);
+        template <typename F>
+        void for_each(F f) const;
+
+        // Размер и проверка на пустоту
+        size_t size() const;
+        bool empty() const;
+
+        // Доступ к элементам
+        value_type front() const;
+        value_type back() const;
+        value_type operator[](size_t index) const;
+        // Поле I элемента index
+        template <size_t I>
+        field_type<I>& get(size_t index);
+        template <size_t I>
+        const field_type<I>& get(size_t index) const;
+
+        // Модификаторы
+        void push_back(const Fields&... values);
+        void push_front(const Fields&... values);
+        void pop_back();
+        void pop_front();
+        void clear();
+        void set(size_t index, const Fields&... values);
+        // Сдвиг начала кольца на n позиций вперёд (назад при n < 0):
+        // меньшая из двух частей переносится на противоположный конец
+        void rotate(std::ptrdiff_t n);
+        void swap(SoaCircularList& other) noexcept;
+
+        // Операторы сравнения (по записям в порядке кольца)
+        bool operator==(const SoaCircularList& other) const;
+        bool operator!=(const SoaCircularList& other) const;
+        bool operator<(const SoaCircularList& other) const;
+        bool operator>(const SoaCircularList& other) const;
+        bool operator<=(const SoaCircularList& other) const;
+        bool operator>=(const SoaCircularList& other) const;
+
+        class const_iterator {
+                const SoaCircularList* list;
+                size_t index;
+
+            public:
+                using iterator_category = std::bidirectional_iterator_tag;
+                using value_type = std::tuple<Fields...>;
+                using difference_type = std::ptrdiff_t;
+                using pointer = void;
+                using reference = value_type;
+                const_iterator(const SoaCircularList* l = nullptr,
+                               size_t i = 0);
+                value_type operator*() const;
+                const_iterator& operator++();
+                const_iterator& operator--();
+                bool operator==(const const_iterator& other) const;
+                bool operator!=(const const_iterator& other) const;
+                friend class SoaCircularList;
+        };
+};
+
+// Управление блоками
+template <typename... Fields>
+std::unique_ptr<typename SoaCircularList<Fields...>::Chunk>
+SoaCircularList<Fields...>::take_chunk() {
+    if (spare) return std::move(spare);
+    return std::make_unique<Chunk>();
+}
+
+template <typename... Fields>
+void SoaCircularList<Fields...>::drop_chunk(
+    std::unique_ptr<Chunk> chunk) noexcept {
+    if (!spare) spare = std::move(chunk);
+}
+
+template <typename... Fields>
+void SoaCircularList<Fields...>::write(size_t position,
+                                       const Fields&... values) {
+    write(position, std::index_sequence_for<Fields...>(), values...);
+}
+
+template <typename... Fields>
+template <size_t... I>
+void SoaCircularList<Fields...>::write(size_t position,
+                                       std::index_sequence<I...>,
+                                       const Fields&... values) {
+    Chunk& chunk = *chunks[position / kChunkSize];
+    size_t offset = position % kChunkSize;
+    ((std::get<I>(chunk.columns)[offset] = values), ...);
+}
+
+template <typename... Fields>
+template <size_t... I>
+typename SoaCircularList<Fields...>::value_type
+SoaCircularList<Fields...>::read(size_t position,
+                                 std::index_sequence<I...>) const {
+    const Chunk& chunk = *chunks[position / kChunkSize];
+    size_t offset = position % kChunkSize;
+    return value_type(std::get<I>(chunk.columns)[offset]...);
+}
+
+template <typename... Fields>
+void SoaCircularList<Fields...>::check_index(size_t index,
+                                             const char* message) const {
+    if (index >= count) throw std::out_of_range(message);
+}
+
+// Конструкторы
+template <typename... Fields>
+SoaCircularList<Fields...>::SoaCircularList() : first(0), count(0) {
+}
+
+template <typename... Fields>
+SoaCircularList<Fields...>::SoaCircularList(const SoaCircularList& other)
+    : first(other.first), count(other.count) {
+    for (const auto& chunk : other.chunks)
+        chunks.push_back(std::make_unique<Chunk>(*chunk));
+}
+
+template <typename... Fields>
+SoaCircularList<Fields...>::SoaCircularList(SoaCircularList&& other) noexcept
+    : chunks(std::move(other.chunks)), spare(std::move(other.spare)),
+      first(other.first), count(other.count) {
+    other.chunks.clear();
+    other.first = 0;
+    other.count = 0;
+}
+
+// Операторы присваивания
+template <typename... Fields>
+SoaCircularList<Fields...>& SoaCircularList<Fields...>::operator=(
+    const SoaCircularList& other) {
+    if (this != &other) {
+        SoaCircularList temp(other);
+        swap(temp);
+    }
+    return *this;
+}
+
+template <typename... Fields>
+SoaCircularList<Fields...>& SoaCircularList<Fields...>::operator=(
+    SoaCircularList&& other) noexcept {
+    if (this != &other) {
+        SoaCircularList temp(std::move(other));
+        swap(temp);
+    }
+    return *this;
+}
+
+// Итераторы
+template <typename... Fields>
+typename SoaCircularList<Fields...>::const_iterator
+SoaCircularList<Fields...>::begin() const {
+    return const_iterator(this, 0);
+}
+
+template <typename... Fields>
+typename SoaCircularList<Fields...>::const_iterator
+SoaCircularList<Fields...>::end() const {
+    return const_iterator(this, count);
+}
+
+template <typename... Fields>
+typename SoaCircularList<Fields...>::const_iterator
+SoaCircularList<Fields...>::cbegin() const {
+    return begin();
+}
+
+template <typename... Fields>
+typename SoaCircularList<Fields...>::const_iterator
+SoaCircularList<Fields...>::cend() const {
+    return end();
+}
+
+template <typename... Fields>
+SoaCircularList<Fields...>::const_iterator::const_iterator(
+    const SoaCircularList* l, size_t i)
+    : list(l), index(i) {
+}
+
+template <typename... Fields>
+typename SoaCircularList<Fields...>::value_type
+SoaCircularList<Fields...>::const_iterator::operator*() const {
+    list->check_index(index,
+                      "SoaCircularList::const_iterator::operator*: "
+                      "dereferencing end iterator");
+    return (*list)[index];
+}
+
+template <typename... Fields>
+typename SoaCircularList<Fields...>::const_iterator&
+SoaCircularList<Fields...>::const_iterator::operator++() {
+    ++index;
+    return *this;
+}
+
+template <typename... Fields>
+typename SoaCircularList<Fields...>::const_iterator&
+SoaCircularList<Fields...>::const_iterator::operator--() {
+    --index;
+    return *this;
+}
+
+template <typename... Fields>
+bool SoaCircularList<Fields...>::const_iterator::operator==(
+    const const_iterator& other) const {
+    return index == other.index;
+}
+
+template <typename... Fields>
+bool SoaCircularList<Fields...>::const_iterator::operator!=(
+    const const_iterator& other) const {
+    return index != other.index;
+}
+
+// Сегментный обход
+template <typename... Fields>
+template <size_t I, typename List, typename F>
+void SoaCircularList<Fields...>::visit_segments(List& list, F& f) {
+    using Value = std::conditional_t<std::is_const_v<List>,
+                                     const field_type<I>, field_type<I>>;
+    using Span = std::span<Value>;
+    size_t begin = list.first;
+    size_t left = list.count;
+    for (size_t c = 0; left > 0; ++c) {
+        size_t length = std::min(kChunkSize - begin, left);
+        Span segment(std::get<I>(list.chunks[c]->columns).data() + begin,
+                     length);
+        if constexpr (std::is_same_v<std::invoke_result_t<F&, Span>, bool>) {
+            if (!f(segment)) return;
+        } else {
+            f(segment);
+        }
+        left -= length;
+        begin = 0;
+    }
+}
+
+template <typename... Fields>
+template <size_t I, typename F>
+void SoaCircularList<Fields...>::for_each_segment(F f) {
+    visit_segments<I>(*this, f);
+}
+
+template <typename... Fields>
+template <size_t I, typename F>
+void SoaCircularList<Fields...>::for_each_segment(F f) const {
+    visit_segments<I>(*this, f);
+}
+
+template <typename... Fields>
+template <typename F>
+void SoaCircularList<Fields...>::for_each(F f) {
+    for (size_t i = 0; i < count; ++i) {
+        Chunk& chunk = *chunks[(first + i) / kChunkSize];
+        size_t offset = (first + i) % kChunkSize;
+        std::apply([&](auto&... column) { f(column[offset]...); },
+                   chunk.columns);
+    }
+}
+
+template <typename... Fields>
+template <typename F>
+void SoaCircularList<Fields...>::for_each(F f) const {
+    for (size_t i = 0; i < count; ++i) {
+        const Chunk& chunk = *chunks[(first + i) / kChunkSize];
+        size_t offset = (first + i) % kChunkSize;
+        std::apply([&](const auto&... column) { f(column[offset]...); },
+                   chunk.columns);
+    }
+}
+
+// Размер и проверка на пустоту
+template <typename... Fields>
+size_t SoaCircularList<Fields...>::size() const {
+    return count;
+}
+
+template <typename... Fields>
+bool SoaCircularList<Fields...>::empty() const {
+    return count == 0;
+}
+
+// Доступ к элементам
+template <typename... Fields>
+typename SoaCircularList<Fields...>::value_type
+SoaCircularList<Fields...>::front() const {
+    if (empty()) throw std::out_of_range("SoaCircularList::front: empty list");
+    return (*this)[0];
+}
+
+template <typename... Fields>
+typename SoaCircularList<Fields...>::value_type
+SoaCircularList<Fields...>::back() const {
+    if (empty()) throw std::out_of_range("SoaCircularList::back: empty list");
+    return (*this)[count - 1];
+}
+
+template <typename... Fields>
+typename SoaCircularList<Fields...>::value_type
+SoaCircularList<Fields...>::operator[](size_t index) const {
+    check_index(index, "SoaCircularList::operator[]: bad index");
+    return read(first + index, std::index_sequence_for<Fields...>());
+}
+
+template <typename... Fields>
+template <size_t I>
+typename SoaCircularList<Fields...>::template field_type<I>&
+SoaCircularList<Fields...>::get(size_t index) {
+    check_index(index, "SoaCircularList::get: bad index");
+    size_t position = first + index;
+    return std::get<I>(
+        chunks[position / kChunkSize]->columns)[position % kChunkSize];
+}
+
+template <typename... Fields>
+template <size_t I>
+const typename SoaCircularList<Fields...>::template field_type<I>&
+SoaCircularList<Fields...>::get(size_t index) const {
+    check_index(index, "SoaCircularList::get: bad index");
+    size_t position = first + index;
+    return std::get<I>(
+        chunks[position / kChunkSize]->columns)[position % kChunkSize];
+}
+
+// Модификаторы
+template <typename... Fields>
+void SoaCircularList<Fields...>::push_back(const Fields&... values) {
+    size_t position = first + count;
+    if (position / kChunkSize == chunks.size()) {
+        auto chunk = take_chunk();
+        chunks.push_back(std::move(chunk));
+    }
+    write(position, values...);
+    ++count;
+}
+
+template <typename... Fields>
+void SoaCircularList<Fields...>::push_front(const Fields&... values) {
+    if (first == 0) {
+        auto chunk = take_chunk();
+        chunks.push_front(std::move(chunk));
+        first = kChunkSize;
+    }
+    --first;
+    write(first, values...);
+    ++count;
+}
+
+template <typename... Fields>
+void SoaCircularList<Fields...>::pop_back() {
+    if (empty())
+        throw std::out_of_range("SoaCircularList::pop_back: empty list");
+    --count;
+    if ((first + count) % kChunkSize == 0) {
+        drop_chunk(std::move(chunks.back()));
+        chunks.pop_back();
+    }
+    if (count == 0) clear();
+}
+
+template <typename... Fields>
+void SoaCircularList<Fields...>::pop_front() {
+    if (empty())
+        throw std::out_of_range("SoaCircularList::pop_front: empty list");
+    --count;
+    if (++first == kChunkSize) {
+        drop_chunk(std::move(chunks.front()));
+        chunks.pop_front();
+        first = 0;
+    }
+    if (count == 0) clear();
+}
+
+template <typename... Fields>
+void SoaCircularList<Fields...>::clear() {
+    if (!chunks.empty()) drop_chunk(std::move(chunks.front()));
+    chunks.clear();
+    first = 0;
+    count = 0;
+}
+
+template <typename... Fields>
+void SoaCircularList<Fields...>::set(size_t index, const Fields&... values) {
+    check_index(index, "SoaCircularList::set: bad index");
+    write(first + index, values...);
+}
+
+template <typename... Fields>
+void SoaCircularList<Fields...>::rotate(std::ptrdiff_t n) {
+    if (count < 2) return;
+    auto size = static_cast<std::ptrdiff_t>(count);
+    std::ptrdiff_t steps = n % size;
+    if (steps < 0) steps += size;
+    if (steps <= size / 2) {
+        for (std::ptrdiff_t i = 0; i < steps; ++i) {
+            value_type value = front();
+            pop_front();
+            std::apply([this](const Fields&... v) { push_back(v...); },
+                       value);
+        }
+    } else {
+        for (std::ptrdiff_t i = steps; i < size; ++i) {
+            value_type value = back();
+            pop_back();
+            std::apply([this](const Fields&... v) { push_front(v...); },
+                       value);
+        }
+    }
+}
+
+template <typename... Fields>
+void SoaCircularList<Fields...>::swap(SoaCircularList& other) noexcept {
+    chunks.swap(other.chunks);
+    spare.swap(other.spare);
+    std::swap(first, other.first);
+    std::swap(count, other.count);
+}
+
+// Операторы сравнения
+template <typename... Fields>
+bool SoaCircularList<Fields...>::operator==(
+    const SoaCircularList& other) const {
+    return size() == other.size() && std::equal(begin(), end(), other.begin());
+}
+
+template <typename... Fields>
+bool SoaCircularList<Fields...>::operator!=(
+    const SoaCircularList& other) const {
+    return !(*this == other);
+}
+
+template <typename... Fields>
+bool SoaCircularList<Fields...>::operator<(
+    const SoaCircularList& other) const {
+    return std::lexicographical_compare(begin(), end(), other.begin(),
+                                        other.end());
+}
+
+template <typename... Fields>
+bool SoaCircularList<Fields...>::operator>(
+    const SoaCircularList& other) const {
+    return other < *this;
+}
+
+template <typename... Fields>
+bool SoaCircularList<Fields...>::operator<=(
+    const SoaCircularList& other) const {
+    return !(other < *this);
+}
+
+template <typename... Fields>
+bool SoaCircularList<Fields...>::operator>=(
+    const SoaCircularList& other) const {
+    return !(*this < other);
+}
+
+#endif
@@ -0,0 +1,392 @@
+#ifndef SPILL_CIRCULAR_LIST_H
+#define SPILL_CIRCULAR_LIST_H
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <deque>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Счётчики обмена SpillCircularList с диском
+struct SpillStats {
+        size_t spilled_bytes = 0;    // записано в сегменты
+        size_t read_back_bytes = 0;  // прочитано из сегментов
+        size_t segments = 0;         // созданные файлы сегментов
+        double spill_seconds = 0;
+        double read_back_seconds = 0;
+
+        // Байт в секунду; 0, пока обмена не было
+        double spill_bandwidth() const;
+        double read_back_bandwidth() const;
+};
+
+inline double SpillStats::spill_bandwidth() const {
+    return spill_seconds > 0 ? double(spilled_bytes) / spill_seconds : 0;
+}
+
+inline double SpillStats::read_back_bandwidth() const {
+    return read_back_seconds > 0 ? double(read_back_bytes) / read_back_seconds
+                                 : 0;
+}
+
+// Очередь с вытеснением середины на диск. Голова (начало очереди) и хвост
+// (последние добавленные значения) лежат в памяти, в непрерывных буферах
+// не больше memory_budget байт на двоих; когда хвост заполняется, старшая
+// его половина дописывается в конец последнего файла-сегмента. Когда
+// голова исчерпана, она заполняется последовательным чтением из первого
+// сегмента, а ядру заранее подсказывается (posix_fadvise) следующий
+// участок файла, чтобы чтение шло из страничного кэша.
+//
+// Пока очередь помещается в бюджет, диск не используется вовсе. Файлы
+// сегментов удаляются из каталога сразу после создания: место на диске
+// освобождается при закрытии сегмента, в том числе при аварийном
+// завершении процесса. Сегмент закрывается, как только прочитан целиком.
+//
+// Значения пишутся на диск побайтно, поэтому T должен быть тривиально
+// копируемым. Поддерживается только порядок FIFO: push_back и pop_front.
+// Ошибки ввода-вывода бросают std::system_error.
+template <typename T>
+class SpillCircularList {
+        static_assert(std::is_trivially_copyable_v<T> &&
+                          std::is_default_constructible_v<T>,
+                      "SpillCircularList: T must be trivially copyable");
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct Segment {
+                int fd;
+                size_t written;  // значения в файле
+                size_t read;     // уже прочитанные из них
+        };
+
+        std::string directory;
+        size_t capacity;  // наибольшее число значений в голове и в хвосте
+        size_t segment_elements;
+        size_t read_ahead_bytes;
+        std::vector<T> head;  // начало очереди - head[head_pos..]
+        size_t head_pos;
+        std::deque<Segment> segments;
+        size_t spilled;  // значения в сегментах
+        std::vector<T> tail;
+        SpillStats counters;
+
+        static void write_all(int fd, const T* data, size_t n, size_t offset);
+        static void read_all(int fd, T* data, size_t n, size_t offset);
+        void open_segment();
+        void close_segments();
+        // Запись старшей половины хвоста в последний сегмент
+        void spill();
+        // Замена головы из одного последнего значения следующей порцией из
+        // первого сегмента или хвостом; при ошибке чтения очередь не
+        // меняется
+        void refill();
+
+    public:
+        using value_type = T;
+
+        static constexpr size_t default_segment_bytes = size_t(64) << 20;
+        static constexpr size_t default_read_ahead_bytes = size_t(1) << 20;
+
+        // memory_budget - байты под голову и хвост, не меньше 4 * sizeof(T);
+        // directory - каталог файлов сегментов; сегмент закрывается для
+        // записи, набрав segment_bytes; read_ahead_bytes - объём
+        // упреждающего чтения за головой
+        explicit SpillCircularList(
+            size_t memory_budget, std::string directory = "/tmp",
+            size_t segment_bytes = default_segment_bytes,
+            size_t read_ahead_bytes = default_read_ahead_bytes);
+        SpillCircularList(const SpillCircularList&) = delete;
+        SpillCircularList(SpillCircularList&& other) noexcept;
+        ~SpillCircularList();
+
+        SpillCircularList& operator=(const SpillCircularList&) = delete;
+        SpillCircularList& operator=(SpillCircularList&& other) noexcept;
+
+        // Размер и проверка на пустоту
+        size_t size() const;
+        bool empty() const;
+        // Значения на диске и в памяти
+        size_t spilled_size() const;
+        size_t memory_size() const;
+        const SpillStats& stats() const;
+
+        // Доступ к элементам
+        const T& front() const;
+        const T& back() const;
+
+        // Модификаторы
+        void push_back(const T& value);
+        void pop_front();
+        void clear();
+        void swap(SpillCircularList& other) noexcept;
+};
+
+// Сегменты
+template <typename T>
+void SpillCircularList<T>::write_all(int fd, const T* data, size_t n,
+                                     size_t offset) {
+    const char* bytes = reinterpret_cast<const char*>(data);
+    size_t left = n * sizeof(T);
+    offset *= sizeof(T);
+    while (left > 0) {
+        ssize_t done = ::pwrite(fd, bytes, left, off_t(offset));
+        if (done < 0) {
+            if (errno == EINTR) continue;
+            throw std::system_error(errno, std::generic_category(),
+                                    "SpillCircularList: segment write");
+        }
+        bytes += done;
+        left -= size_t(done);
+        offset += size_t(done);
+    }
+}
+
+template <typename T>
+void SpillCircularList<T>::read_all(int fd, T* data, size_t n, size_t offset) {
+    char* bytes = reinterpret_cast<char*>(data);
+    size_t left = n * sizeof(T);
+    offset *= sizeof(T);
+    while (left > 0) {
+        ssize_t done = ::pread(fd, bytes, left, off_t(offset));
+        if (done < 0 && errno == EINTR) continue;
+        if (done <= 0)
+            throw std::system_error(done < 0 ? errno : EIO,
+                                    std::generic_category(),
+                                    "SpillCircularList: segment read");
+        bytes += done;
+        left -= size_t(done);
+        offset += size_t(done);
+    }
+}
+
+template <typename T>
+void SpillCircularList<T>::open_segment() {
+    std::string path = directory + "/spill-XXXXXX";
+    // O_CLOEXEC: порождённые процессы не держат удалённые сегменты
+    int fd = ::mkostemp(path.data(), O_CLOEXEC);
+    if (fd < 0)
+        throw std::system_error(errno, std::generic_category(),
+                                "SpillCircularList: cannot create segment in " +
+                                    directory);
+    ::unlink(path.c_str());
+    ::posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    try {
+        segments.push_back(Segment{fd, 0, 0});
+    } catch (...) {
+        ::close(fd);
+        throw;
+    }
+    ++counters.segments;
+}
+
+template <typename T>
+void SpillCircularList<T>::close_segments() {
+    for (const Segment& segment : segments) ::close(segment.fd);
+    segments.clear();
+    spilled = 0;
+}
+
+template <typename T>
+void SpillCircularList<T>::spill() {
+    size_t n = capacity / 2;
+    if (segments.empty() || segments.back().written >= segment_elements)
+        open_segment();
+    Segment& segment = segments.back();
+    auto start = Clock::now();
+    write_all(segment.fd, tail.data(), n, segment.written);
+    counters.spill_seconds +=
+        std::chrono::duration<double>(Clock::now() - start).count();
+    counters.spilled_bytes += n * sizeof(T);
+    segment.written += n;
+    spilled += n;
+    tail.erase(tail.begin(), tail.begin() + std::ptrdiff_t(n));
+}
+
+template <typename T>
+void SpillCircularList<T>::refill() {
+    if (spilled == 0) {
+        head.clear();
+        head_pos = 0;
+        head.swap(tail);
+        return;
+    }
+    Segment& segment = segments.front();
+    size_t n = std::min(capacity, segment.written - segment.read);
+    // Чтение идёт поверх снятых значений головы; последнее живое
+    // сохраняется, чтобы вернуть его при ошибке
+    T last = head[head_pos];
+    size_t old_size = head.size();
+    head.resize(std::max(n, old_size));
+    auto start = Clock::now();
+    try {
+        read_all(segment.fd, head.data(), n, segment.read);
+    } catch (...) {
+        head.resize(old_size);
+        head[head_pos] = last;
+        throw;
+    }
+    head.resize(n);
+    head_pos = 0;
+    counters.read_back_seconds +=
+        std::chrono::duration<double>(Clock::now() - start).count();
+    counters.read_back_bytes += n * sizeof(T);
+    segment.read += n;
+    spilled -= n;
+    if (segment.read == segment.written) {
+        ::close(segment.fd);
+        segments.pop_front();
+    }
+    // Следующая порция читается ядром, пока потребитель разбирает голову
+    if (!segments.empty()) {
+        const Segment& next = segments.front();
+        ::posix_fadvise(next.fd, off_t(next.read * sizeof(T)),
+                        off_t(read_ahead_bytes), POSIX_FADV_WILLNEED);
+    }
+}
+
+// Конструкторы
+template <typename T>
+SpillCircularList<T>::SpillCircularList(size_t memory_budget,
+                                        std::string directory,
+                                        size_t segment_bytes,
+                                        size_t read_ahead_bytes)
+    : directory(std::move(directory)),
+      capacity(memory_budget / (2 * sizeof(T))),
+      segment_elements(std::max<size_t>(segment_bytes / sizeof(T), 1)),
+      read_ahead_bytes(read_ahead_bytes), head_pos(0), spilled(0) {
+    if (capacity < 2)
+        throw std::invalid_argument(
+            "SpillCircularList: memory budget must hold 4 values");
+    head.reserve(capacity);
+    tail.reserve(capacity);
+}
+
+template <typename T>
+SpillCircularList<T>::SpillCircularList(SpillCircularList&& other) noexcept
+    : directory(std::move(other.directory)), capacity(other.capacity),
+      segment_elements(other.segment_elements),
+      read_ahead_bytes(other.read_ahead_bytes), head(std::move(other.head)),
+      head_pos(other.head_pos), segments(std::move(other.segments)),
+      spilled(other.spilled), tail(std::move(other.tail)),
+      counters(other.counters) {
+    other.head.clear();
+    other.head_pos = 0;
+    other.segments.clear();
+    other.spilled = 0;
+    other.tail.clear();
+}
+
+template <typename T>
+SpillCircularList<T>::~SpillCircularList() {
+    close_segments();
+}
+
+// Операторы присваивания
+template <typename T>
+SpillCircularList<T>& SpillCircularList<T>::operator=(
+    SpillCircularList&& other) noexcept {
+    if (this != &other) {
+        SpillCircularList temp(std::move(other));
+        swap(temp);
+    }
+    return *this;
+}
+
+// Размер и проверка на пустоту
+template <typename T>
+size_t SpillCircularList<T>::size() const {
+    return memory_size() + spilled;
+}
+
+template <typename T>
+bool SpillCircularList<T>::empty() const {
+    return size() == 0;
+}
+
+template <typename T>
+size_t SpillCircularList<T>::spilled_size() const {
+    return spilled;
+}
+
+template <typename T>
+size_t SpillCircularList<T>::memory_size() const {
+    return head.size() - head_pos + tail.size();
+}
+
+template <typename T>
+const SpillStats& SpillCircularList<T>::stats() const {
+    return counters;
+}
+
+// Доступ к элементам
+template <typename T>
+const T& SpillCircularList<T>::front() const {
+    if (empty())
+        throw std::out_of_range("SpillCircularList::front: empty list");
+    return head[head_pos];
+}
+
+template <typename T>
+const T& SpillCircularList<T>::back() const {
+    if (empty())
+        throw std::out_of_range("SpillCircularList::back: empty list");
+    // После сброса на диск в хвосте всегда остаётся половина значений
+    return tail.empty() ? head.back() : tail.back();
+}
+
+// Модификаторы
+template <typename T>
+void SpillCircularList<T>::push_back(const T& value) {
+    if (spilled == 0 && tail.empty() && head.size() < capacity) {
+        head.push_back(value);
+        return;
+    }
+    tail.push_back(value);
+    // >=: после неудачной записи сброс повторяется при следующей вставке
+    if (tail.size() >= capacity) spill();
+}
+
+template <typename T>
+void SpillCircularList<T>::pop_front() {
+    if (empty())
+        throw std::out_of_range("SpillCircularList::pop_front: empty list");
+    if (head_pos + 1 < head.size())
+        ++head_pos;
+    else
+        refill();
+}
+
+template <typename T>
+void SpillCircularList<T>::clear() {
+    close_segments();
+    head.clear();
+    head_pos = 0;
+    tail.clear();
+}
+
+template <typename T>
+void SpillCircularList<T>::swap(SpillCircularList& other) noexcept {
+    std::swap(directory, other.directory);
+    std::swap(capacity, other.capacity);
+    std::swap(segment_elements, other.segment_elements);
+    std::swap(read_ahead_bytes, other.read_ahead_bytes);
+    std::swap(head, other.head);
+    std::swap(head_pos, other.head_pos);
+    std::swap(segments, other.segments);
+    std::swap(spilled, other.spilled);
+    std::swap(tail, other.tail);
+    std::swap(counters, other.counters);
+}
+
+#endif
@@ -0,0 +1,800 @@
+#ifndef SPLIT_CIRCULAR_LIST_H
+#define SPLIT_CIRCULAR_LIST_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "CircularList.h"
+
+// Расположение узлов кольцевого списка
+enum class NodeLayout {
+    inline_payload,  // связи и значение в одном узле (CircularList)
+    split            // связи отдельно от значений (SplitCircularList)
+};
+
+// Признак отсутствия ключа у SplitCircularList
+struct NoKey {};
+
+// Тип ключа, который KeyOf извлекает из const T&
+template <typename T, typename KeyOf>
+struct SplitKey {
+        using type =
+            std::decay_t<std::invoke_result_t<const KeyOf&, const T&>>;
+};
+
+template <typename T>
+struct SplitKey<T, NoKey> {
+        using type = NoKey;
+};
+
+// Кольцевой список с разделением горячих и холодных данных. Связи узлов
+// (два 32-битных индекса и, если задан KeyOf, небольшой ключ элемента)
+// лежат плотным массивом, а значения - в отдельных блоках по
+// kChunkSize элементов, номер узла в которых совпадает с номером связей.
+// Обход связей, rotate, index_of, nth, а с ключом ещё find и count не
+// читают значения, поэтому при больших T в кэш попадают только связи.
+//
+// KeyOf - функциональный объект const T& -> ключ; ключ копируется в связи
+// при вставке. Чтобы копия не расходилась со значением, у списка с
+// ключом итераторы дают только константный доступ, а значение меняется
+// через replace(). KeyOf без конструктора по умолчанию (например, лямбда
+// с захватом) передаётся в конструктор; присваивание и swap списков
+// доступны, только если KeyOf можно обменять.
+//
+// Узлы и значения не перемещаются: итераторы и ссылки на элементы
+// действительны до удаления элемента, end() - до перемещения или обмена
+// списков.
+template <typename T, typename KeyOf = NoKey>
+class SplitCircularList {
+    public:
+        static constexpr bool keyed = !std::is_same_v<KeyOf, NoKey>;
+        using key_type = typename SplitKey<T, KeyOf>::type;
+
+        // Число значений в одном блоке
+        static constexpr size_t kChunkSize = 64;
+
+    private:
+        using Index = uint32_t;
+        // Узел 0 - страж: его next - голова, prev - хвост. Страж создаётся
+        // первой вставкой, поэтому новый и перемещённый списки не держат
+        // памяти
+        static constexpr Index kSentinel = 0;
+        static constexpr size_t kMaxNodes = UINT32_MAX;
+
+        struct Link {
+                Index next;
+                Index prev;
+                [[no_unique_address]] key_type key;
+        };
+
+        std::vector<Link> links;
+        // Значение узла i лежит в chunks[(i - 1) / kChunkSize]
+        std::vector<T*> chunks;
+        Index free_head;  // kSentinel - свободных узлов нет
+        size_t count;
+        [[no_unique_address]] KeyOf key_of;
+
+        T* payload(Index node);
+        const T* payload(Index node) const;
+        // Голова кольца; kSentinel у пустого списка, в том числе без стража
+        Index head() const noexcept;
+        // Узел со значением value; при исключении узел остаётся свободным
+        Index construct_node(const T& value);
+        void destroy_node(Index node) noexcept;
+        void link_before(Index node, Index pos) noexcept;
+        void unlink(Index node) noexcept;
+        void release_storage() noexcept;
+
+        template <bool Const>
+        class basic_iterator;
+
+    public:
+        using value_type = T;
+
+        // Конструкторы
+        SplitCircularList() noexcept
+            requires std::is_default_constructible_v<KeyOf>;
+        explicit SplitCircularList(KeyOf key_of);
+        SplitCircularList(const SplitCircularList& other);
+        SplitCircularList(SplitCircularList&& other)
+            noexcept(std::is_nothrow_move_constructible_v<KeyOf>);
+        ~SplitCircularList();
+
+        // Операторы присваивания
+        SplitCircularList& operator=(const SplitCircularList& other)
+            requires std::is_swappable_v<KeyOf>;
+        SplitCircularList& operator=(SplitCircularList&& other) noexcept
+            requires std::is_swappable_v<KeyOf>;
+
+        // Итераторы
+        using iterator = basic_iterator<false>;
+        using const_iterator = basic_iterator<true>;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+        iterator begin();
+        iterator end();
+        const_iterator begin() const;
+        const_iterator end() const;
+        const_iterator cbegin() const;
+        const_iterator cend() const;
+        reverse_iterator rbegin();
+        reverse_iterator rend();
+        const_reverse_iterator rbegin() const;
+        const_reverse_iterator rend() const;
+
+        template <typename F>
+        void for_each(F f);
+        template <typename F>
+        void for_each(F f) const;
+
+        // Размер и проверка на пустоту
+        size_t size() const;
+        bool empty() const;
+
+        // Доступ к элементам
+        const T& front() const;
+        const T& back() const;
+        T& front()
+            requires(!keyed);
+        T& back()
+            requires(!keyed);
+
+        // Операции только над связями
+        // Итератор на n-й элемент; обход идёт с ближайшего конца
+        iterator nth(size_t n);
+        const_iterator nth(size_t n) const;
+        // Номер элемента от begin(); size() для end()
+        size_t index_of(const_iterator it) const;
+        // Сдвиг начала кольца на n позиций вперёд (назад при n < 0)
+        void rotate(std::ptrdiff_t n);
+        // Поиск и подсчёт по ключу
+        iterator find(const key_type& key)
+            requires keyed;
+        const_iterator find(const key_type& key) const
+            requires keyed;
+        size_t count_key(const key_type& key) const
+            requires keyed;
+        // f принимает const key_type&; если f возвращает bool, false
+        // прекращает обход
+        template <typename F>
+        void for_each_key(F f) const
+            requires keyed;
+
+        // Модификаторы
+        void push_back(const T& value);
+        void push_front(const T& value);
+        void pop_back();
+        void pop_front();
+        void clear();
+        iterator insert(iterator pos, const T& value);
+        iterator erase(iterator pos);
+        // Замена значения с пересчётом ключа
+        void replace(iterator pos, const T& value);
+        void swap(SplitCircularList& other) noexcept
+            requires std::is_swappable_v<KeyOf>;
+
+        // Операторы сравнения
+        bool operator==(const SplitCircularList& other) const;
+        bool operator!=(const SplitCircularList& other) const;
+        bool operator<(const SplitCircularList& other) const;
+        bool operator>(const SplitCircularList& other) const;
+        bool operator<=(const SplitCircularList& other) const;
+        bool operator>=(const SplitCircularList& other) const;
+
+    private:
+        template <bool Const>
+        class basic_iterator {
+                using List = std::conditional_t<Const, const SplitCircularList,
+                                                SplitCircularList>;
+
+                List* list;
+                Index node;  // kSentinel - конец
+
+            public:
+                using iterator_category = std::bidirectional_iterator_tag;
+                using value_type = T;
+                using difference_type = std::ptrdiff_t;
+                using pointer =
+                    std::conditional_t<Const || keyed, const T*, T*>;
+                using reference =
+                    std::conditional_t<Const || keyed, const T&, T&>;
+                basic_iterator(List* l = nullptr, Index n = kSentinel);
+                // Неконстантный итератор приводится к константному
+                template <bool OtherConst>
+                    requires(Const && !OtherConst)
+                basic_iterator(const basic_iterator<OtherConst>& other);
+                reference operator*() const;
+                // Ключ элемента из массива связей
+                const key_type& key() const
+                    requires keyed;
+                basic_iterator& operator++();
+                basic_iterator& operator--();
+                bool operator==(const basic_iterator& other) const;
+                bool operator!=(const basic_iterator& other) const;
+                friend class SplitCircularList;
+                template <bool>
+                friend class basic_iterator;
+        };
+};
+
+// Выбор расположения узлов при инстанцировании: KeyOf используется только
+// разделённым расположением
+template <typename T, NodeLayout Layout, typename KeyOf = NoKey>
+using LayoutCircularList =
+    std::conditional_t<Layout == NodeLayout::split,
+                       SplitCircularList<T, KeyOf>, CircularList<T>>;
+
+// Управление узлами
+template <typename T, typename KeyOf>
+T* SplitCircularList<T, KeyOf>::payload(Index node) {
+    return chunks[(node - 1) / kChunkSize] + (node - 1) % kChunkSize;
+}
+
+template <typename T, typename KeyOf>
+const T* SplitCircularList<T, KeyOf>::payload(Index node) const {
+    return chunks[(node - 1) / kChunkSize] + (node - 1) % kChunkSize;
+}
+
+template <typename T, typename KeyOf>
+typename SplitCircularList<T, KeyOf>::Index
+SplitCircularList<T, KeyOf>::head() const noexcept {
+    return links.empty() ? kSentinel : links[kSentinel].next;
+}
+
+template <typename T, typename KeyOf>
+typename SplitCircularList<T, KeyOf>::Index
+SplitCircularList<T, KeyOf>::construct_node(const T& value) {
+    if (links.empty()) links.push_back(Link{kSentinel, kSentinel, key_type()});
+    Index node = free_head;
+    if (node == kSentinel) {
+        if (links.size() >= kMaxNodes)
+            throw std::length_error("SplitCircularList: too many elements");
+        if ((links.size() - 1) / kChunkSize == chunks.size()) {
+            chunks.reserve(chunks.size() + 1);
+            chunks.push_back(std::allocator<T>().allocate(kChunkSize));
+        }
+        links.push_back(Link{kSentinel, kSentinel, key_type()});
+        node = Index(links.size() - 1);
+    } else {
+        free_head = links[node].next;
+    }
+    try {
+        std::construct_at(payload(node), value);
+    } catch (...) {
+        links[node].next = free_head;
+        free_head = node;
+        throw;
+    }
+    if constexpr (keyed) {
+        try {
+            links[node].key = key_of(*payload(node));
+        } catch (...) {
+            destroy_node(node);
+            throw;
+        }
+    }
+    return node;
+}
+
+template <typename T, typename KeyOf>
+void SplitCircularList<T, KeyOf>::destroy_node(Index node) noexcept {
+    std::destroy_at(payload(node));
+    links[node].next = free_head;
+    free_head = node;
+}
+
+template <typename T, typename KeyOf>
+void SplitCircularList<T, KeyOf>::link_before(Index node, Index pos) noexcept {
+    Index prev = links[pos].prev;
+    links[node].next = pos;
+    links[node].prev = prev;
+    links[prev].next = node;
+    links[pos].prev = node;
+    ++count;
+}
+
+template <typename T, typename KeyOf>
+void SplitCircularList<T, KeyOf>::unlink(Index node) noexcept {
+    links[links[node].prev].next = links[node].next;
+    links[links[node].next].prev = links[node].prev;
+    --count;
+}
+
+template <typename T, typename KeyOf>
+void SplitCircularList<T, KeyOf>::release_storage() noexcept {
+    clear();
+    for (T* chunk : chunks) std::allocator<T>().deallocate(chunk, kChunkSize);
+    chunks.clear();
+    links.clear();
+    free_head = kSentinel;
+}
+
+// Конструкторы
+template <typename T, typename KeyOf>
+SplitCircularList<T, KeyOf>::SplitCircularList() noexcept
+    requires std::is_default_constructible_v<KeyOf>
+    : free_head(kSentinel), count(0) {
+}
+
+template <typename T, typename KeyOf>
+SplitCircularList<T, KeyOf>::SplitCircularList(KeyOf key_of)
+    : free_head(kSentinel), count(0), key_of(std::move(key_of)) {
+}
+
+template <typename T, typename KeyOf>
+SplitCircularList<T, KeyOf>::SplitCircularList(const SplitCircularList& other)
+    : SplitCircularList(other.key_of) {
+    try {
+        other.for_each([this](const T& value) { push_back(value); });
+    } catch (...) {
+        release_storage();
+        throw;
+    }
+}
+
+template <typename T, typename KeyOf>
+SplitCircularList<T, KeyOf>::SplitCircularList(SplitCircularList&& other)
+    noexcept(std::is_nothrow_move_constructible_v<KeyOf>)
+    : links(std::move(other.links)), chunks(std::move(other.chunks)),
+      free_head(other.free_head), count(other.count),
+      key_of(std::move(other.key_of)) {
+    other.links.clear();
+    other.chunks.clear();
+    other.free_head = kSentinel;
+    other.count = 0;
+}
+
+template <typename T, typename KeyOf>
+SplitCircularList<T, KeyOf>::~SplitCircularList() {
+    release_storage();
+}
+
+// Операторы присваивания
+template <typename T, typename KeyOf>
+SplitCircularList<T, KeyOf>& SplitCircularList<T, KeyOf>::operator=(
+    const SplitCircularList& other)
+    requires std::is_swappable_v<KeyOf>
+{
+    if (this != &other) {
+        SplitCircularList temp(other);
+        swap(temp);
+    }
+    return *this;
+}
+
+template <typename T, typename KeyOf>
+SplitCircularList<T, KeyOf>& SplitCircularList<T, KeyOf>::operator=(
+    SplitCircularList&& other) noexcept
+    requires std::is_swappable_v<KeyOf>
+{
+    if (this != &other) {
+        release_storage();
+        swap(other);
+    }
+    return *this;
+}
+
+// Итераторы
+template <typename T, typename KeyOf>
+typename SplitCircularList<T, KeyOf>::iterator
+SplitCircularList<T, KeyOf>::begin() {
+    return iterator(this, head());
+}
+
+template <typename T, typename KeyOf>
+typename SplitCircularList<T, KeyOf>::iterator
+SplitCircularList<T, KeyOf>::end() {
+    return iterator(this, kSentinel);
+}
+
+template <typename T, typename KeyOf>
+typename SplitCircularList<T, KeyOf>::const_iterator
+SplitCircularList<T, KeyOf>::begin() const {
+    return const_iterator(this, head());
+}
+
+template <typename T, typename KeyOf>
+typename SplitCircularList<T, KeyOf>::const_iterator
+SplitCircularList<T, KeyOf>::end() const {
+    return const_iterator(this, kSentinel);
+}
+
+template <typename T, typename KeyOf>
+typename SplitCircularList<T, KeyOf>::const_iterator
+SplitCircularList<T, KeyOf>::cbegin() const {
+    return begin();
+}
+
+template <typename T, typename KeyOf>
+typename SplitCircularList<T, KeyOf>::const_iterator
+SplitCircularList<T, KeyOf>::cend() const {
+    return end();
+}
+
+template <typename T, typename KeyOf>
+typename SplitCircularList<T, KeyOf>::reverse_iterator
+SplitCircularList<T, KeyOf>::rbegin() {
+    return reverse_iterator(end());
+}
+
+template <typename T, typename KeyOf>
+typename SplitCircularList<T, KeyOf>::reverse_iterator
+SplitCircularList<T, KeyOf>::rend() {
+    return reverse_iterator(begin());
+}
+
+template <typename T, typename KeyOf>
+typename SplitCircularList<T, KeyOf>::const_reverse_iterator
+SplitCircularList<T, KeyOf>::rbegin() const {
+    return const_reverse_iterator(end());
+}
+
+template <typename T, typename KeyOf>
+typename SplitCircularList<T, KeyOf>::const_reverse_iterator
+SplitCircularList<T, KeyOf>::rend() const {
+    return const_reverse_iterator(begin());
+}
+
+template <typename T, typename KeyOf>
+template <bool Const>
+SplitCircularList<T, KeyOf>::basic_iterator<Const>::basic_iterator(List* l,
+                                                                   Index n)
+    : list(l), node(n) {
+}
+
+template <typename T, typename KeyOf>
+template <bool Const>
+template <bool OtherConst>
+    requires(Const && !OtherConst)
+SplitCircularList<T, KeyOf>::basic_iterator<Const>::basic_iterator(
+    const basic_iterator<OtherConst>& other)
+    : list(other.list), node(other.node) {
+}
+
+template <typename T, typename KeyOf>
+template <bool Const>
+typename SplitCircularList<T, KeyOf>::template basic_iterator<
+    Const>::reference
+SplitCircularList<T, KeyOf>::basic_iterator<Const>::operator*() const {
+    if (node == kSentinel)
+        throw std::out_of_range(
+            "SplitCircularList::iterator::operator*: dereferencing end "
+            "iterator");
+    return *list->payload(node);
+}
+
+template <typename T, typename KeyOf>
+template <bool Const>
+const typename SplitCircularList<T, KeyOf>::key_type&
+SplitCircularList<T, KeyOf>::basic_iterator<Const>::key() const
+    requires keyed
+{
+    if (node == kSentinel)
+        throw std::out_of_range(
+            "SplitCircularList::iterator::key: end iterator");
+    return list->links[node].key;
+}
+
+template <typename T, typename KeyOf>
+template <bool Const>
+typename SplitCircularList<T, KeyOf>::template basic_iterator<Const>&
+SplitCircularList<T, KeyOf>::basic_iterator<Const>::operator++() {
+    node = list->links[node].next;
+    return *this;
+}
+
+template <typename T, typename KeyOf>
+template <bool Const>
+typename SplitCircularList<T, KeyOf>::template basic_iterator<Const>&
+SplitCircularList<T, KeyOf>::basic_iterator<Const>::operator--() {
+    node = list->links[node].prev;
+    return *this;
+}
+
+template <typename T, typename KeyOf>
+template <bool Const>
+bool SplitCircularList<T, KeyOf>::basic_iterator<Const>::operator==(
+    const basic_iterator& other) const {
+    return node == other.node;
+}
+
+template <typename T, typename KeyOf>
+template <bool Const>
+bool SplitCircularList<T, KeyOf>::basic_iterator<Const>::operator!=(
+    const basic_iterator& other) const {
+    return node != other.node;
+}
+
+template <typename T, typename KeyOf>
+template <typename F>
+void SplitCircularList<T, KeyOf>::for_each(F f) {
+    for (Index node = head(); node != kSentinel; node = links[node].next) {
+        if constexpr (keyed) {
+            f(std::as_const(*payload(node)));
+        } else {
+            f(*payload(node));
+        }
+    }
+}
+
+template <typename T, typename KeyOf>
+template <typename F>
+void SplitCircularList<T, KeyOf>::for_each(F f) const {
+    for (Index node = head(); node != kSentinel; node = links[node].next) {
+        f(*payload(node));
+    }
+}
+
+// Размер и проверка на пустоту
+template <typename T, typename KeyOf>
+size_t SplitCircularList<T, KeyOf>::size() const {
+    return count;
+}
+
+template <typename T, typename KeyOf>
+bool SplitCircularList<T, KeyOf>::empty() const {
+    return count == 0;
+}
+
+// Доступ к элементам
+template <typename T, typename KeyOf>
+const T& SplitCircularList<T, KeyOf>::front() const {
+    if (empty())
+        throw std::out_of_range("SplitCircularList::front: empty list");
+    return *payload(links[kSentinel].next);
+}
+
+template <typename T, typename KeyOf>
+const T& SplitCircularList<T, KeyOf>::back() const {
+    if (empty())
+        throw std::out_of_range("SplitCircularList::back: empty list");
+    return *payload(links[kSentinel].prev);
+}
+
+template <typename T, typename KeyOf>
+T& SplitCircularList<T, KeyOf>::front()
+    requires(!keyed)
+{
+    if (empty())
+        throw std::out_of_range("SplitCircularList::front: empty list");
+    return *payload(links[kSentinel].next);
+}
+
+template <typename T, typename KeyOf>
+T& SplitCircularList<T, KeyOf>::back()
+    requires(!keyed)
+{
+    if (empty())
+        throw std::out_of_range("SplitCircularList::back: empty list");
+    return *payload(links[kSentinel].prev);
+}
+
+// Операции только над связями
+template <typename T, typename KeyOf>
+typename SplitCircularList<T, KeyOf>::iterator
+SplitCircularList<T, KeyOf>::nth(size_t n) {
+    const_iterator it = std::as_const(*this).nth(n);
+    return iterator(this, it.node);
+}
+
+template <typename T, typename KeyOf>
+typename SplitCircularList<T, KeyOf>::const_iterator
+SplitCircularList<T, KeyOf>::nth(size_t n) const {
+    if (n > count) throw std::out_of_range("SplitCircularList::nth: bad index");
+    Index node = kSentinel;
+    if (n <= count / 2) {
+        node = head();
+        for (size_t i = 0; i < n; ++i) node = links[node].next;
+    } else {
+        for (size_t i = count; i > n; --i) node = links[node].prev;
+    }
+    return const_iterator(this, node);
+}
+
+template <typename T, typename KeyOf>
+size_t SplitCircularList<T, KeyOf>::index_of(const_iterator it) const {
+    size_t index = 0;
+    for (Index node = it.node; node != kSentinel; node = links[node].prev)
+        ++index;
+    return it.node == kSentinel ? count : index - 1;
+}
+
+template <typename T, typename KeyOf>
+void SplitCircularList<T, KeyOf>::rotate(std::ptrdiff_t n) {
+    if (count < 2) return;
+    auto size = static_cast<std::ptrdiff_t>(count);
+    std::ptrdiff_t steps = n % size;
+    if (steps < 0) steps += size;
+    if (steps == 0) return;
+    // Без стража кольцо узлов замкнуто; страж встаёт перед новой головой
+    Index first = links[kSentinel].next;
+    unlink(kSentinel);
+    if (steps <= size / 2) {
+        for (std::ptrdiff_t i = 0; i < steps; ++i) first = links[first].next;
+    } else {
+        for (std::ptrdiff_t i = steps; i < size; ++i)
+            first = links[first].prev;
+    }
+    link_before(kSentinel, first);
+}
+
+template <typename T, typename KeyOf>
+typename SplitCircularList<T, KeyOf>::iterator
+SplitCircularList<T, KeyOf>::find(const key_type& key)
+    requires keyed
+{
+    const_iterator it = std::as_const(*this).find(key);
+    return iterator(this, it.node);
+}
+
+template <typename T, typename KeyOf>
+typename SplitCircularList<T, KeyOf>::const_iterator
+SplitCircularList<T, KeyOf>::find(const key_type& key) const
+    requires keyed
+{
+    Index node = head();
+    while (node != kSentinel && !(links[node].key == key))
+        node = links[node].next;
+    return const_iterator(this, node);
+}
+
+template <typename T, typename KeyOf>
+size_t SplitCircularList<T, KeyOf>::count_key(const key_type& key) const
+    requires keyed
+{
+    size_t result = 0;
+    for (Index node = head(); node != kSentinel; node = links[node].next) {
+        if (links[node].key == key) ++result;
+    }
+    return result;
+}
+
+template <typename T, typename KeyOf>
+template <typename F>
+void SplitCircularList<T, KeyOf>::for_each_key(F f) const
+    requires keyed
+{
+    for (Index node = head(); node != kSentinel; node = links[node].next) {
+        if constexpr (std::is_same_v<
+                          std::invoke_result_t<F&, const key_type&>, bool>) {
+            if (!f(std::as_const(links[node].key))) return;
+        } else {
+            f(std::as_const(links[node].key));
+        }
+    }
+}
+
+// Модификаторы
+template <typename T, typename KeyOf>
+void SplitCircularList<T, KeyOf>::push_back(const T& value) {
+    link_before(construct_node(value), kSentinel);
+}
+
+template <typename T, typename KeyOf>
+void SplitCircularList<T, KeyOf>::push_front(const T& value) {
+    Index node = construct_node(value);
+    link_before(node, links[kSentinel].next);
+}
+
+template <typename T, typename KeyOf>
+void SplitCircularList<T, KeyOf>::pop_back() {
+    if (empty())
+        throw std::out_of_range("SplitCircularList::pop_back: empty list");
+    Index node = links[kSentinel].prev;
+    unlink(node);
+    destroy_node(node);
+}
+
+template <typename T, typename KeyOf>
+void SplitCircularList<T, KeyOf>::pop_front() {
+    if (empty())
+        throw std::out_of_range("SplitCircularList::pop_front: empty list");
+    Index node = links[kSentinel].next;
+    unlink(node);
+    destroy_node(node);
+}
+
+template <typename T, typename KeyOf>
+void SplitCircularList<T, KeyOf>::clear() {
+    if (links.empty()) return;
+    Index node = links[kSentinel].next;
+    while (node != kSentinel) {
+        Index next = links[node].next;
+        destroy_node(node);
+        node = next;
+    }
+    links[kSentinel].next = links[kSentinel].prev = kSentinel;
+    count = 0;
+}
+
+template <typename T, typename KeyOf>
+typename SplitCircularList<T, KeyOf>::iterator
+SplitCircularList<T, KeyOf>::insert(iterator pos, const T& value) {
+    Index node = construct_node(value);
+    link_before(node, pos.node);
+    return iterator(this, node);
+}
+
+template <typename T, typename KeyOf>
+typename SplitCircularList<T, KeyOf>::iterator
+SplitCircularList<T, KeyOf>::erase(iterator pos) {
+    if (empty())
+        throw std::out_of_range("SplitCircularList::erase: empty list");
+    if (pos.node == kSentinel)
+        throw std::invalid_argument(
+            "SplitCircularList::erase: invalid iterator");
+    Index next = links[pos.node].next;
+    unlink(pos.node);
+    destroy_node(pos.node);
+    return iterator(this, next);
+}
+
+template <typename T, typename KeyOf>
+void SplitCircularList<T, KeyOf>::replace(iterator pos, const T& value) {
+    if (pos.node == kSentinel)
+        throw std::invalid_argument(
+            "SplitCircularList::replace: invalid iterator");
+    *payload(pos.node) = value;
+    if constexpr (keyed) links[pos.node].key = key_of(*payload(pos.node));
+}
+
+template <typename T, typename KeyOf>
+void SplitCircularList<T, KeyOf>::swap(SplitCircularList& other) noexcept
+    requires std::is_swappable_v<KeyOf>
+{
+    links.swap(other.links);
+    chunks.swap(other.chunks);
+    std::swap(free_head, other.free_head);
+    std::swap(count, other.count);
+    using std::swap;
+    swap(key_of, other.key_of);
+}
+
+// Операторы сравнения
+template <typename T, typename KeyOf>
+bool SplitCircularList<T, KeyOf>::operator==(
+    const SplitCircularList& other) const {
+    return size() == other.size() && std::equal(begin(), end(), other.begin());
+}
+
+template <typename T, typename KeyOf>
+bool SplitCircularList<T, KeyOf>::operator!=(
+    const SplitCircularList& other) const {
+    return !(*this == other);
+}
+
+template <typename T, typename KeyOf>
+bool SplitCircularList<T, KeyOf>::operator<(
+    const SplitCircularList& other) const {
+    return std::lexicographical_compare(begin(), end(), other.begin(),
+                                        other.end());
+}
+
+template <typename T, typename KeyOf>
+bool SplitCircularList<T, KeyOf>::operator>(
+    const SplitCircularList& other) const {
+    return other < *this;
+}
+
+template <typename T, typename KeyOf>
+bool SplitCircularList<T, KeyOf>::operator<=(
+    const SplitCircularList& other) const {
+    return !(other < *this);
+}
+
+template <typename T, typename KeyOf>
+bool SplitCircularList<T, KeyOf>::operator>=(
+    const SplitCircularList& other) const {
+    return !(*this < other);
+}
+
+#endif
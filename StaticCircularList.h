@@ -0,0 +1,811 @@
+#ifndef STATIC_CIRCULAR_LIST_H
+#define STATIC_CIRCULAR_LIST_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+// Поведение StaticCircularList при вставке в заполненный список
+enum class FullPolicy {
+    throw_exception,  // бросить std::length_error
+    reject,           // ничего не вставлять и вернуть false / end()
+    overwrite_oldest  // вытеснить элемент с противоположного конца
+};
+
+// Кольцевой список ёмкостью N узлов, хранящихся прямо в объекте. Узлы
+// связаны индексами, свободные узлы образуют односвязный список. Ни одна
+// операция не обращается к куче; вставка, удаление и доступ к концам
+// выполняются за O(1). clear() и деструктор для тривиально разрушаемых T
+// также O(1): ещё не использованные узлы не заносятся в список свободных,
+// а выдаются по счётчику fresh.
+template <typename T, size_t N,
+          FullPolicy Policy = FullPolicy::throw_exception>
+class StaticCircularList {
+        static_assert(N > 0, "StaticCircularList: capacity must be > 0");
+
+    public:
+        // Самый узкий беззнаковый тип, вмещающий номера узлов и npos
+        using Index = std::conditional_t<
+            (N < UINT16_MAX), uint16_t,
+            std::conditional_t<(N < UINT32_MAX), uint32_t, size_t>>;
+
+    private:
+        static constexpr Index npos = Index(-1);
+
+        struct Node {
+                union {
+                        T value;
+                };
+                Index next;
+                Index prev;
+                Node() {}
+                ~Node() {}
+        };
+
+        Node nodes[N];
+        Index head;
+        Index count;
+        Index free_head;  // вершина списка освобождённых узлов
+        Index fresh;      // узлы [fresh, N) ещё ни разу не выдавались
+
+        // Создаёт значение в свободном узле; при исключении узел остаётся
+        // свободным
+        Index construct_node(const T& value);
+        void destroy_node(Index node) noexcept;
+        // Вставка узла перед pos (npos - в конец)
+        void link_before(Index node, Index pos) noexcept;
+        void unlink(Index node) noexcept;
+        // Реакция на заполненный список для политик throw_exception и
+        // reject
+        static bool reject_full(const char* message);
+        void move_from(StaticCircularList& other) noexcept(
+            std::is_nothrow_move_constructible_v<T>);
+
+        template <bool Const>
+        class basic_iterator;
+        template <bool Const>
+        class basic_segment_iterator;
+
+    public:
+        static constexpr size_t capacity = N;
+        static constexpr FullPolicy full_policy = Policy;
+
+        // Конструкторы
+        StaticCircularList();
+        StaticCircularList(const StaticCircularList& other);
+        StaticCircularList(StaticCircularList&& other) noexcept(
+            std::is_nothrow_move_constructible_v<T>);
+        ~StaticCircularList();
+
+        // Операторы присваивания
+        StaticCircularList& operator=(const StaticCircularList& other);
+        StaticCircularList& operator=(StaticCircularList&& other) noexcept(
+            std::is_nothrow_move_constructible_v<T>);
+
+        // Итераторы
+        using iterator = basic_iterator<false>;
+        using const_iterator = basic_iterator<true>;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+        iterator begin();
+        iterator end();
+        const_iterator begin() const;
+        const_iterator end() const;
+        const_iterator cbegin() const;
+        const_iterator cend() const;
+        reverse_iterator rbegin();
+        reverse_iterator rend();
+        const_reverse_iterator rbegin() const;
+        const_reverse_iterator rend() const;
+        const_reverse_iterator crbegin() const;
+        const_reverse_iterator crend() const;
+
+        // Сегментный обход: как и у CircularList, сегмент - один узел
+        using segment_iterator = basic_segment_iterator<false>;
+        using const_segment_iterator = basic_segment_iterator<true>;
+
+        segment_iterator segment_begin();
+        segment_iterator segment_end();
+        const_segment_iterator segment_begin() const;
+        const_segment_iterator segment_end() const;
+
+        // f принимает std::span<T>; если f возвращает bool, false
+        // прекращает обход
+        template <typename F>
+        void for_each_segment(F f);
+        template <typename F>
+        void for_each_segment(F f) const;
+
+        template <typename F>
+        void for_each(F f);
+        template <typename F>
+        void for_each(F f) const;
+
+        // Размер и проверка на пустоту
+        size_t size() const;
+        bool empty() const;
+        bool full() const;
+
+        // Доступ к элементам
+        T& front();
+        const T& front() const;
+        T& back();
+        const T& back() const;
+
+        // Модификаторы. Вставка в заполненный список ведёт себя согласно
+        // Policy; false (или end() у insert) означает, что значение не
+        // вставлено. При overwrite_oldest push_back вытесняет front(),
+        // push_front - back(), insert - front(), а insert перед begin()
+        // ничего не вставляет, так как новый элемент был бы старейшим.
+        bool push_back(const T& value);
+        bool push_front(const T& value);
+        void pop_back();
+        void pop_front();
+        void clear();
+        iterator insert(iterator pos, const T& value);
+        iterator erase(iterator pos);
+        void swap(StaticCircularList& other) noexcept(
+            std::is_nothrow_move_constructible_v<T>);
+
+        // Операторы сравнения
+        bool operator==(const StaticCircularList& other) const;
+        bool operator!=(const StaticCircularList& other) const;
+        bool operator<(const StaticCircularList& other) const;
+        bool operator>(const StaticCircularList& other) const;
+        bool operator<=(const StaticCircularList& other) const;
+        bool operator>=(const StaticCircularList& other) const;
+
+    private:
+        template <bool Const>
+        class basic_iterator {
+                using List = std::conditional_t<Const, const StaticCircularList,
+                                                StaticCircularList>;
+
+                List* list;
+                Index node;  // npos - конец
+
+            public:
+                using iterator_category = std::bidirectional_iterator_tag;
+                using value_type = T;
+                using difference_type = std::ptrdiff_t;
+                using pointer = std::conditional_t<Const, const T*, T*>;
+                using reference = std::conditional_t<Const, const T&, T&>;
+                basic_iterator(List* l = nullptr, Index n = npos);
+                // Неконстантный итератор приводится к константному
+                template <bool OtherConst>
+                    requires(Const && !OtherConst)
+                basic_iterator(const basic_iterator<OtherConst>& other);
+                reference operator*() const;
+                basic_iterator& operator++();
+                basic_iterator& operator--();
+                bool operator==(const basic_iterator& other) const;
+                bool operator!=(const basic_iterator& other) const;
+                friend class StaticCircularList;
+                template <bool>
+                friend class basic_iterator;
+        };
+
+        template <bool Const>
+        class basic_segment_iterator {
+                using List = std::conditional_t<Const, const StaticCircularList,
+                                                StaticCircularList>;
+                using Span = std::span<std::conditional_t<Const, const T, T>>;
+
+                List* list;
+                Index node;
+
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using value_type = Span;
+                using difference_type = std::ptrdiff_t;
+                basic_segment_iterator(List* l = nullptr, Index n = npos);
+                Span operator*() const;
+                basic_segment_iterator& operator++();
+                basic_iterator<Const> to_iterator(size_t offset) const;
+                bool operator==(const basic_segment_iterator& other) const;
+                bool operator!=(const basic_segment_iterator& other) const;
+                friend class StaticCircularList;
+        };
+};
+
+// Управление узлами
+template <typename T, size_t N, FullPolicy Policy>
+typename StaticCircularList<T, N, Policy>::Index
+StaticCircularList<T, N, Policy>::construct_node(const T& value) {
+    Index node = free_head != npos ? free_head : fresh;
+    std::construct_at(&nodes[node].value, value);
+    if (node == free_head) {
+        free_head = nodes[node].next;
+    } else {
+        ++fresh;
+    }
+    return node;
+}
+
+template <typename T, size_t N, FullPolicy Policy>
+void StaticCircularList<T, N, Policy>::destroy_node(Index node) noexcept {
+    std::destroy_at(&nodes[node].value);
+    nodes[node].next = free_head;
+    free_head = node;
+}
+
+template <typename T, size_t N, FullPolicy Policy>
+void StaticCircularList<T, N, Policy>::link_before(Index node,
+                                                   Index pos) noexcept {
+    if (head == npos) {
+        nodes[node].next = node;
+        nodes[node].prev = node;
+        head = node;
+    } else {
+        Index next = pos == npos ? head : pos;
+        Index prev = nodes[next].prev;
+        nodes[node].next = next;
+        nodes[node].prev = prev;
+        nodes[prev].next = node;
+        nodes[next].prev = node;
+        if (pos == head) head = node;
+    }
+    ++count;
+}
+
+template <typename T, size_t N, FullPolicy Policy>
+void StaticCircularList<T, N, Policy>::unlink(Index node) noexcept {
+    if (nodes[node].next == node) {
+        head = npos;
+    } else {
+        nodes[nodes[node].prev].next = nodes[node].next;
+        nodes[nodes[node].next].prev = nodes[node].prev;
+        if (node == head) head = nodes[node].next;
+    }
+    --count;
+}
+
+template <typename T, size_t N, FullPolicy Policy>
+bool StaticCircularList<T, N, Policy>::reject_full(const char* message) {
+    if constexpr (Policy == FullPolicy::throw_exception) {
+        throw std::length_error(message);
+    }
+    return false;
+}
+
+template <typename T, size_t N, FullPolicy Policy>
+void StaticCircularList<T, N, Policy>::move_from(
+    StaticCircularList& other) noexcept(
+    std::is_nothrow_move_constructible_v<T>) {
+    Index current = other.head;
+    for (Index i = 0; i < other.count; ++i) {
+        std::construct_at(&nodes[fresh].value,
+                          std::move(other.nodes[current].value));
+        link_before(fresh++, npos);
+        current = other.nodes[current].next;
+    }
+    other.clear();
+}
+
+// Конструкторы
+template <typename T, size_t N, FullPolicy Policy>
+StaticCircularList<T, N, Policy>::StaticCircularList()
+    : head(npos), count(0), free_head(npos), fresh(0) {
+}
+
+template <typename T, size_t N, FullPolicy Policy>
+StaticCircularList<T, N, Policy>::StaticCircularList(
+    const StaticCircularList& other)
+    : StaticCircularList() {
+    try {
+        for (const T& value : other) link_before(construct_node(value), npos);
+    } catch (...) {
+        clear();
+        throw;
+    }
+}
+
+template <typename T, size_t N, FullPolicy Policy>
+StaticCircularList<T, N, Policy>::StaticCircularList(
+    StaticCircularList&& other) noexcept(
+    std::is_nothrow_move_constructible_v<T>)
+    : StaticCircularList() {
+    move_from(other);
+}
+
+template <typename T, size_t N, FullPolicy Policy>
+StaticCircularList<T, N, Policy>::~StaticCircularList() {
+    clear();
+}
+
+// Операторы присваивания
+template <typename T, size_t N, FullPolicy Policy>
+StaticCircularList<T, N, Policy>& StaticCircularList<T, N, Policy>::operator=(
+    const StaticCircularList& other) {
+    if (this != &other) {
+        StaticCircularList temp(other);
+        clear();
+        move_from(temp);
+    }
+    return *this;
+}
+
+template <typename T, size_t N, FullPolicy Policy>
+StaticCircularList<T, N, Policy>& StaticCircularList<T, N, Policy>::operator=(
+    StaticCircularList&& other) noexcept(
+    std::is_nothrow_move_constructible_v<T>) {
+    if (this != &other) {
+        clear();
+        move_from(other);
+    }
+    return *this;
+}
+
+// Итераторы
+template <typename T, size_t N, FullPolicy Policy>
+typename StaticCircularList<T, N, Policy>::iterator
+StaticCircularList<T, N, Policy>::begin() {
+    return iterator(this, head);
+}
+
+template <typename T, size_t N, FullPolicy Policy>
+typename StaticCircularList<T, N, Policy>::iterator
+StaticCircularList<T, N, Policy>::end() {
+    return iterator(this, npos);
+}
+
+template <typename T, size_t N, FullPolicy Policy>
+typename StaticCircularList<T, N, Policy>::const_iterator
+StaticCircularList<T, N, Policy>::begin() const {
+    return const_iterator(this, head);
+}
+
+template <typename T, size_t N, FullPolicy Policy>
+typename StaticCircularList<T, N, Policy>::const_iterator
+StaticCircularList<T, N, Policy>::end() const {
+    return const_iterator(this, npos);
+}
+
+template <typename T, size_t N, FullPolicy Policy>
+typename StaticCircularList<T, N, Policy>::const_iterator
+StaticCircularList<T, N, Policy>::cbegin() const {
+    return begin();
+}
+
+template <typename T, size_t N, FullPolicy Policy>
+typename StaticCircularList<T, N, Policy>::const_iterator
+StaticCircularList<T, N, Policy>::cend() const {
+    return end();
+}
+
+template <typename T, size_t N, FullPolicy Policy>
+typename StaticCircularList<T, N, Policy>::reverse_iterator
+StaticCircularList<T, N, Policy>::rbegin() {
+    return reverse_iterator(end());
+}
+
+template <typename T, size_t N, FullPolicy Policy>
+typename StaticCircularList<T, N, Policy>::reverse_iterator
+StaticCircularList<T, N, Policy>::rend() {
+    return reverse_iterator(begin());
+}
+
+template <typename T, size_t N, FullPolicy Policy>
+typename StaticCircularList<T, N, Policy>::const_reverse_iterator
+StaticCircularList<T, N, Policy>::rbegin() const {
+    return const_reverse_iterator(end());
+}
+
+template <typename T, size_t N, FullPolicy Policy>
+typename StaticCircularList<T, N, Policy>::const_reverse_iterator
+StaticCircularList<T, N, Policy>::rend() const {
+    return const_reverse_iterator(begin());
+}
+
+template <typename T, size_t N, FullPolicy Policy>
+typename StaticCircularList<T, N, Policy>::const_reverse_iterator
+StaticCircularList<T, N, Policy>::crbegin() const {
+    return rbegin();
+}
+
+template <typename T, size_t N, FullPolicy Policy>
+typename StaticCircularList<T, N, Policy>::const_reverse_iterator
+StaticCircularList<T, N, Policy>::crend() const {
+    return rend();
+}
+
+template <typename T, size_t N, FullPolicy Policy>
+template <bool Const>
+StaticCircularList<T, N, Policy>::basic_iterator<Const>::basic_iterator(
+    List* l, Index n)
+    : list(l), node(n) {
+}
+
+template <typename T, size_t N, FullPolicy Policy>
+template <bool Const>
+template <bool OtherConst>
+    requires(Const && !OtherConst)
+StaticCircularList<T, N, Policy>::basic_iterator<Const>::basic_iterator(
+    const basic_iterator<OtherConst>& other)
+    : list(other.list), node(other.node) {
+}
+
+template <typename T, size_t N, FullPolicy Policy>
+template <bool Const>
+typename StaticCircularList<T, N, Policy>::template basic_iterator<
+    Const>::reference
+StaticCircularList<T, N, Policy>::basic_iterator<Const>::operator*() const {
+    if (node == npos)
+        throw std::out_of_range(
+            "StaticCircularList::iterator::operator*: dereferencing end "
+            "iterator");
+    return list->nodes[node].value;
+}
+
+template <typename T, size_t N, FullPolicy Policy>
+template <bool Const>
+typename StaticCircularList<T, N, Policy>::template basic_iterator<Const>&
+StaticCircularList<T, N, Policy>::basic_iterator<Const>::operator++() {
+    if (node == npos)
+        throw std::out_of_range(
+            "StaticCircularList::iterator::operator++: incrementing end "
+            "iterator");
+    node = list->nodes[node].next == list->head ? npos : list->nodes[node].next;
+    return *this;
+}
+
+template <typename T, size_t N, FullPolicy Policy>
+template <bool Const>
+typename StaticCircularList<T, N, Policy>::template basic_iterator<Const>&
+StaticCircularList<T, N, Policy>::basic_iterator<Const>::operator--() {
+    if (list->head == npos)
+        throw std::out_of_range(
+            "StaticCircularList::iterator::operator--: empty list");
+    node = list->nodes[node == npos ? list->head : node].prev;
+    return *this;
+}
+
+template <typename T, size_t N, FullPolicy Policy>
+template <bool Const>
+bool StaticCircularList<T, N, Policy>::basic_iterator<Const>::operator==(
+    const basic_iterator& other) const {
+    return node == other.node;
+}
+
+template <typename T, size_t N, FullPolicy Policy>
+template <bool Const>
+bool StaticCircularList<T, N, Policy>::basic_iterator<Const>::operator!=(
+    const basic_iterator& other) const {
+    return node != other.node;
+}
+
+// Сегментный обход
+template <typename T, size_t N, FullPolicy Policy>
+typename StaticCircularList<T, N, Policy>::segment_iterator
+StaticCircularList<T, N, Policy>::segment_begin() {
+    return segment_iterator(this, head);
+}
+
+template <typename T, size_t N, FullPolicy Policy>
+typename StaticCircularList<T, N, Policy>::segment_iterator
+StaticCircularList<T, N, Policy>::segment_end() {
+    return segment_iterator(this, npos);
+}
+
+template <typename T, size_t N, FullPolicy Policy>
+typename StaticCircularList<T, N, Policy>::const_segment_iterator
+StaticCircularList<T, N, Policy>::segment_begin() const {
+    return const_segment_iterator(this, head);
+}
+
+template <typename T, size_t N, FullPolicy Policy>
+typename StaticCircularList<T, N, Policy>::const_segment_iterator
+StaticCircularList<T, N, Policy>::segment_end() const {
+    return const_segment_iterator(this, npos);
+}
+
+template <typename T, size_t N, FullPolicy Policy>
+template <typename F>
+void StaticCircularList<T, N, Policy>::for_each_segment(F f) {
+    Index current = head;
+    for (Index i = 0; i < count; ++i) {
+        Index next = nodes[current].next;
+        std::span<T> segment(&nodes[current].value, 1);
+        if constexpr (std::is_same_v<std::invoke_result_t<F&, std::span<T>>,
+                                     bool>) {
+            if (!f(segment)) return;
+        } else {
+            f(segment);
+        }
+        current = next;
+    }
+}
+
+template <typename T, size_t N, FullPolicy Policy>
+template <typename F>
+void StaticCircularList<T, N, Policy>::for_each_segment(F f) const {
+    Index current = head;
+    for (Index i = 0; i < count; ++i) {
+        std::span<const T> segment(&nodes[current].value, 1);
+        if constexpr (std::is_same_v<
+                          std::invoke_result_t<F&, std::span<const T>>, bool>) {
+            if (!f(segment)) return;
+        } else {
+            f(segment);
+        }
+        current = nodes[current].next;
+    }
+}
+
+template <typename T, size_t N, FullPolicy Policy>
+template <typename F>
+void StaticCircularList<T, N, Policy>::for_each(F f) {
+    for_each_segment([&f](std::span<T> segment) {
+        for (T& value : segment) f(value);
+    });
+}
+
+template <typename T, size_t N, FullPolicy Policy>
+template <typename F>
+void StaticCircularList<T, N, Policy>::for_each(F f) const {
+    for_each_segment([&f](std::span<const T> segment) {
+        for (const T& value : segment) f(value);
+    });
+}
+
+template <typename T, size_t N, FullPolicy Policy>
+template <bool Const>
+StaticCircularList<T, N, Policy>::basic_segment_iterator<
+    Const>::basic_segment_iterator(List* l, Index n)
+    : list(l), node(n) {
+}
+
+template <typename T, size_t N, FullPolicy Policy>
+template <bool Const>
+typename StaticCircularList<T, N, Policy>::template basic_segment_iterator<
+    Const>::Span
+StaticCircularList<T, N, Policy>::basic_segment_iterator<Const>::operator*()
+    const {
+    if (node == npos)
+        throw std::out_of_range(
+            "StaticCircularList::segment_iterator::operator*: dereferencing "
+            "end iterator");
+    return Span(&list->nodes[node].value, 1);
+}
+
+template <typename T, size_t N, FullPolicy Policy>
+template <bool Const>
+typename StaticCircularList<T, N, Policy>::template basic_segment_iterator<
+    Const>&
+StaticCircularList<T, N, Policy>::basic_segment_iterator<Const>::operator++() {
+    if (node == npos)
+        throw std::out_of_range(
+            "StaticCircularList::segment_iterator::operator++: incrementing "
+            "end iterator");
+    node = list->nodes[node].next == list->head ? npos : list->nodes[node].next;
+    return *this;
+}
+
+template <typename T, size_t N, FullPolicy Policy>
+template <bool Const>
+typename StaticCircularList<T, N, Policy>::template basic_iterator<Const>
+StaticCircularList<T, N, Policy>::basic_segment_iterator<Const>::to_iterator(
+    size_t offset) const {
+    if (node == npos || offset != 0)
+        throw std::out_of_range(
+            "StaticCircularList::segment_iterator::to_iterator: offset out "
+            "of segment");
+    return basic_iterator<Const>(list, node);
+}
+
+template <typename T, size_t N, FullPolicy Policy>
+template <bool Const>
+bool StaticCircularList<T, N, Policy>::basic_segment_iterator<
+    Const>::operator==(const basic_segment_iterator& other) const {
+    return node == other.node;
+}
+
+template <typename T, size_t N, FullPolicy Policy>
+template <bool Const>
+bool StaticCircularList<T, N, Policy>::basic_segment_iterator<
+    Const>::operator!=(const basic_segment_iterator& other) const {
+    return node != other.node;
+}
+
+// Размер и проверка на пустоту
+template <typename T, size_t N, FullPolicy Policy>
+size_t StaticCircularList<T, N, Policy>::size() const {
+    return count;
+}
+
+template <typename T, size_t N, FullPolicy Policy>
+bool StaticCircularList<T, N, Policy>::empty() const {
+    return count == 0;
+}
+
+template <typename T, size_t N, FullPolicy Policy>
+bool StaticCircularList<T, N, Policy>::full() const {
+    return count == N;
+}
+
+// Доступ к элементам
+template <typename T, size_t N, FullPolicy Policy>
+T& StaticCircularList<T, N, Policy>::front() {
+    if (empty())
+        throw std::out_of_range("StaticCircularList::front: empty list");
+    return nodes[head].value;
+}
+
+template <typename T, size_t N, FullPolicy Policy>
+const T& StaticCircularList<T, N, Policy>::front() const {
+    if (empty())
+        throw std::out_of_range("StaticCircularList::front: empty list");
+    return nodes[head].value;
+}
+
+template <typename T, size_t N, FullPolicy Policy>
+T& StaticCircularList<T, N, Policy>::back() {
+    if (empty())
+        throw std::out_of_range("StaticCircularList::back: empty list");
+    return nodes[nodes[head].prev].value;
+}
+
+template <typename T, size_t N, FullPolicy Policy>
+const T& StaticCircularList<T, N, Policy>::back() const {
+    if (empty())
+        throw std::out_of_range("StaticCircularList::back: empty list");
+    return nodes[nodes[head].prev].value;
+}
+
+// Модификаторы
+template <typename T, size_t N, FullPolicy Policy>
+bool StaticCircularList<T, N, Policy>::push_back(const T& value) {
+    if (full()) {
+        if constexpr (Policy == FullPolicy::overwrite_oldest) {
+            // Первый узел получает новое значение и становится последним
+            nodes[head].value = value;
+            head = nodes[head].next;
+            return true;
+        } else {
+            return reject_full("StaticCircularList::push_back: list is full");
+        }
+    }
+    link_before(construct_node(value), npos);
+    return true;
+}
+
+template <typename T, size_t N, FullPolicy Policy>
+bool StaticCircularList<T, N, Policy>::push_front(const T& value) {
+    if (full()) {
+        if constexpr (Policy == FullPolicy::overwrite_oldest) {
+            Index tail = nodes[head].prev;
+            nodes[tail].value = value;
+            head = tail;
+            return true;
+        } else {
+            return reject_full("StaticCircularList::push_front: list is full");
+        }
+    }
+    link_before(construct_node(value), head);
+    return true;
+}
+
+template <typename T, size_t N, FullPolicy Policy>
+void StaticCircularList<T, N, Policy>::pop_back() {
+    if (empty())
+        throw std::out_of_range("StaticCircularList::pop_back: empty list");
+    Index tail = nodes[head].prev;
+    unlink(tail);
+    destroy_node(tail);
+}
+
+template <typename T, size_t N, FullPolicy Policy>
+void StaticCircularList<T, N, Policy>::pop_front() {
+    if (empty())
+        throw std::out_of_range("StaticCircularList::pop_front: empty list");
+    Index node = head;
+    unlink(node);
+    destroy_node(node);
+}
+
+template <typename T, size_t N, FullPolicy Policy>
+void StaticCircularList<T, N, Policy>::clear() {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+        Index current = head;
+        for (Index i = 0; i < count; ++i) {
+            std::destroy_at(&nodes[current].value);
+            current = nodes[current].next;
+        }
+    }
+    head = npos;
+    count = 0;
+    free_head = npos;
+    fresh = 0;
+}
+
+template <typename T, size_t N, FullPolicy Policy>
+typename StaticCircularList<T, N, Policy>::iterator
+StaticCircularList<T, N, Policy>::insert(iterator pos, const T& value) {
+    if (full()) {
+        if constexpr (Policy == FullPolicy::overwrite_oldest) {
+            if (pos.node == head) return end();
+            // Первый узел получает новое значение и переносится к pos
+            Index node = head;
+            nodes[node].value = value;
+            unlink(node);
+            link_before(node, pos.node);
+            return iterator(this, node);
+        } else {
+            reject_full("StaticCircularList::insert: list is full");
+            return end();
+        }
+    }
+    Index node = construct_node(value);
+    link_before(node, pos.node);
+    return iterator(this, node);
+}
+
+template <typename T, size_t N, FullPolicy Policy>
+typename StaticCircularList<T, N, Policy>::iterator
+StaticCircularList<T, N, Policy>::erase(iterator pos) {
+    if (empty())
+        throw std::out_of_range("StaticCircularList::erase: empty list");
+    if (pos.node == npos)
+        throw std::invalid_argument(
+            "StaticCircularList::erase: invalid iterator");
+    Index node = pos.node;
+    Index next = nodes[node].next == head ? npos : nodes[node].next;
+    unlink(node);
+    destroy_node(node);
+    return iterator(this, next);
+}
+
+template <typename T, size_t N, FullPolicy Policy>
+void StaticCircularList<T, N, Policy>::swap(StaticCircularList& other) noexcept(
+    std::is_nothrow_move_constructible_v<T>) {
+    if (this == &other) return;
+    StaticCircularList temp(std::move(other));
+    other.move_from(*this);
+    move_from(temp);
+}
+
+// Операторы сравнения
+template <typename T, size_t N, FullPolicy Policy>
+bool StaticCircularList<T, N, Policy>::operator==(
+    const StaticCircularList& other) const {
+    return size() == other.size() && std::equal(begin(), end(), other.begin());
+}
+
+template <typename T, size_t N, FullPolicy Policy>
+bool StaticCircularList<T, N, Policy>::operator!=(
+    const StaticCircularList& other) const {
+    return !(*this == other);
+}
+
+template <typename T, size_t N, FullPolicy Policy>
+bool StaticCircularList<T, N, Policy>::operator<(
+    const StaticCircularList& other) const {
+    return std::lexicographical_compare(begin(), end(), other.begin(),
+                                        other.end());
+}
+
+template <typename T, size_t N, FullPolicy Policy>
+bool StaticCircularList<T, N, Policy>::operator>(
+    const StaticCircularList& other) const {
+    return other < *this;
+}
+
+template <typename T, size_t N, FullPolicy Policy>
+bool StaticCircularList<T, N, Policy>::operator<=(
+    const StaticCircularList& other) const {
+    return !(other < *this);
+}
+
+template <typename T, size_t N, FullPolicy Policy>
+bool StaticCircularList<T, N, Policy>::operator>=(
+    const StaticCircularList& other) const {
+    return !(*this < other);
+}
+
+#endif
@@ -0,0 +1,466 @@
+#ifndef STRING_CIRCULAR_LIST_H
+#define STRING_CIRCULAR_LIST_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "CircularList.h"
+
+// Кольцевой список строк, символы которых лежат в одной кольцевой арене.
+// push_back дописывает символы за последней строкой, pop_front и pop_back
+// возвращают место в арене в порядке FIFO (или LIFO с хвоста), поэтому
+// очередь сообщений после разогрева не обращается к куче вовсе: и арена,
+// и кольцо описателей строк растут только при нехватке места.
+//
+// Строка всегда лежит в арене непрерывно: если она не помещается до
+// конца буфера, запись начинается с его начала, а хвост буфера
+// пропускается до снятия строки. Элементы отдаются как std::string_view;
+// представление действительно до удаления строки или до роста арены
+// (arena_capacity() изменилась). reserve() заранее выделяет место.
+class StringCircularList {
+    private:
+        static constexpr size_t kMinArenaSize = 256;
+
+        struct Entry {
+                size_t offset;
+                size_t length;
+        };
+
+        std::unique_ptr<char[]> arena;
+        size_t arena_size;  // ёмкость арены в байтах
+        size_t arena_head;  // начало первой строки
+        size_t arena_used;  // занятые байты от arena_head, включая пропуски
+        std::unique_ptr<Entry[]> entries;  // кольцо описателей
+        size_t entries_size;               // степень двойки или 0
+        size_t first;
+        size_t count;
+
+        const Entry& entry(size_t index) const;
+        // Место под строку из length байт; false - свободного места нет
+        bool place(size_t length, size_t& offset) const;
+        // Перенос живых строк в новые буферы, начиная с нулевых позиций;
+        // возвращает старую арену
+        std::unique_ptr<char[]> reallocate(size_t new_arena_size,
+                                           size_t new_entries_size);
+
+    public:
+        class const_iterator;
+        using iterator = const_iterator;
+        using value_type = std::string_view;
+
+        // Конструкторы
+        StringCircularList();
+        explicit StringCircularList(const CircularList<std::string>& list);
+        StringCircularList(const StringCircularList& other);
+        StringCircularList(StringCircularList&& other) noexcept;
+
+        // Операторы присваивания
+        StringCircularList& operator=(const StringCircularList& other);
+        StringCircularList& operator=(StringCircularList&& other) noexcept;
+
+        // Итераторы
+        const_iterator begin() const;
+        const_iterator end() const;
+        const_iterator cbegin() const;
+        const_iterator cend() const;
+
+        // f принимает std::string_view; если f возвращает bool, false
+        // прекращает обход
+        template <typename F>
+        void for_each(F f) const;
+
+        // Размер и проверка на пустоту
+        size_t size() const;
+        bool empty() const;
+        // Ёмкость арены и занятые в ней байты (с пропусками на стыке)
+        size_t arena_capacity() const;
+        size_t arena_bytes_used() const;
+
+        // Доступ к элементам
+        std::string_view front() const;
+        std::string_view back() const;
+        std::string_view operator[](size_t index) const;
+
+        // Модификаторы
+        // value может указывать в эту же арену
+        void push_back(std::string_view value);
+        void pop_front();
+        void pop_back();
+        void clear();
+        // Не меньше bytes байт арены и места под strings строк
+        void reserve(size_t bytes, size_t strings);
+        // Сдвиг начала кольца на n позиций вперёд (назад при n < 0);
+        // перенесённые строки копируются в конец арены
+        void rotate(std::ptrdiff_t n);
+        void swap(StringCircularList& other) noexcept;
+
+        CircularList<std::string> to_circular_list() const;
+
+        // Операторы сравнения
+        bool operator==(const StringCircularList& other) const;
+        bool operator!=(const StringCircularList& other) const;
+        bool operator<(const StringCircularList& other) const;
+        bool operator>(const StringCircularList& other) const;
+        bool operator<=(const StringCircularList& other) const;
+        bool operator>=(const StringCircularList& other) const;
+
+        class const_iterator {
+                const StringCircularList* list;
+                size_t index;
+
+            public:
+                using iterator_category = std::bidirectional_iterator_tag;
+                using value_type = std::string_view;
+                using difference_type = std::ptrdiff_t;
+                using pointer = void;
+                using reference = std::string_view;
+                const_iterator(const StringCircularList* l = nullptr,
+                               size_t i = 0);
+                std::string_view operator*() const;
+                const_iterator& operator++();
+                const_iterator& operator--();
+                bool operator==(const const_iterator& other) const;
+                bool operator!=(const const_iterator& other) const;
+        };
+};
+
+// Арена
+inline const StringCircularList::Entry& StringCircularList::entry(
+    size_t index) const {
+    return entries[(first + index) & (entries_size - 1)];
+}
+
+inline bool StringCircularList::place(size_t length, size_t& offset) const {
+    // Живые пустые строки держат arena_head, хотя байтов не занимают
+    if (count == 0) {
+        offset = 0;
+        return length <= arena_size;
+    }
+    size_t tail = arena_head + arena_used;
+    if (tail < arena_size) {
+        // Свободны [tail, arena_size) и [0, arena_head)
+        if (length <= arena_size - tail) {
+            offset = tail;
+            return true;
+        }
+        offset = 0;
+        return length <= arena_head;
+    }
+    // Занятая часть переходит через конец: свободно [tail, arena_head)
+    offset = tail - arena_size;
+    return length <= arena_head - offset;
+}
+
+inline std::unique_ptr<char[]> StringCircularList::reallocate(
+    size_t new_arena_size, size_t new_entries_size) {
+    new_arena_size = std::max(new_arena_size, kMinArenaSize);
+    auto new_arena = std::make_unique<char[]>(new_arena_size);
+    auto new_entries = std::make_unique<Entry[]>(new_entries_size);
+    size_t offset = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const Entry& old = entry(i);
+        if (old.length > 0)
+            std::memcpy(new_arena.get() + offset, arena.get() + old.offset,
+                        old.length);
+        new_entries[i] = Entry{offset, old.length};
+        offset += old.length;
+    }
+    std::swap(arena, new_arena);
+    entries = std::move(new_entries);
+    arena_size = new_arena_size;
+    entries_size = new_entries_size;
+    arena_head = 0;
+    arena_used = offset;
+    first = 0;
+    return new_arena;
+}
+
+// Конструкторы
+inline StringCircularList::StringCircularList()
+    : arena_size(0), arena_head(0), arena_used(0), entries_size(0), first(0),
+      count(0) {
+}
+
+inline StringCircularList::StringCircularList(
+    const CircularList<std::string>& list)
+    : StringCircularList() {
+    size_t bytes = 0;
+    list.for_each(
+        [&bytes](const std::string& value) { bytes += value.size(); });
+    reserve(bytes, list.size());
+    list.for_each([this](const std::string& value) { push_back(value); });
+}
+
+inline StringCircularList::StringCircularList(const StringCircularList& other)
+    : StringCircularList() {
+    reserve(other.arena_used, other.count);
+    other.for_each([this](std::string_view value) { push_back(value); });
+}
+
+inline StringCircularList::StringCircularList(
+    StringCircularList&& other) noexcept
+    : StringCircularList() {
+    swap(other);
+}
+
+// Операторы присваивания
+inline StringCircularList& StringCircularList::operator=(
+    const StringCircularList& other) {
+    if (this != &other) {
+        StringCircularList temp(other);
+        swap(temp);
+    }
+    return *this;
+}
+
+inline StringCircularList& StringCircularList::operator=(
+    StringCircularList&& other) noexcept {
+    if (this != &other) {
+        StringCircularList temp(std::move(other));
+        swap(temp);
+    }
+    return *this;
+}
+
+// Итераторы
+inline StringCircularList::const_iterator StringCircularList::begin() const {
+    return const_iterator(this, 0);
+}
+
+inline StringCircularList::const_iterator StringCircularList::end() const {
+    return const_iterator(this, count);
+}
+
+inline StringCircularList::const_iterator StringCircularList::cbegin() const {
+    return begin();
+}
+
+inline StringCircularList::const_iterator StringCircularList::cend() const {
+    return end();
+}
+
+inline StringCircularList::const_iterator::const_iterator(
+    const StringCircularList* l, size_t i)
+    : list(l), index(i) {
+}
+
+inline std::string_view StringCircularList::const_iterator::operator*() const {
+    return (*list)[index];
+}
+
+inline StringCircularList::const_iterator&
+StringCircularList::const_iterator::operator++() {
+    ++index;
+    return *this;
+}
+
+inline StringCircularList::const_iterator&
+StringCircularList::const_iterator::operator--() {
+    --index;
+    return *this;
+}
+
+inline bool StringCircularList::const_iterator::operator==(
+    const const_iterator& other) const {
+    return index == other.index;
+}
+
+inline bool StringCircularList::const_iterator::operator!=(
+    const const_iterator& other) const {
+    return index != other.index;
+}
+
+template <typename F>
+void StringCircularList::for_each(F f) const {
+    for (size_t i = 0; i < count; ++i) {
+        const Entry& e = entry(i);
+        std::string_view value(arena.get() + e.offset, e.length);
+        if constexpr (std::is_same_v<std::invoke_result_t<F&, std::string_view>,
+                                     bool>) {
+            if (!f(value)) return;
+        } else {
+            f(value);
+        }
+    }
+}
+
+// Размер и проверка на пустоту
+inline size_t StringCircularList::size() const {
+    return count;
+}
+
+inline bool StringCircularList::empty() const {
+    return count == 0;
+}
+
+inline size_t StringCircularList::arena_capacity() const {
+    return arena_size;
+}
+
+inline size_t StringCircularList::arena_bytes_used() const {
+    return arena_used;
+}
+
+// Доступ к элементам
+inline std::string_view StringCircularList::front() const {
+    if (empty())
+        throw std::out_of_range("StringCircularList::front: empty list");
+    return (*this)[0];
+}
+
+inline std::string_view StringCircularList::back() const {
+    if (empty())
+        throw std::out_of_range("StringCircularList::back: empty list");
+    return (*this)[count - 1];
+}
+
+inline std::string_view StringCircularList::operator[](size_t index) const {
+    if (index >= count)
+        throw std::out_of_range("StringCircularList::operator[]: bad index");
+    const Entry& e = entry(index);
+    return std::string_view(arena.get() + e.offset, e.length);
+}
+
+// Модификаторы
+inline void StringCircularList::push_back(std::string_view value) {
+    size_t offset = 0;
+    bool fits = place(value.size(), offset);
+    // Старая арена живёт до конца функции: value может лежать в ней
+    std::unique_ptr<char[]> old_arena;
+    if (!fits || count == entries_size) {
+        // Живые строки переносятся подряд, так что хватит их суммы
+        size_t new_arena_size =
+            fits ? arena_size
+                 : std::max(arena_size * 2, arena_used + value.size());
+        size_t new_entries_size =
+            count == entries_size ? std::max<size_t>(entries_size * 2, 16)
+                                  : entries_size;
+        old_arena = reallocate(new_arena_size, new_entries_size);
+        place(value.size(), offset);
+    }
+    if (!value.empty())
+        std::memcpy(arena.get() + offset, value.data(), value.size());
+    if (count == 0) {
+        arena_head = offset;
+    } else {
+        // Пропуск в конце буфера, если строка начата с его начала
+        size_t tail = (arena_head + arena_used) % arena_size;
+        arena_used += (offset + arena_size - tail) % arena_size;
+    }
+    arena_used += value.size();
+    entries[(first + count) & (entries_size - 1)] =
+        Entry{offset, value.size()};
+    ++count;
+}
+
+inline void StringCircularList::pop_front() {
+    if (empty())
+        throw std::out_of_range("StringCircularList::pop_front: empty list");
+    const Entry& e = entry(0);
+    // Снимаются и пропуск перед строкой, и сама строка
+    size_t gap = (e.offset + arena_size - arena_head) % arena_size;
+    arena_used -= gap + e.length;
+    arena_head = (e.offset + e.length) % arena_size;
+    first = (first + 1) & (entries_size - 1);
+    if (--count == 0) clear();
+}
+
+inline void StringCircularList::pop_back() {
+    if (empty())
+        throw std::out_of_range("StringCircularList::pop_back: empty list");
+    if (count == 1) {
+        clear();
+        return;
+    }
+    const Entry& last = entry(count - 1);
+    const Entry& prev = entry(count - 2);
+    size_t prev_end = (prev.offset + prev.length) % arena_size;
+    size_t gap = (last.offset + arena_size - prev_end) % arena_size;
+    arena_used -= gap + last.length;
+    --count;
+}
+
+inline void StringCircularList::clear() {
+    arena_head = 0;
+    arena_used = 0;
+    first = 0;
+    count = 0;
+}
+
+inline void StringCircularList::reserve(size_t bytes, size_t strings) {
+    size_t new_entries_size = std::max<size_t>(entries_size, 16);
+    while (new_entries_size < strings) new_entries_size *= 2;
+    if (bytes <= arena_size && new_entries_size == entries_size) return;
+    reallocate(std::max(bytes, arena_size), new_entries_size);
+}
+
+inline void StringCircularList::rotate(std::ptrdiff_t n) {
+    if (count < 2) return;
+    auto size = static_cast<std::ptrdiff_t>(count);
+    std::ptrdiff_t steps = n % size;
+    if (steps < 0) steps += size;
+    for (std::ptrdiff_t i = 0; i < steps; ++i) {
+        push_back(front());
+        pop_front();
+    }
+}
+
+inline void StringCircularList::swap(StringCircularList& other) noexcept {
+    std::swap(arena, other.arena);
+    std::swap(arena_size, other.arena_size);
+    std::swap(arena_head, other.arena_head);
+    std::swap(arena_used, other.arena_used);
+    std::swap(entries, other.entries);
+    std::swap(entries_size, other.entries_size);
+    std::swap(first, other.first);
+    std::swap(count, other.count);
+}
+
+inline CircularList<std::string> StringCircularList::to_circular_list() const {
+    CircularList<std::string> list;
+    for_each([&list](std::string_view value) {
+        list.push_back(std::string(value));
+    });
+    return list;
+}
+
+// Операторы сравнения
+inline bool StringCircularList::operator==(
+    const StringCircularList& other) const {
+    return size() == other.size() && std::equal(begin(), end(), other.begin());
+}
+
+inline bool StringCircularList::operator!=(
+    const StringCircularList& other) const {
+    return !(*this == other);
+}
+
+inline bool StringCircularList::operator<(
+    const StringCircularList& other) const {
+    return std::lexicographical_compare(begin(), end(), other.begin(),
+                                        other.end());
+}
+
+inline bool StringCircularList::operator>(
+    const StringCircularList& other) const {
+    return other < *this;
+}
+
+inline bool StringCircularList::operator<=(
+    const StringCircularList& other) const {
+    return !(other < *this);
+}
+
+inline bool StringCircularList::operator>=(
+    const StringCircularList& other) const {
+    return !(*this < other);
+}
+
+#endif
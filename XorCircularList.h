@@ -0,0 +1,510 @@
+#ifndef XOR_CIRCULAR_LIST_H
+#define XOR_CIRCULAR_LIST_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+
+// Кольцевой двусвязный список, в узле которого вместо двух указателей
+// хранится одно слово link = prev ^ next. Соседа можно найти, только зная
+// другого соседа, поэтому итератор хранит пару (prev, cur). Любая вставка
+// или удаление делает недействительными все итераторы, кроме возвращённого.
+template <typename T>
+class XorCircularList {
+    private:
+        struct Node {
+                T data;
+                std::uintptr_t link;
+                Node(const T& value) : data(value), link(0) {}
+        };
+
+        static Node* other(const Node* node, const Node* neighbour);
+        static std::uintptr_t address(const Node* node);
+
+        Node* head;
+        Node* tail;
+        size_t count;
+
+        // Вставка узла между соседними prev и next
+        void link_between(Node* node, Node* prev, Node* next);
+        // Удаление узла cur, у которого соседи prev и next
+        void unlink(Node* prev, Node* cur, Node* next);
+
+    public:
+        // Размер узла: данные и одно связующее слово
+        static constexpr size_t node_size = sizeof(Node);
+
+        // Конструкторы
+        XorCircularList();
+        XorCircularList(const XorCircularList& other);
+        XorCircularList(XorCircularList&& other) noexcept;
+        ~XorCircularList();
+
+        // Операторы присваивания
+        XorCircularList& operator=(const XorCircularList& other);
+        XorCircularList& operator=(XorCircularList&& other) noexcept;
+
+        // Итераторы
+        class iterator;
+        class const_iterator;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+        iterator begin();
+        iterator end();
+        const_iterator begin() const;
+        const_iterator end() const;
+        const_iterator cbegin() const;
+        const_iterator cend() const;
+        reverse_iterator rbegin();
+        reverse_iterator rend();
+        const_reverse_iterator rbegin() const;
+        const_reverse_iterator rend() const;
+
+        // Размер и проверка на пустоту
+        size_t size() const;
+        bool empty() const;
+
+        // Доступ к элементам
+        T& front();
+        const T& front() const;
+        T& back();
+        const T& back() const;
+
+        // Модификаторы
+        void push_back(const T& value);
+        void push_front(const T& value);
+        void pop_back();
+        void pop_front();
+        void clear();
+        iterator insert(iterator pos, const T& value);
+        iterator erase(iterator pos);
+        void swap(XorCircularList& other) noexcept;
+
+        // Операторы сравнения
+        bool operator==(const XorCircularList& other) const;
+        bool operator!=(const XorCircularList& other) const;
+
+        // Итератор хранит текущий узел и предыдущий; end() - это (tail,
+        // nullptr), а head нужен, чтобы опознать конец кольца
+        class iterator {
+                Node* prev;
+                Node* node;
+                Node* head;
+
+            public:
+                using iterator_category = std::bidirectional_iterator_tag;
+                using value_type = T;
+                using difference_type = std::ptrdiff_t;
+                using pointer = T*;
+                using reference = T&;
+                iterator(Node* p = nullptr, Node* n = nullptr,
+                         Node* h = nullptr);
+                T& operator*() const;
+                iterator& operator++();
+                iterator& operator--();
+                bool operator==(const iterator& other) const;
+                bool operator!=(const iterator& other) const;
+                friend class XorCircularList;
+        };
+
+        class const_iterator {
+                const Node* prev;
+                const Node* node;
+                const Node* head;
+
+            public:
+                using iterator_category = std::bidirectional_iterator_tag;
+                using value_type = T;
+                using difference_type = std::ptrdiff_t;
+                using pointer = const T*;
+                using reference = const T&;
+                const_iterator(const Node* p = nullptr, const Node* n = nullptr,
+                               const Node* h = nullptr);
+                const T& operator*() const;
+                const_iterator& operator++();
+                const_iterator& operator--();
+                bool operator==(const const_iterator& other) const;
+                bool operator!=(const const_iterator& other) const;
+                friend class XorCircularList;
+        };
+};
+
+template <typename T>
+typename XorCircularList<T>::Node* XorCircularList<T>::other(
+    const Node* node, const Node* neighbour) {
+    return reinterpret_cast<Node*>(node->link ^ address(neighbour));
+}
+
+template <typename T>
+std::uintptr_t XorCircularList<T>::address(const Node* node) {
+    return reinterpret_cast<std::uintptr_t>(node);
+}
+
+// Конструкторы
+template <typename T>
+XorCircularList<T>::XorCircularList() : head(nullptr), tail(nullptr), count(0) {
+}
+
+template <typename T>
+XorCircularList<T>::XorCircularList(const XorCircularList& other)
+    : head(nullptr), tail(nullptr), count(0) {
+    try {
+        for (const T& value : other) push_back(value);
+    } catch (...) {
+        clear();
+        throw;
+    }
+}
+
+template <typename T>
+XorCircularList<T>::XorCircularList(XorCircularList&& other) noexcept
+    : head(other.head), tail(other.tail), count(other.count) {
+    other.head = nullptr;
+    other.tail = nullptr;
+    other.count = 0;
+}
+
+template <typename T>
+XorCircularList<T>::~XorCircularList() {
+    clear();
+}
+
+// Операторы присваивания
+template <typename T>
+XorCircularList<T>& XorCircularList<T>::operator=(
+    const XorCircularList& other) {
+    if (this != &other) {
+        XorCircularList temp(other);
+        swap(temp);
+    }
+    return *this;
+}
+
+template <typename T>
+XorCircularList<T>& XorCircularList<T>::operator=(
+    XorCircularList&& other) noexcept {
+    if (this != &other) {
+        clear();
+        swap(other);
+    }
+    return *this;
+}
+
+// Итераторы
+template <typename T>
+typename XorCircularList<T>::iterator XorCircularList<T>::begin() {
+    return iterator(tail, head, head);
+}
+
+template <typename T>
+typename XorCircularList<T>::iterator XorCircularList<T>::end() {
+    return iterator(tail, nullptr, head);
+}
+
+template <typename T>
+typename XorCircularList<T>::const_iterator XorCircularList<T>::begin() const {
+    return const_iterator(tail, head, head);
+}
+
+template <typename T>
+typename XorCircularList<T>::const_iterator XorCircularList<T>::end() const {
+    return const_iterator(tail, nullptr, head);
+}
+
+template <typename T>
+typename XorCircularList<T>::const_iterator XorCircularList<T>::cbegin()
+    const {
+    return begin();
+}
+
+template <typename T>
+typename XorCircularList<T>::const_iterator XorCircularList<T>::cend() const {
+    return end();
+}
+
+template <typename T>
+typename XorCircularList<T>::reverse_iterator XorCircularList<T>::rbegin() {
+    return reverse_iterator(end());
+}
+
+template <typename T>
+typename XorCircularList<T>::reverse_iterator XorCircularList<T>::rend() {
+    return reverse_iterator(begin());
+}
+
+template <typename T>
+typename XorCircularList<T>::const_reverse_iterator XorCircularList<T>::rbegin()
+    const {
+    return const_reverse_iterator(end());
+}
+
+template <typename T>
+typename XorCircularList<T>::const_reverse_iterator XorCircularList<T>::rend()
+    const {
+    return const_reverse_iterator(begin());
+}
+
+template <typename T>
+XorCircularList<T>::iterator::iterator(Node* p, Node* n, Node* h)
+    : prev(p), node(n), head(h) {
+}
+
+template <typename T>
+T& XorCircularList<T>::iterator::operator*() const {
+    if (!node)
+        throw std::out_of_range(
+            "XorCircularList::iterator::operator*: dereferencing end "
+            "iterator");
+    return node->data;
+}
+
+template <typename T>
+typename XorCircularList<T>::iterator&
+XorCircularList<T>::iterator::operator++() {
+    if (!node)
+        throw std::out_of_range(
+            "XorCircularList::iterator::operator++: incrementing end "
+            "iterator");
+    Node* next = other(node, prev);
+    prev = node;
+    node = next == head ? nullptr : next;
+    return *this;
+}
+
+template <typename T>
+typename XorCircularList<T>::iterator&
+XorCircularList<T>::iterator::operator--() {
+    if (!head)
+        throw std::out_of_range(
+            "XorCircularList::iterator::operator--: no list");
+    Node* before = other(prev, node ? node : head);
+    node = prev;
+    prev = before;
+    return *this;
+}
+
+template <typename T>
+bool XorCircularList<T>::iterator::operator==(const iterator& other) const {
+    return node == other.node;
+}
+
+template <typename T>
+bool XorCircularList<T>::iterator::operator!=(const iterator& other) const {
+    return node != other.node;
+}
+
+template <typename T>
+XorCircularList<T>::const_iterator::const_iterator(const Node* p,
+                                                   const Node* n,
+                                                   const Node* h)
+    : prev(p), node(n), head(h) {
+}
+
+template <typename T>
+const T& XorCircularList<T>::const_iterator::operator*() const {
+    if (!node)
+        throw std::out_of_range(
+            "XorCircularList::const_iterator::operator*: dereferencing end "
+            "iterator");
+    return node->data;
+}
+
+template <typename T>
+typename XorCircularList<T>::const_iterator&
+XorCircularList<T>::const_iterator::operator++() {
+    if (!node)
+        throw std::out_of_range(
+            "XorCircularList::const_iterator::operator++: incrementing end "
+            "iterator");
+    const Node* next = other(node, prev);
+    prev = node;
+    node = next == head ? nullptr : next;
+    return *this;
+}
+
+template <typename T>
+typename XorCircularList<T>::const_iterator&
+XorCircularList<T>::const_iterator::operator--() {
+    if (!head)
+        throw std::out_of_range(
+            "XorCircularList::const_iterator::operator--: no list");
+    const Node* before = other(prev, node ? node : head);
+    node = prev;
+    prev = before;
+    return *this;
+}
+
+template <typename T>
+bool XorCircularList<T>::const_iterator::operator==(
+    const const_iterator& other) const {
+    return node == other.node;
+}
+
+template <typename T>
+bool XorCircularList<T>::const_iterator::operator!=(
+    const const_iterator& other) const {
+    return node != other.node;
+}
+
+// Размер и проверка на пустоту
+template <typename T>
+size_t XorCircularList<T>::size() const {
+    return count;
+}
+
+template <typename T>
+bool XorCircularList<T>::empty() const {
+    return count == 0;
+}
+
+// Доступ к элементам
+template <typename T>
+T& XorCircularList<T>::front() {
+    if (empty()) throw std::out_of_range("XorCircularList::front: empty list");
+    return head->data;
+}
+
+template <typename T>
+const T& XorCircularList<T>::front() const {
+    if (empty()) throw std::out_of_range("XorCircularList::front: empty list");
+    return head->data;
+}
+
+template <typename T>
+T& XorCircularList<T>::back() {
+    if (empty()) throw std::out_of_range("XorCircularList::back: empty list");
+    return tail->data;
+}
+
+template <typename T>
+const T& XorCircularList<T>::back() const {
+    if (empty()) throw std::out_of_range("XorCircularList::back: empty list");
+    return tail->data;
+}
+
+// Модификаторы
+template <typename T>
+void XorCircularList<T>::link_between(Node* node, Node* prev, Node* next) {
+    node->link = address(prev) ^ address(next);
+    // При prev == next (кольцо из одного узла) обе поправки применяются к
+    // одному слову и дают правильный результат
+    prev->link ^= address(next) ^ address(node);
+    next->link ^= address(prev) ^ address(node);
+}
+
+template <typename T>
+void XorCircularList<T>::unlink(Node* prev, Node* cur, Node* next) {
+    prev->link ^= address(cur) ^ address(next);
+    next->link ^= address(cur) ^ address(prev);
+}
+
+template <typename T>
+void XorCircularList<T>::push_back(const T& value) {
+    Node* node = new Node(value);
+    if (!head) {
+        head = tail = node;
+    } else {
+        link_between(node, tail, head);
+        tail = node;
+    }
+    ++count;
+}
+
+template <typename T>
+void XorCircularList<T>::push_front(const T& value) {
+    Node* old_head = head;
+    push_back(value);
+    if (old_head) {
+        // Новый узел встал между старыми хвостом и головой
+        head = tail;
+        tail = other(head, old_head);
+    }
+}
+
+template <typename T>
+void XorCircularList<T>::pop_back() {
+    if (empty())
+        throw std::out_of_range("XorCircularList::pop_back: empty list");
+    erase(--end());
+}
+
+template <typename T>
+void XorCircularList<T>::pop_front() {
+    if (empty())
+        throw std::out_of_range("XorCircularList::pop_front: empty list");
+    erase(begin());
+}
+
+template <typename T>
+void XorCircularList<T>::clear() {
+    Node* prev = tail;
+    Node* current = head;
+    for (size_t i = 0; i < count; ++i) {
+        Node* next = other(current, prev);
+        prev = current;
+        delete current;
+        current = next;
+    }
+    head = tail = nullptr;
+    count = 0;
+}
+
+template <typename T>
+typename XorCircularList<T>::iterator XorCircularList<T>::insert(
+    iterator pos, const T& value) {
+    if (pos.node == nullptr || head == nullptr) {
+        push_back(value);
+        return iterator(other(tail, head), tail, head);
+    }
+    Node* node = new Node(value);
+    link_between(node, pos.prev, pos.node);
+    if (pos.node == head) head = node;
+    ++count;
+    return iterator(pos.prev, node, head);
+}
+
+template <typename T>
+typename XorCircularList<T>::iterator XorCircularList<T>::erase(
+    iterator pos) {
+    if (empty()) throw std::out_of_range("XorCircularList::erase: empty list");
+    if (pos.node == nullptr)
+        throw std::invalid_argument("XorCircularList::erase: invalid iterator");
+    Node* prev = pos.prev;
+    Node* node = pos.node;
+    Node* next = other(node, prev);
+    bool was_tail = node == tail;
+    if (count == 1) {
+        head = tail = nullptr;
+    } else {
+        unlink(prev, node, next);
+        if (node == head) head = next;
+        if (was_tail) tail = prev;
+    }
+    delete node;
+    --count;
+    if (was_tail) return end();
+    return iterator(prev, next, head);
+}
+
+template <typename T>
+void XorCircularList<T>::swap(XorCircularList& other) noexcept {
+    std::swap(head, other.head);
+    std::swap(tail, other.tail);
+    std::swap(count, other.count);
+}
+
+// Операторы сравнения
+template <typename T>
+bool XorCircularList<T>::operator==(const XorCircularList& other) const {
+    return size() == other.size() && std::equal(begin(), end(), other.begin());
+}
+
+template <typename T>
+bool XorCircularList<T>::operator!=(const XorCircularList& other) const {
+    return !(*this == other);
+}
+
+#endif
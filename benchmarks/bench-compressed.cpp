@@ -0,0 +1,65 @@
+/* Platon Lukyanov st128133@student.spbu.ru
+ * Problem 7
+ */
+#include <malloc.h>
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "CircularList.h"
+#include "CompressedCircularList.h"
+#include "bench.h"
+
+namespace {
+
+constexpr size_t kElements = 1 << 20;
+
+// Отметки времени в наносекундах с шагом около 1 мс и дрожанием
+std::vector<uint64_t> make_timestamps() {
+    std::mt19937 random(72);
+    std::vector<uint64_t> result;
+    uint64_t now = 1700000000000000000ull;
+    for (size_t i = 0; i < kElements; ++i) {
+        now += 1000000 + random() % 64;
+        result.push_back(now);
+    }
+    return result;
+}
+
+template <typename List>
+void run(const std::string& name, const std::vector<uint64_t>& timestamps) {
+    size_t before = mallinfo2().uordblks;
+    List list;
+    for (uint64_t value : timestamps) list.push_back(value);
+    size_t after = mallinfo2().uordblks;
+    std::printf("%-48s %10.2f bytes/elem\n", (name + "/heap").c_str(),
+                double(after - before) / double(kElements));
+
+    bench_report((name + "/push_back").c_str(), bench_ns_per_item([&] {
+                     List tmp;
+                     for (uint64_t value : timestamps) tmp.push_back(value);
+                     do_not_optimize(tmp.size());
+                 }, kElements));
+    bench_report((name + "/traversal").c_str(), bench_ns_per_item([&] {
+                     uint64_t sum = 0;
+                     for (uint64_t value : list) sum += value;
+                     do_not_optimize(sum);
+                 }, kElements));
+    bench_report((name + "/push_back+pop_front").c_str(),
+                 bench_ns_per_item([&] {
+                     for (uint64_t value : timestamps) {
+                         list.push_back(value);
+                         list.pop_front();
+                     }
+                 }, kElements));
+}
+
+}  // namespace
+
+int main() {
+    std::vector<uint64_t> timestamps = make_timestamps();
+    run<CircularList<uint64_t>>("CircularList<uint64_t>", timestamps);
+    run<CompressedCircularList<uint64_t>>("Compressed<uint64_t>", timestamps);
+}
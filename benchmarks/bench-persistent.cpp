@@ -0,0 +1,58 @@
+/* Platon Lukyanov st128133@student.spbu.ru
+ * Problem 7
+ */
+#include "CircularList.h"
+#include "PersistentCircularList.h"
+#include "bench.h"
+
+namespace {
+
+constexpr size_t kSize = 1 << 16;
+constexpr size_t kSnapshots = 256;
+
+CircularList<int> make_source() {
+    CircularList<int> list;
+    for (size_t i = 0; i < kSize; ++i) list.push_back(int(i));
+    return list;
+}
+
+// Снимок и одно изменение: копия CircularList против новой версии
+void copy_and_update(const CircularList<int>& source) {
+    for (size_t i = 0; i < kSnapshots; ++i) {
+        CircularList<int> snapshot(source);
+        snapshot.push_back(int(i));
+        do_not_optimize(snapshot.back());
+    }
+}
+
+void snapshot_and_update(const PersistentCircularList<int>& source) {
+    for (size_t i = 0; i < kSnapshots; ++i) {
+        PersistentCircularList<int> snapshot = source;
+        snapshot = snapshot.set(i * 97 % kSize, int(i)).push_back(int(i));
+        do_not_optimize(snapshot.back());
+    }
+}
+
+template <typename List>
+void traverse(const List& list) {
+    long sum = 0;
+    list.for_each([&sum](int value) { sum += value; });
+    do_not_optimize(sum);
+}
+
+}  // namespace
+
+int main() {
+    const CircularList<int> source = make_source();
+    const PersistentCircularList<int> persistent(source);
+    bench_report("snapshot+update/CircularList copy",
+                 bench_ns_per_item([&] { copy_and_update(source); },
+                                   kSnapshots));
+    bench_report("snapshot+update/PersistentCircularList",
+                 bench_ns_per_item([&] { snapshot_and_update(persistent); },
+                                   kSnapshots));
+    bench_report("traversal/CircularList",
+                 bench_ns_per_item([&] { traverse(source); }, kSize));
+    bench_report("traversal/PersistentCircularList",
+                 bench_ns_per_item([&] { traverse(persistent); }, kSize));
+}
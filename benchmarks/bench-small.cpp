@@ -0,0 +1,33 @@
+/* Platon Lukyanov st128133@student.spbu.ru
+ * Problem 7
+ */
+#include "CircularList.h"
+#include "SmallCircularList.h"
+#include "bench.h"
+
+namespace {
+
+constexpr size_t kRings = 1 << 20;
+constexpr int kRingSize = 6;
+
+template <typename List>
+void churn_tiny_rings() {
+    for (size_t i = 0; i < kRings; ++i) {
+        List ring;
+        for (int j = 0; j < kRingSize; ++j) ring.push_back(j);
+        ring.pop_front();
+        ring.push_back(kRingSize);
+        do_not_optimize(ring.back());
+    }
+}
+
+}  // namespace
+
+int main() {
+    bench_report("tiny rings/CircularList<int>",
+                 bench_ns_per_item(churn_tiny_rings<CircularList<int>>,
+                                   kRings));
+    bench_report("tiny rings/SmallCircularList<int, 8>",
+                 bench_ns_per_item(churn_tiny_rings<SmallCircularList<int, 8>>,
+                                   kRings));
+}
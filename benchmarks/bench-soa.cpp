@@ -0,0 +1,79 @@
+/* Platon Lukyanov st128133@student.spbu.ru
+ * Problem 7
+ */
+#include <cstdint>
+#include <span>
+
+#include "CircularList.h"
+#include "SoaCircularList.h"
+#include "bench.h"
+
+namespace {
+
+constexpr size_t kElements = 1 << 20;
+
+struct Sample {
+        int64_t timestamp;
+        double value;
+        uint8_t flags;
+        bool operator!=(const Sample& other) const {
+            return timestamp != other.timestamp || value != other.value ||
+                   flags != other.flags;
+        }
+};
+
+}  // namespace
+
+int main() {
+    CircularList<Sample> rows;
+    SoaCircularList<int64_t, double, uint8_t> columns;
+    for (size_t i = 0; i < kElements; ++i) {
+        Sample sample{int64_t(i), double(i % 1000) / 8, uint8_t(i % 3)};
+        rows.push_back(sample);
+        columns.push_back(sample.timestamp, sample.value, sample.flags);
+    }
+    // Лучший случай для узлового списка: узлы подряд в памяти
+    rows.compact();
+
+    bench_report("sum value/CircularList<Sample>", bench_ns_per_item([&] {
+                     double sum = 0;
+                     rows.for_each([&](const Sample& s) { sum += s.value; });
+                     do_not_optimize(sum);
+                 }, kElements));
+    bench_report("sum value/SoaCircularList", bench_ns_per_item([&] {
+                     double sum = 0;
+                     columns.for_each_segment<1>(
+                         [&](std::span<const double> segment) {
+                             for (double v : segment) sum += v;
+                         });
+                     do_not_optimize(sum);
+                 }, kElements));
+    bench_report("count flags/CircularList<Sample>", bench_ns_per_item([&] {
+                     size_t flagged = 0;
+                     rows.for_each(
+                         [&](const Sample& s) { flagged += s.flags == 1; });
+                     do_not_optimize(flagged);
+                 }, kElements));
+    bench_report("count flags/SoaCircularList", bench_ns_per_item([&] {
+                     size_t flagged = 0;
+                     columns.for_each_segment<2>(
+                         [&](std::span<const uint8_t> segment) {
+                             for (uint8_t f : segment) flagged += f == 1;
+                         });
+                     do_not_optimize(flagged);
+                 }, kElements));
+    bench_report("push_back+pop_front/CircularList<Sample>",
+                 bench_ns_per_item([&] {
+                     for (size_t i = 0; i < kElements; ++i) {
+                         rows.push_back({int64_t(i), 0, 0});
+                         rows.pop_front();
+                     }
+                 }, kElements));
+    bench_report("push_back+pop_front/SoaCircularList",
+                 bench_ns_per_item([&] {
+                     for (size_t i = 0; i < kElements; ++i) {
+                         columns.push_back(int64_t(i), 0, 0);
+                         columns.pop_front();
+                     }
+                 }, kElements));
+}
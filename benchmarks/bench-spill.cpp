@@ -0,0 +1,62 @@
+/* Platon Lukyanov st128133@student.spbu.ru
+ * Problem 7
+ */
+#include <malloc.h>
+
+#include <algorithm>
+#include <cstdio>
+
+#include "CircularList.h"
+#include "SpillCircularList.h"
+#include "bench.h"
+
+namespace {
+
+// Отставший потребитель: 2^21 записей по 64 байта (128 МиБ) в очереди
+constexpr size_t kElements = 1 << 21;
+constexpr size_t kBudget = 8 << 20;
+
+struct Record {
+        long id;
+        char body[56];
+        bool operator!=(const Record& other) const {
+            return id != other.id;
+        }
+};
+
+// Наполнение очереди и её разбор; рост кучи считается от before, снятого
+// до создания списка
+template <typename List>
+void run(const char* name, List& list, size_t before) {
+    size_t peak = 0;
+    double ns = bench_ns_per_item([&] {
+        for (size_t i = 0; i < kElements; ++i) list.push_back({long(i), {}});
+        peak = std::max(peak, mallinfo2().uordblks - before);
+        long sum = 0;
+        while (!list.empty()) {
+            sum += list.front().id;
+            list.pop_front();
+        }
+        do_not_optimize(sum);
+    }, kElements, 3);
+    bench_report(name, ns);
+    std::printf("%-48s %10.2f MiB\n", "  peak heap", double(peak) / (1 << 20));
+}
+
+}  // namespace
+
+int main() {
+    size_t before = mallinfo2().uordblks;
+    CircularList<Record> in_memory;
+    run("fill+drain/CircularList<Record>", in_memory, before);
+
+    before = mallinfo2().uordblks;
+    SpillCircularList<Record> spilling(kBudget);
+    run("fill+drain/SpillCircularList<Record>", spilling, before);
+    const SpillStats& stats = spilling.stats();
+    std::printf("%-48s %10.2f MiB/s\n", "  spill bandwidth",
+                stats.spill_bandwidth() / (1 << 20));
+    std::printf("%-48s %10.2f MiB/s\n", "  read back bandwidth",
+                stats.read_back_bandwidth() / (1 << 20));
+    std::printf("%-48s %10zu\n", "  segments", stats.segments);
+}
@@ -0,0 +1,92 @@
+/* Platon Lukyanov st128133@student.spbu.ru
+ * Problem 7
+ */
+#include <array>
+#include <iterator>
+
+#include "CircularList.h"
+#include "SplitCircularList.h"
+#include "bench.h"
+
+namespace {
+
+constexpr size_t kElements = 1 << 18;
+
+// 200-байтная запись с ключом в начале
+struct Record {
+        long id;
+        std::array<char, 192> body;
+        bool operator!=(const Record& other) const {
+            return id != other.id || body != other.body;
+        }
+};
+
+struct RecordId {
+        long operator()(const Record& record) const {
+            return record.id;
+        }
+};
+
+template <typename List>
+List make_list() {
+    List list;
+    for (size_t i = 0; i < kElements; ++i) list.push_back({long(i), {}});
+    return list;
+}
+
+}  // namespace
+
+int main() {
+    using Split = SplitCircularList<Record, RecordId>;
+    auto inline_list = make_list<CircularList<Record>>();
+    auto split_list = make_list<Split>();
+    const long last = long(kElements) - 1;
+
+    bench_report("find key/CircularList", bench_ns_per_item([&] {
+                     auto it = inline_list.begin();
+                     while (it != inline_list.end() && (*it).id != last) ++it;
+                     do_not_optimize(it);
+                 }, kElements));
+    bench_report("find key/SplitCircularList", bench_ns_per_item([&] {
+                     auto it = split_list.find(last);
+                     do_not_optimize(it);
+                 }, kElements));
+
+    // Сдвиг на половину кольца проходит kElements / 2 связей
+    bench_report("rotate/CircularList", bench_ns_per_item([&] {
+                     inline_list.rotate(std::ptrdiff_t(kElements / 2));
+                     do_not_optimize(inline_list.front().id);
+                 }, kElements / 2));
+    bench_report("rotate/SplitCircularList", bench_ns_per_item([&] {
+                     split_list.rotate(std::ptrdiff_t(kElements / 2));
+                     do_not_optimize(split_list.front().id);
+                 }, kElements / 2));
+
+    bench_report("skip n/2/CircularList", bench_ns_per_item([&] {
+                     auto it =
+                         std::next(inline_list.begin(), kElements / 2);
+                     do_not_optimize(it);
+                 }, kElements / 2));
+    bench_report("skip n/2/SplitCircularList", bench_ns_per_item([&] {
+                     auto it = split_list.nth(kElements / 2);
+                     do_not_optimize(it);
+                 }, kElements / 2));
+    bench_report("index_of/SplitCircularList", bench_ns_per_item([&] {
+                     size_t index = split_list.index_of(--split_list.end());
+                     do_not_optimize(index);
+                 }, kElements));
+
+    // Обход с чтением значений
+    bench_report("read payload/CircularList", bench_ns_per_item([&] {
+                     long sum = 0;
+                     inline_list.for_each(
+                         [&](const Record& record) { sum += record.body[0]; });
+                     do_not_optimize(sum);
+                 }, kElements));
+    bench_report("read payload/SplitCircularList", bench_ns_per_item([&] {
+                     long sum = 0;
+                     split_list.for_each(
+                         [&](const Record& record) { sum += record.body[0]; });
+                     do_not_optimize(sum);
+                 }, kElements));
+}
@@ -0,0 +1,66 @@
+/* Platon Lukyanov st128133@student.spbu.ru
+ * Problem 7
+ */
+#include <malloc.h>
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "CircularList.h"
+#include "StringCircularList.h"
+#include "bench.h"
+
+namespace {
+
+constexpr size_t kMessages = 1 << 18;
+constexpr size_t kWindow = 4096;
+
+// Строки журнала длиной от 40 до 200 символов
+std::vector<std::string> make_messages() {
+    std::mt19937 random(73);
+    std::vector<std::string> result;
+    for (size_t i = 0; i < kMessages; ++i) {
+        std::string message = "2024-01-01T00:00:00Z INFO worker-" +
+                              std::to_string(random() % 64) + " request ";
+        message.resize(40 + random() % 160, 'x');
+        result.push_back(message);
+    }
+    return result;
+}
+
+// Очередь окна из kWindow последних сообщений
+template <typename List>
+void run(const char* name, const std::vector<std::string>& messages) {
+    List list;
+    for (size_t i = 0; i < kWindow; ++i) list.push_back(messages[i]);
+    // Разогрев: буферы списка достигают рабочего размера
+    for (const std::string& message : messages) {
+        list.push_back(message);
+        list.pop_front();
+    }
+    size_t before = mallinfo2().uordblks;
+    size_t calls = 0;
+    bench_report(name, bench_ns_per_item([&] {
+                     for (const std::string& message : messages) {
+                         list.push_back(message);
+                         list.pop_front();
+                     }
+                     ++calls;
+                 }, kMessages));
+    size_t after = mallinfo2().uordblks;
+    std::printf("%-48s %10zd bytes after %zu passes\n",
+                (std::string(name) + "/heap growth").c_str(),
+                std::ptrdiff_t(after - before), calls);
+}
+
+}  // namespace
+
+int main() {
+    std::vector<std::string> messages = make_messages();
+    run<CircularList<std::string>>("push_back+pop_front/CircularList<string>",
+                                   messages);
+    run<StringCircularList>("push_back+pop_front/StringCircularList",
+                            messages);
+}
@@ -0,0 +1,101 @@
+/* Platon Lukyanov st128133@student.spbu.ru
+ * Problem 7
+ */
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "CircularList.h"
+#include "bench.h"
+
+namespace {
+
+constexpr size_t kElements = 1 << 20;
+
+// Список, узлы которого разбросаны по куче: перед заполнением освобождаем
+// блоки того же размера в случайном порядке, и аллокатор выдаёт их вразнобой
+CircularList<long> make_scattered_list(size_t n) {
+    std::vector<std::unique_ptr<CircularList<long>>> holes;
+    holes.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        holes.push_back(std::make_unique<CircularList<long>>());
+        holes.back()->push_back(0);
+    }
+    std::shuffle(holes.begin(), holes.end(), std::mt19937(42));
+    holes.clear();
+
+    CircularList<long> list;
+    for (size_t i = 0; i < n; ++i) list.push_back(long(i));
+    return list;
+}
+
+}  // namespace
+
+int main() {
+    CircularList<long> list = make_scattered_list(kElements);
+    CircularList<long> copy(list);
+
+    bench_report("traversal/iterator", bench_ns_per_item([&] {
+                     long sum = 0;
+                     for (long value : list) sum += value;
+                     do_not_optimize(sum);
+                 }, kElements));
+    bench_report("traversal/reverse_iterator", bench_ns_per_item([&] {
+                     long sum = 0;
+                     for (auto it = list.rbegin(); it != list.rend(); ++it) {
+                         sum += *it;
+                     }
+                     do_not_optimize(sum);
+                 }, kElements));
+    bench_report("traversal/for_each (prefetch)", bench_ns_per_item([&] {
+                     long sum = 0;
+                     list.for_each([&](long value) { sum += value; });
+                     do_not_optimize(sum);
+                 }, kElements));
+    bench_report("traversal/copy constructor", bench_ns_per_item([&] {
+                     CircularList<long> tmp(list);
+                     do_not_optimize(tmp.size());
+                 }, kElements));
+    bench_report("traversal/operator==", bench_ns_per_item([&] {
+                     bool equal = list == copy;
+                     do_not_optimize(equal);
+                 }, kElements));
+    bench_report("traversal/operator<", bench_ns_per_item([&] {
+                     bool less = list < copy;
+                     do_not_optimize(less);
+                 }, kElements));
+
+    list.compact();
+    bench_report("traversal/iterator after compact()", bench_ns_per_item([&] {
+                     long sum = 0;
+                     for (long value : list) sum += value;
+                     do_not_optimize(sum);
+                 }, kElements));
+    bench_report("traversal/reverse_iterator after compact()",
+                 bench_ns_per_item([&] {
+                     long sum = 0;
+                     for (auto it = list.rbegin(); it != list.rend(); ++it) {
+                         sum += *it;
+                     }
+                     do_not_optimize(sum);
+                 }, kElements));
+    // Для сравнения: адаптер над прямым итератором, разыменование которого
+    // каждый раз делает шаг назад от копии
+    bench_report("traversal/std::reverse_iterator after compact()",
+                 bench_ns_per_item([&] {
+                     long sum = 0;
+                     std::reverse_iterator<CircularList<long>::iterator> it(
+                         list.end());
+                     std::reverse_iterator<CircularList<long>::iterator> end(
+                         list.begin());
+                     for (; it != end; ++it) sum += *it;
+                     do_not_optimize(sum);
+                 }, kElements));
+    bench_report("traversal/for_each after compact()", bench_ns_per_item([&] {
+                     long sum = 0;
+                     list.for_each([&](long value) { sum += value; });
+                     do_not_optimize(sum);
+                 }, kElements));
+}
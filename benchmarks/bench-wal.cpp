@@ -0,0 +1,39 @@
+/* Platon Lukyanov st128133@student.spbu.ru
+ * Problem 7
+ */
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+#include "DurableCircularList.h"
+#include "bench.h"
+
+namespace {
+
+// Очередь работ: каждое задание добавляется и снимается
+void run(const char* name, FsyncPolicy policy, size_t jobs) {
+    std::string directory = (std::filesystem::temp_directory_path() /
+                             "bench-wal").string();
+    std::filesystem::remove_all(directory);
+    WalOptions options;
+    options.fsync = policy;
+    DurableCircularList<long> queue(directory, options);
+    for (long i = 0; i < 1000; ++i) queue.push_back(i);
+    bench_report(name, bench_ns_per_item([&] {
+                     for (size_t i = 0; i < jobs; ++i) {
+                         queue.push_back(long(i));
+                         queue.pop_front();
+                     }
+                     queue.sync();
+                 }, 2 * jobs, 3));
+    std::printf("%-48s %10zu\n", "  fdatasync calls", queue.sync_count());
+}
+
+}  // namespace
+
+int main() {
+    // fdatasync на каждое изменение стоит порядка времени записи на носитель
+    run("push_back+pop_front/fsync always", FsyncPolicy::always, 1 << 10);
+    run("push_back+pop_front/fsync group (64)", FsyncPolicy::group, 1 << 16);
+    run("push_back+pop_front/fsync none", FsyncPolicy::none, 1 << 16);
+}
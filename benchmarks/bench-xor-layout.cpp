@@ -0,0 +1,78 @@
+/* Platon Lukyanov st128133@student.spbu.ru
+ * Problem 7
+ */
+#include <malloc.h>
+
+#include <array>
+#include <string>
+
+#include "CircularList.h"
+#include "XorCircularList.h"
+#include "bench.h"
+
+namespace {
+
+constexpr size_t kElements = 1 << 20;
+
+struct Pair {
+        long first;
+        long second;
+        bool operator!=(const Pair& other) const {
+            return first != other.first || second != other.second;
+        }
+};
+
+long value_of(long value) {
+    return value;
+}
+
+long value_of(const Pair& value) {
+    return value.first;
+}
+
+template <typename List>
+double heap_bytes_per_element() {
+    size_t before = mallinfo2().uordblks;
+    List list;
+    for (size_t i = 0; i < kElements; ++i) list.push_back({});
+    size_t after = mallinfo2().uordblks;
+    return double(after - before) / double(kElements);
+}
+
+template <typename List>
+void run(const std::string& name) {
+    List list;
+    bench_report((name + "/push_back").c_str(), bench_ns_per_item([&] {
+                     List tmp;
+                     for (size_t i = 0; i < kElements; ++i) tmp.push_back({});
+                     do_not_optimize(tmp.size());
+                 }, kElements));
+    for (size_t i = 0; i < kElements; ++i) list.push_back({});
+    bench_report((name + "/forward traversal").c_str(),
+                 bench_ns_per_item([&] {
+                     long sum = 0;
+                     for (auto it = list.begin(); it != list.end(); ++it) {
+                         sum += value_of(*it);
+                     }
+                     do_not_optimize(sum);
+                 }, kElements));
+    bench_report((name + "/backward traversal").c_str(),
+                 bench_ns_per_item([&] {
+                     long sum = 0;
+                     for (auto it = list.rbegin(); it != list.rend(); ++it) {
+                         sum += value_of(*it);
+                     }
+                     do_not_optimize(sum);
+                 }, kElements));
+    std::printf("%-48s %10.2f bytes/elem\n", (name + "/heap").c_str(),
+                heap_bytes_per_element<List>());
+}
+
+}  // namespace
+
+int main() {
+    run<CircularList<long>>("CircularList<long>");
+    run<XorCircularList<long>>("XorCircularList<long>");
+    run<CircularList<Pair>>("CircularList<Pair16>");
+    run<XorCircularList<Pair>>("XorCircularList<Pair16>");
+}
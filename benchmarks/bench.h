@@ -0,0 +1,38 @@
+/* Platon Lukyanov st128133@student.spbu.ru
+ * Problem 7
+ */
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+
+// Не даёт компилятору выбросить результат вычислений
+template <typename T>
+void do_not_optimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Лучшее из repetitions время прогона fn в наносекундах на элемент
+template <typename F>
+double bench_ns_per_item(F fn, size_t items, size_t repetitions = 5) {
+    double best = 0;
+    for (size_t i = 0; i < repetitions; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        auto stop = std::chrono::steady_clock::now();
+        double ns = std::chrono::duration<double, std::nano>(stop - start)
+                        .count() /
+                    double(items);
+        best = i == 0 ? ns : std::min(best, ns);
+    }
+    return best;
+}
+
+inline void bench_report(const char* name, double ns_per_item) {
+    std::printf("%-48s %10.2f ns/elem\n", name, ns_per_item);
+}
+
+#endif
@@ -1,7 +1,12 @@
 /* Platon Lukyanov st128133@student.spbu.ru
  * Problem 7
  */
-#include "CircularList.h"
+#include <array>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "CircularListExtern.h"
 #include "gtest/gtest.h"
 
 TEST(CircularList, test_constructor) {
@@ -194,6 +199,55 @@ TEST(CircularList, test_erase) {
     EXPECT_THROW(list.back(), std::out_of_range);
 }
 
+TEST(CircularList, test_erase_range) {
+    CircularList<std::string> list;
+    for (int i = 0; i < 6; ++i) list.push_back(std::to_string(i));
+    auto first = ++list.begin();
+    auto last = first;
+    ++++last;
+    auto next = list.erase(first, last);
+    EXPECT_EQ(*next, "3");
+    EXPECT_EQ(list.size(), 4);
+    EXPECT_TRUE(list.erase(next, next) == next);
+
+    // Диапазон с головы переносит голову, до end() - хвост
+    next = list.erase(list.begin(), ++list.begin());
+    EXPECT_TRUE(next == list.begin());
+    EXPECT_EQ(list.front(), "3");
+    EXPECT_TRUE(list.erase(++list.begin(), list.end()) == list.end());
+    EXPECT_EQ(list.size(), 1);
+    EXPECT_EQ(list.back(), "3");
+    EXPECT_EQ(*--list.end(), "3");
+    EXPECT_THROW(list.erase(list.end(), list.begin()), std::invalid_argument);
+    EXPECT_TRUE(list.erase(list.begin(), list.end()) == list.end());
+    EXPECT_TRUE(list.empty());
+}
+
+TEST(CircularList, test_resize) {
+    CircularList<int> list;
+    list.resize(3);
+    EXPECT_EQ(list.size(), 3);
+    EXPECT_EQ(list.back(), 0);
+    list.resize(5, 7);
+    std::vector<int> grown(list.begin(), list.end());
+    EXPECT_EQ(grown, (std::vector<int>{0, 0, 0, 7, 7}));
+    list.front() = 1;
+    list.resize(4);
+    list.resize(1, 9);
+    EXPECT_EQ(list.size(), 1);
+    EXPECT_EQ(list.front(), 1);
+    EXPECT_EQ(list.back(), 1);
+    list.resize(0);
+    EXPECT_TRUE(list.empty());
+
+    for (int i = 0; i < 100; ++i) list.push_back(i);
+    list.resize(90);
+    EXPECT_EQ(list.back(), 89);
+    list.resize(10);
+    EXPECT_EQ(list.back(), 9);
+    EXPECT_EQ(*--list.end(), 9);
+}
+
 TEST(CircularList, test_iterator) {
     CircularList<int> list;
     list.push_back(1);
@@ -319,6 +373,36 @@ TEST(CircularList, test_const_reverse_iterator) {
     EXPECT_EQ(*rit, 1);
 }
 
+TEST(CircularList, test_native_reverse_iterator) {
+    static_assert(
+        sizeof(CircularList<int>::reverse_iterator) == sizeof(void*));
+    static_assert(std::is_trivially_copyable_v<
+                  CircularList<std::string>::const_reverse_iterator>);
+
+    CircularList<int> list;
+    for (int i = 1; i <= 4; ++i) list.push_back(i);
+    std::vector<int> backward(list.rbegin(), list.rend());
+    EXPECT_EQ(backward, (std::vector<int>{4, 3, 2, 1}));
+
+    // Обратный итератор указывает на свой элемент; base() - на следующий
+    auto rit = list.rbegin();
+    EXPECT_TRUE(rit.base() == list.end());
+    ++rit;
+    EXPECT_EQ(*rit.base(), 4);
+    EXPECT_TRUE(CircularList<int>::reverse_iterator(list.end()) ==
+                list.rbegin());
+    EXPECT_TRUE(list.rend().base() == list.begin());
+    EXPECT_EQ(*--list.rend(), 1);
+
+    // Изменение через обратный итератор и переход к константному
+    *rit = 30;
+    CircularList<int>::const_reverse_iterator crit = rit;
+    EXPECT_EQ(*crit, 30);
+    EXPECT_TRUE(crit != list.crbegin());
+    EXPECT_EQ(*--crit, 4);
+    EXPECT_TRUE(crit == list.crbegin());
+}
+
 TEST(CircularList, test_iterators_on_empty) {
     CircularList<int> list;
     EXPECT_TRUE(list.begin() == list.end());
@@ -326,3 +410,360 @@ TEST(CircularList, test_iterators_on_empty) {
     EXPECT_TRUE(list.rbegin() == list.rend());
     EXPECT_TRUE(list.crbegin() == list.crend());
 }
+
+TEST(CircularList, test_iterator_is_one_pointer) {
+    static_assert(sizeof(CircularList<int>::iterator) == sizeof(void*));
+    static_assert(sizeof(CircularList<int>::const_iterator) == sizeof(void*));
+    static_assert(
+        std::is_trivially_copyable_v<CircularList<std::string>::iterator>);
+    static_assert(std::is_trivially_copyable_v<
+                  CircularList<std::string>::const_iterator>);
+
+    CircularList<int> list;
+    auto end = list.end();
+    list.push_back(2);
+    list.push_back(3);
+    list.push_front(1);
+    // end() не зависит от головы, а --end() указывает на хвост
+    EXPECT_EQ(end, list.end());
+    EXPECT_EQ(*--list.end(), 3);
+    std::vector<int> values;
+    for (auto it = list.begin(); it != end; ++it) values.push_back(*it);
+    EXPECT_EQ(values, (std::vector<int>{1, 2, 3}));
+
+    // Итератор на элемент переживает поворот и вставки перед ним
+    auto two = ++list.begin();
+    list.rotate(1);
+    list.push_front(0);
+    EXPECT_EQ(*two, 2);
+    EXPECT_EQ(*++two, 3);
+    EXPECT_EQ(*--list.end(), 1);
+    EXPECT_EQ(list.front(), 0);
+}
+
+TEST(CircularList, test_range_for) {
+    CircularList<int> list;
+    list.push_back(1);
+    list.push_back(2);
+    list.push_back(3);
+    int sum = 0;
+    for (int value : list) sum += value;
+    EXPECT_EQ(sum, 6);
+    auto it = list.end();
+    --it;
+    EXPECT_EQ(*it, 3);
+}
+
+TEST(CircularList, test_for_each_segment) {
+    CircularList<int> list;
+    list.push_back(1);
+    list.push_back(2);
+    list.push_back(3);
+    size_t segments = 0;
+    int sum = 0;
+    list.for_each_segment([&](std::span<int> segment) {
+        EXPECT_EQ(segment.size(), 1);
+        for (int& value : segment) {
+            value *= 10;
+            sum += value;
+        }
+        ++segments;
+    });
+    EXPECT_EQ(segments, 3);
+    EXPECT_EQ(sum, 60);
+    EXPECT_EQ(list.front(), 10);
+
+    size_t visited = 0;
+    const CircularList<int>& clist = list;
+    clist.for_each_segment([&](std::span<const int>) { return ++visited < 2; });
+    EXPECT_EQ(visited, 2);
+}
+
+TEST(CircularList, test_segment_iterator) {
+    CircularList<int> list;
+    EXPECT_TRUE(list.segment_begin() == list.segment_end());
+    list.push_back(1);
+    list.push_back(2);
+    auto seg = list.segment_begin();
+    ++seg;
+    EXPECT_EQ((*seg)[0], 2);
+    EXPECT_EQ(*seg.to_iterator(0), 2);
+    EXPECT_THROW(seg.to_iterator(1), std::out_of_range);
+    ++seg;
+    EXPECT_TRUE(seg == list.segment_end());
+    EXPECT_THROW(*seg, std::out_of_range);
+}
+
+TEST(CircularList, test_for_each) {
+    CircularList<int> list;
+    list.for_each([](int&) { FAIL(); });
+    for (int i = 1; i <= 10; ++i) list.push_back(i);
+    list.for_each([](int& value) { value *= 2; });
+    int sum = 0;
+    const CircularList<int>& clist = list;
+    clist.for_each([&](const int& value) { sum += value; });
+    EXPECT_EQ(sum, 110);
+    EXPECT_EQ(list.back(), 20);
+}
+
+TEST(CircularList, test_compact) {
+    CircularList<std::string> list;
+    list.compact();
+    EXPECT_TRUE(list.empty());
+    for (int i = 0; i < 100; ++i) {
+        list.push_back(std::to_string(i));
+        list.push_front(std::to_string(-i));
+    }
+    CircularList<std::string> expected(list);
+    list.compact();
+    EXPECT_EQ(list.locality(), 1.0);
+    EXPECT_TRUE(list == expected);
+
+    list.erase(++list.begin());
+    expected.erase(++expected.begin());
+    list.push_back("tail");
+    expected.push_back("tail");
+    list.compact();
+    EXPECT_TRUE(list == expected);
+    EXPECT_EQ(list.back(), "tail");
+    while (!list.empty()) list.pop_back();
+    list.push_back("again");
+    EXPECT_EQ(list.front(), "again");
+}
+
+TEST(CircularList, test_compact_after_move_and_swap) {
+    CircularList<int> list1;
+    for (int i = 0; i < 10; ++i) list1.push_back(i);
+    list1.compact();
+    CircularList<int> list2(std::move(list1));
+    EXPECT_EQ(list2.size(), 10);
+    CircularList<int> list3;
+    list3.push_back(42);
+    list3.swap(list2);
+    EXPECT_EQ(list3.back(), 9);
+    list3.clear();
+    list2.clear();
+    EXPECT_TRUE(list3.empty());
+}
+
+TEST(CircularList, test_auto_compact) {
+    CircularList<int> plain;
+    CircularList<int> compacted;
+    compacted.set_auto_compact(0.9);
+    // push_front кладёт каждый следующий узел перед предыдущим, поэтому
+    // связи next ведут назад по памяти
+    for (int i = 0; i < 1000; ++i) {
+        plain.push_front(i);
+        compacted.push_front(i);
+    }
+    EXPECT_TRUE(plain == compacted);
+    EXPECT_LT(plain.locality(), 0.5);
+    EXPECT_GT(compacted.locality(), plain.locality());
+
+    auto it = compacted.begin();
+    for (int i = 0; i < 500; ++i) {
+        it = compacted.insert(it, -i);
+        ++it;
+        it = compacted.erase(it);
+    }
+    EXPECT_EQ(compacted.size(), 1000);
+    int expected = 0;
+    for (auto value = compacted.begin(); expected > -500; ++value) {
+        EXPECT_EQ(*value, expected--);
+    }
+}
+
+namespace {
+
+struct ThrowingMove {
+        ThrowingMove() = default;
+        ThrowingMove(const ThrowingMove&) = default;
+        ThrowingMove(ThrowingMove&&) noexcept(false) {}
+        bool operator!=(const ThrowingMove&) const { return false; }
+};
+
+template <typename List>
+concept Compactable = requires(List& list) { list.compact(); };
+
+}  // namespace
+
+TEST(CircularList, test_compact_requires_nothrow_move) {
+    static_assert(Compactable<CircularList<int>>);
+    static_assert(!Compactable<CircularList<ThrowingMove>>);
+    static_assert(!CircularList<int>::compact_preserves_iterators);
+    CircularList<ThrowingMove> list;
+    list.push_back(ThrowingMove());
+    EXPECT_EQ(list.size(), 1);
+}
+
+TEST(CircularList, test_rotate) {
+    CircularList<int> list;
+    list.rotate(3);
+    for (int i = 0; i < 5; ++i) list.push_back(i);
+
+    list.rotate(2);
+    EXPECT_EQ(list.front(), 2);
+    EXPECT_EQ(list.back(), 1);
+    list.rotate(-3);
+    EXPECT_EQ(list.front(), 4);
+    list.rotate(11);
+    EXPECT_EQ(list.front(), 0);
+    list.rotate(-5);
+    EXPECT_EQ(list.front(), 0);
+    EXPECT_EQ(list.size(), 5);
+}
+
+namespace {
+
+// Таблица строится списком на этапе компиляции и копируется в массив
+constexpr std::array<int, 6> make_table() {
+    CircularList<int> list;
+    for (int i = 1; i <= 4; ++i) list.push_back(i * i);
+    list.push_front(0);
+    list.insert(list.end(), 25);
+    list.rotate(2);
+
+    CircularList<int> copy = list;
+    copy.erase(copy.begin());
+    copy.push_back(list.front());
+
+    std::array<int, 6> table{};
+    size_t i = 0;
+    copy.for_each([&](int value) { table[i++] = value; });
+    return table;
+}
+
+constexpr bool constexpr_comparisons() {
+    CircularList<int> a;
+    CircularList<int> b;
+    a.assign(3, 7);
+    b.assign(3, 7);
+    if (a != b) return false;
+    b.pop_back();
+    return b < a && a.size() == 3 && *a.rbegin() == 7;
+}
+
+constexpr bool constexpr_split_concat() {
+    CircularList<int> list;
+    for (int i = 0; i < 5; ++i) list.push_back(i);
+    CircularList<int> tail = list.split_at(++list.begin(), 1);
+    tail.concat(std::move(list));
+    return tail.size() == 5 && tail.front() == 1 && tail.back() == 0;
+}
+
+}  // namespace
+
+TEST(CircularList, test_constexpr) {
+    constexpr std::array<int, 6> table = make_table();
+    static_assert(table == std::array<int, 6>{9, 16, 25, 0, 1, 4});
+    static_assert(constexpr_comparisons());
+    static_assert(constexpr_split_concat());
+    EXPECT_EQ(make_table(), table);
+}
+
+TEST(CircularList, test_ring_neighbours) {
+    CircularList<int> list;
+    EXPECT_THROW(list.ring_next(list.end()), std::out_of_range);
+    for (int i = 0; i < 3; ++i) list.push_back(i);
+    auto last = --list.end();
+    EXPECT_TRUE(list.ring_next(last) == list.begin());
+    EXPECT_TRUE(list.ring_prev(list.begin()) == last);
+
+    // Итератор, полученный до смены головы, ведёт по новому кольцу
+    auto first = list.begin();
+    list.push_front(-1);
+    auto next = list.ring_next(first);
+    EXPECT_EQ(*next, 1);
+    EXPECT_EQ(*list.ring_prev(first), -1);
+    EXPECT_TRUE(++list.ring_next(next) == list.end());
+}
+
+TEST(CircularList, test_split_and_concat) {
+    CircularList<int> list;
+    for (int i = 0; i < 6; ++i) list.push_back(i);
+    auto pos = list.begin();
+    ++++pos;
+    EXPECT_THROW(list.split_at(pos, 0), std::invalid_argument);
+    EXPECT_THROW(list.split_at(list.end(), 5), std::invalid_argument);
+    EXPECT_THROW(list.split_at(pos, 7), std::out_of_range);
+
+    CircularList<int> tail = list.split_at(pos, 2);
+    EXPECT_EQ(list.size(), 2);
+    EXPECT_EQ(tail.size(), 4);
+    EXPECT_EQ(list.back(), 1);
+    EXPECT_EQ(tail.front(), 2);
+    EXPECT_EQ(tail.back(), 5);
+    EXPECT_EQ(*--list.end(), 1);
+    EXPECT_EQ(*--tail.end(), 5);
+
+    EXPECT_TRUE(list.split_at(list.end()).empty());
+    CircularList<int> whole = tail.split_at(tail.begin());
+    EXPECT_TRUE(tail.empty());
+    EXPECT_EQ(whole.size(), 4);
+
+    whole.concat(std::move(list));
+    whole.concat(std::move(tail));
+    EXPECT_TRUE(list.empty());
+    std::vector<int> joined(whole.begin(), whole.end());
+    EXPECT_EQ(joined, (std::vector<int>{2, 3, 4, 5, 0, 1}));
+    std::vector<int> reversed(whole.rbegin(), whole.rend());
+    EXPECT_EQ(reversed, (std::vector<int>{1, 0, 5, 4, 3, 2}));
+    tail.concat(std::move(whole));
+    EXPECT_EQ(tail.size(), 6);
+    EXPECT_EQ(tail.front(), 2);
+}
+
+TEST(CircularList, test_split_compacted_ring) {
+    // Части уплотнённого кольца делят один блок узлов
+    CircularList<std::string> list;
+    for (int i = 0; i < 8; ++i) list.push_back(std::to_string(i));
+    list.compact();
+    auto pos = list.begin();
+    for (int i = 0; i < 3; ++i) ++pos;
+    CircularList<std::string> tail = list.split_at(pos);
+    EXPECT_EQ(list.size(), 3);
+    EXPECT_EQ(tail.front(), "3");
+    tail.pop_front();
+    list.clear();
+    tail.push_back("8");
+    list.concat(std::move(tail));
+    EXPECT_EQ(list.size(), 5);
+    EXPECT_EQ(list.front(), "4");
+    EXPECT_EQ(list.back(), "8");
+}
+
+TEST(CircularList, test_split_releases_unused_slabs) {
+    CircularList<long> list;
+    CircularList<long> other;
+    for (long i = 0; i < 1000; ++i) list.push_back(i);
+    for (long i = 0; i < 10; ++i) other.push_back(i);
+    list.compact();
+    other.compact();
+    // Хвост лежит целиком в блоке list: блок other ему не нужен
+    list.concat(std::move(other));
+    CircularList<long> tail = list.split_at(std::prev(list.end(), 10), 1000);
+    EXPECT_EQ(tail.front(), 0);
+    EXPECT_EQ(tail.size(), 10);
+    EXPECT_EQ(tail.slab_count(), 1);
+    EXPECT_EQ(list.slab_count(), 1);
+    CircularList<long> middle = list.split_at(std::next(list.begin(), 300),
+                                              300);
+    EXPECT_EQ(middle.front(), 300);
+    EXPECT_EQ(middle.size(), 700);
+    EXPECT_EQ(list.back(), 299);
+    EXPECT_EQ(middle.slab_count(), 1);
+    EXPECT_EQ(list.slab_count(), 1);
+
+    // Блок освобождается, как только в нём не остаётся узлов ни одного
+    // из списков, даже если оба списка ещё живы
+    middle.clear();
+    EXPECT_EQ(middle.slab_count(), 0);
+    EXPECT_EQ(list.slab_count(), 1);
+    tail.clear();
+    list.clear();
+    EXPECT_EQ(tail.slab_count(), 0);
+    EXPECT_EQ(list.slab_count(), 0);
+    list.push_back(1);
+    middle.concat(std::move(list));
+    EXPECT_EQ(middle.size(), 1);
+}
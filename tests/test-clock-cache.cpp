@@ -0,0 +1,179 @@
+/* Platon Lukyanov st128133@student.spbu.ru
+ * Problem 7
+ */
+#include <map>
+#include <random>
+#include <string>
+
+#include "ClockCache.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+// Число попаданий при циклическом проходе по loop ключам rounds раз
+template <typename Cache>
+size_t loop_hits(Cache& cache, int loop, int rounds) {
+    size_t hits = 0;
+    for (int round = 0; round < rounds; ++round) {
+        for (int key = 0; key < loop; ++key) {
+            if (cache.get(key)) {
+                ++hits;
+            } else {
+                cache.put(key, key);
+            }
+        }
+    }
+    return hits;
+}
+
+}  // namespace
+
+TEST(ClockCache, test_get_put_erase) {
+    EXPECT_THROW((ClockCache<int, int>(0)), std::invalid_argument);
+    ClockCache<std::string, int> cache(2);
+    EXPECT_TRUE(cache.empty());
+    EXPECT_EQ(cache.get("a"), nullptr);
+    cache.put("a", 1);
+    cache.put("b", 2);
+    EXPECT_EQ(*cache.get("a"), 1);
+    cache.put("a", 10);
+    EXPECT_EQ(*cache.get("a"), 10);
+    EXPECT_EQ(cache.size(), 2);
+    EXPECT_TRUE(cache.erase("a"));
+    EXPECT_FALSE(cache.erase("a"));
+    EXPECT_FALSE(cache.contains("a"));
+    cache.put("c", 3);
+    cache.put("d", 4);
+    EXPECT_EQ(cache.size(), 2);
+    cache.clear();
+    EXPECT_TRUE(cache.empty());
+    cache.put("e", 5);
+    EXPECT_EQ(*cache.get("e"), 5);
+}
+
+TEST(ClockCache, test_second_chance) {
+    ClockCache<char, int> cache(3);
+    cache.put('a', 1);
+    cache.put('b', 2);
+    cache.put('c', 3);
+    cache.get('a');
+    cache.put('d', 4);
+    EXPECT_TRUE(cache.contains('a'));
+    EXPECT_FALSE(cache.contains('b'));
+    EXPECT_TRUE(cache.contains('c'));
+    EXPECT_TRUE(cache.contains('d'));
+
+    // Бит 'a' сброшен стрелкой, новая запись встала перед стрелкой
+    cache.put('e', 5);
+    EXPECT_FALSE(cache.contains('c'));
+    cache.put('f', 6);
+    EXPECT_FALSE(cache.contains('a'));
+    EXPECT_EQ(cache.size(), 3);
+}
+
+TEST(ClockCache, test_single_slot) {
+    ClockCache<int, int> cache(1);
+    for (int i = 0; i < 10; ++i) {
+        cache.put(i, i);
+        cache.get(i);
+        EXPECT_EQ(cache.size(), 1);
+        EXPECT_EQ(*cache.get(i), i);
+    }
+}
+
+TEST(ClockProCache, test_get_put_erase) {
+    EXPECT_THROW((ClockProCache<int, int>(0)), std::invalid_argument);
+    // Одного места не хватает и горячей, и холодной записи
+    EXPECT_THROW((ClockProCache<int, int>(1)), std::invalid_argument);
+    ClockProCache<std::string, int> cache(2);
+    cache.put("a", 1);
+    cache.put("b", 2);
+    EXPECT_EQ(*cache.get("a"), 1);
+    cache.put("b", 20);
+    EXPECT_EQ(*cache.get("b"), 20);
+    cache.put("c", 3);
+    EXPECT_EQ(cache.size(), 2);
+    EXPECT_TRUE(cache.contains("c"));
+    EXPECT_TRUE(cache.erase("c"));
+    EXPECT_FALSE(cache.contains("c"));
+    EXPECT_EQ(cache.size(), 1);
+}
+
+TEST(ClockProCache, test_test_page_promotes_to_hot) {
+    ClockProCache<int, int> cache(2);
+    cache.put(1, 1);
+    cache.put(2, 2);
+    cache.put(3, 3);
+    // Одна из первых записей вытеснена, но осталась в кольце тестовой
+    EXPECT_TRUE(cache.contains(3));
+    EXPECT_NE(cache.contains(1), cache.contains(2));
+    int evicted = cache.contains(1) ? 2 : 1;
+    EXPECT_EQ(cache.get(evicted), nullptr);
+    EXPECT_EQ(cache.test_size(), 1);
+    EXPECT_EQ(cache.hot_size(), 0);
+    cache.put(evicted, 10);
+    EXPECT_EQ(*cache.get(evicted), 10);
+    EXPECT_EQ(cache.hot_size(), 1);
+    EXPECT_EQ(cache.size(), 2);
+}
+
+TEST(ClockProCache, test_loop_larger_than_cache) {
+    // Цикл длиннее кэша: CLOCK, как и LRU, не попадает ни разу
+    ClockCache<int, int> clock(100);
+    ClockProCache<int, int> clock_pro(100);
+    size_t clock_hits = loop_hits(clock, 120, 50);
+    size_t clock_pro_hits = loop_hits(clock_pro, 120, 50);
+    EXPECT_EQ(clock_hits, 0);
+    EXPECT_GT(clock_pro_hits, 120 * 50 / 4);
+}
+
+TEST(ClockProCache, test_small_capacities) {
+    // Горячие записи при малой ёмкости: стрелки не зацикливаются
+    for (size_t capacity = 2; capacity <= 8; ++capacity) {
+        ClockProCache<int, int> cache(capacity);
+        std::mt19937 random(static_cast<unsigned>(capacity));
+        for (int i = 0; i < 5000; ++i) {
+            int key = int(random() % (3 * capacity));
+            if (random() % 3 == 0)
+                cache.get(key);
+            else
+                cache.put(key, i);
+            ASSERT_LE(cache.size(), capacity);
+            ASSERT_LE(cache.test_size(), capacity);
+        }
+    }
+    ClockProCache<int, int> cache(2);
+    cache.put(1, 1);
+    cache.put(2, 2);
+    cache.get(2);
+    cache.put(1, 3);
+    cache.put(3, 4);
+    EXPECT_EQ(cache.size(), 2);
+}
+
+TEST(ClockProCache, test_random_workload) {
+    ClockProCache<int, int> cache(16);
+    std::map<int, int> latest;
+    std::mt19937 random(7);
+    for (int i = 0; i < 20000; ++i) {
+        int key = int(random() % 64);
+        switch (random() % 4) {
+            case 0:
+                cache.erase(key);
+                latest.erase(key);
+                break;
+            case 1: {
+                int* value = cache.get(key);
+                if (value) {
+                    EXPECT_EQ(*value, latest[key]);
+                }
+                break;
+            }
+            default:
+                cache.put(key, i);
+                latest[key] = i;
+        }
+        ASSERT_LE(cache.size(), 16);
+        ASSERT_LE(cache.test_size(), 16);
+    }
+}
@@ -0,0 +1,172 @@
+/* Platon Lukyanov st128133@student.spbu.ru
+ * Problem 7
+ */
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "CompressedCircularList.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+template <typename T>
+std::vector<T> contents(const CompressedCircularList<T>& list) {
+    return {list.begin(), list.end()};
+}
+
+}  // namespace
+
+TEST(CompressedCircularList, test_push_back_pop_front) {
+    CompressedCircularList<> list;
+    EXPECT_TRUE(list.empty());
+    EXPECT_THROW(list.front(), std::out_of_range);
+    EXPECT_THROW(list.pop_front(), std::out_of_range);
+    EXPECT_THROW(*list.begin(), std::out_of_range);
+    for (uint64_t i = 0; i < 2000; ++i) list.push_back(1000 + 10 * i);
+    EXPECT_EQ(list.size(), 2000);
+    EXPECT_EQ(list.front(), 1000);
+    EXPECT_EQ(list.back(), 1000 + 10 * 1999);
+    EXPECT_EQ(list.at(1234), 1000 + 10 * 1234);
+    for (int i = 0; i < 700; ++i) list.pop_front();
+    EXPECT_EQ(list.front(), 1000 + 10 * 700);
+    EXPECT_EQ(list.at(0), list.front());
+    uint64_t expected = 1000 + 10 * 700;
+    for (uint64_t value : list) {
+        EXPECT_EQ(value, expected);
+        expected += 10;
+    }
+    list.clear();
+    EXPECT_TRUE(list.begin() == list.end());
+}
+
+TEST(CompressedCircularList, test_timestamps_are_small) {
+    // Отметки времени в наносекундах с шагом около 1 мс и дрожанием
+    std::mt19937 random(72);
+    CompressedCircularList<uint64_t> list;
+    uint64_t now = 1700000000000000000ull;
+    for (int i = 0; i < 100000; ++i) {
+        now += 1000000 + random() % 64;
+        list.push_back(now);
+    }
+    double per_element = double(list.memory_bytes()) / double(list.size());
+    EXPECT_LE(per_element, 3.0);
+    EXPECT_EQ(list.back(), now);
+}
+
+TEST(CompressedCircularList, test_extreme_values) {
+    CompressedCircularList<int64_t> list;
+    const int64_t values[] = {0,
+                              std::numeric_limits<int64_t>::max(),
+                              std::numeric_limits<int64_t>::min(),
+                              -1,
+                              1,
+                              std::numeric_limits<int64_t>::min(),
+                              42};
+    for (int64_t value : values) list.push_back(value);
+    EXPECT_EQ(contents(list), std::vector<int64_t>(std::begin(values),
+                                                   std::end(values)));
+    list.pop_back();
+    list.pop_front();
+    EXPECT_EQ(list.front(), std::numeric_limits<int64_t>::max());
+    EXPECT_EQ(list.back(), std::numeric_limits<int64_t>::min());
+}
+
+TEST(CompressedCircularList, test_middle_insert_and_erase) {
+    CompressedCircularList<uint32_t> list;
+    for (uint32_t i = 0; i < 1000; ++i) list.push_back(i * 2);
+    list.insert(0, 7);
+    list.insert(600, 1);
+    list.insert(list.size(), 3);
+    EXPECT_THROW(list.insert(list.size() + 1, 0), std::out_of_range);
+    EXPECT_EQ(list.size(), 1003);
+    EXPECT_EQ(list.front(), 7);
+    EXPECT_EQ(list.at(600), 1);
+    EXPECT_EQ(list.at(601), 599 * 2);
+    EXPECT_EQ(list.back(), 3);
+    list.erase(600);
+    list.erase(0);
+    list.erase(list.size() - 1);
+    EXPECT_THROW(list.erase(list.size()), std::out_of_range);
+    std::vector<uint32_t> expected;
+    for (uint32_t i = 0; i < 1000; ++i) expected.push_back(i * 2);
+    EXPECT_EQ(contents(list), expected);
+}
+
+TEST(CompressedCircularList, test_rotate_copy_compare) {
+    CompressedCircularList<int> list;
+    for (int i = 0; i < 10; ++i) list.push_back(i * i);
+    CompressedCircularList<int> copy(list);
+    EXPECT_EQ(copy, list);
+    list.rotate(3);
+    EXPECT_EQ(list.front(), 9);
+    EXPECT_EQ(list.back(), 4);
+    list.rotate(-3);
+    EXPECT_EQ(list, copy);
+    copy.pop_back();
+    EXPECT_LT(copy, list);
+    EXPECT_GT(list, copy);
+    EXPECT_NE(list, copy);
+    EXPECT_GE(list, list);
+    list.swap(copy);
+    EXPECT_EQ(list.size(), 9);
+
+    int sum = 0;
+    list.for_each([&](int value) {
+        sum += value;
+        return value < 16;
+    });
+    EXPECT_EQ(sum, 0 + 1 + 4 + 9 + 16);
+}
+
+TEST(CompressedCircularList, test_random_against_deque) {
+    std::mt19937 random(720);
+    CompressedCircularList<uint64_t> list;
+    std::deque<uint64_t> model;
+    uint64_t next = 0;
+    for (int step = 0; step < 20000; ++step) {
+        switch (random() % 8) {
+            case 0:
+            case 1:
+            case 2:
+                next += random() % 5;
+                list.push_back(next);
+                model.push_back(next);
+                break;
+            case 3:
+            case 4:
+                if (!model.empty()) {
+                    list.pop_front();
+                    model.pop_front();
+                }
+                break;
+            case 5: {
+                size_t index = random() % (model.size() + 1);
+                list.insert(index, step);
+                model.insert(model.begin() + std::ptrdiff_t(index), step);
+                break;
+            }
+            case 6:
+                if (!model.empty()) {
+                    size_t index = random() % model.size();
+                    list.erase(index);
+                    model.erase(model.begin() + std::ptrdiff_t(index));
+                }
+                break;
+            default:
+                if (!model.empty()) {
+                    list.pop_back();
+                    model.pop_back();
+                }
+        }
+        ASSERT_EQ(list.size(), model.size());
+        if (step % 101 == 0) {
+            ASSERT_EQ(contents(list),
+                      std::vector<uint64_t>(model.begin(), model.end()));
+        }
+    }
+    EXPECT_EQ(contents(list),
+              std::vector<uint64_t>(model.begin(), model.end()));
+}
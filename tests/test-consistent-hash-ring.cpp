@@ -0,0 +1,117 @@
+/* Platon Lukyanov st128133@student.spbu.ru
+ * Problem 7
+ */
+#include <map>
+#include <string>
+#include <vector>
+
+#include "ConsistentHashRing.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+std::vector<std::string> owners(const ConsistentHashRing<std::string>& ring,
+                                int keys) {
+    std::vector<std::string> result;
+    for (int key = 0; key < keys; ++key) result.push_back(ring.locate(key));
+    return result;
+}
+
+double changed(const std::vector<std::string>& before,
+               const std::vector<std::string>& after) {
+    size_t moved = 0;
+    for (size_t i = 0; i < before.size(); ++i) moved += before[i] != after[i];
+    return double(moved) / double(before.size());
+}
+
+}  // namespace
+
+TEST(ConsistentHashRing, test_empty_and_single) {
+    ConsistentHashRing<std::string> ring;
+    EXPECT_TRUE(ring.empty());
+    EXPECT_THROW(ring.locate(1), std::out_of_range);
+    EXPECT_DOUBLE_EQ(ring.add("a"), 1.0);
+    EXPECT_EQ(ring.token_count(),
+              ConsistentHashRing<std::string>::default_tokens_per_weight);
+    for (int key = 0; key < 100; ++key) EXPECT_EQ(ring.locate(key), "a");
+    EXPECT_THROW(ring.add("a"), std::invalid_argument);
+    EXPECT_THROW(ring.add("b", 0), std::invalid_argument);
+    EXPECT_THROW(ring.remove("b"), std::invalid_argument);
+    EXPECT_DOUBLE_EQ(ring.remove("a"), 1.0);
+    EXPECT_EQ(ring.token_count(), 0);
+}
+
+TEST(ConsistentHashRing, test_weights) {
+    ConsistentHashRing<std::string> ring;
+    ring.add({{"a", 1.0}, {"b", 1.0}, {"c", 2.0}});
+    EXPECT_EQ(ring.size(), 3);
+    EXPECT_EQ(ring.token_count(), 4 * 160);
+    std::map<std::string, int> counts;
+    for (const auto& owner : owners(ring, 40000)) ++counts[owner];
+    EXPECT_NEAR(counts["c"] / 40000.0, 0.5, 0.07);
+    EXPECT_NEAR(counts["a"] / 40000.0, 0.25, 0.07);
+    EXPECT_NEAR(counts["b"] / 40000.0, 0.25, 0.07);
+}
+
+TEST(ConsistentHashRing, test_movement_fraction) {
+    ConsistentHashRing<std::string> ring;
+    ring.add({{"a", 1.0}, {"b", 1.0}, {"c", 1.0}});
+    auto before = owners(ring, 20000);
+
+    double moved = ring.add("d");
+    auto after = owners(ring, 20000);
+    EXPECT_NEAR(moved, 0.25, 0.06);
+    EXPECT_NEAR(changed(before, after), moved, 0.02);
+    // Ключи переезжают только на новый бэкенд
+    for (size_t i = 0; i < before.size(); ++i) {
+        if (before[i] != after[i]) {
+            EXPECT_EQ(after[i], "d");
+        }
+    }
+
+    moved = ring.remove(std::vector<std::string>{"a", "d"});
+    auto removed = owners(ring, 20000);
+    EXPECT_NEAR(changed(after, removed), moved, 0.02);
+    EXPECT_NEAR(moved, 0.5, 0.08);
+
+    // Возврат бэкенда восстанавливает прежнее распределение
+    ring.add({{"a", 1.0}});
+    EXPECT_EQ(owners(ring, 20000), before);
+}
+
+TEST(ConsistentHashRing, test_batch_is_atomic) {
+    ConsistentHashRing<std::string> ring;
+    ring.add("a");
+    EXPECT_THROW(ring.add({{"b", 1.0}, {"a", 1.0}}), std::invalid_argument);
+    EXPECT_THROW(ring.add({{"b", 1.0}, {"b", 1.0}}), std::invalid_argument);
+    EXPECT_THROW(ring.remove(std::vector<std::string>{"a", "x"}),
+                 std::invalid_argument);
+    EXPECT_EQ(ring.size(), 1);
+    EXPECT_TRUE(ring.contains("a"));
+    EXPECT_FALSE(ring.contains("b"));
+    EXPECT_EQ(ring.token_count(), 160);
+}
+
+TEST(ConsistentHashRing, test_bounded_load) {
+    EXPECT_THROW((ConsistentHashRing<std::string>(160, 0.5)),
+                 std::invalid_argument);
+    ConsistentHashRing<std::string> ring(40, 1.25);
+    ring.add({{"a", 1.0}, {"b", 1.0}, {"c", 1.0}, {"d", 1.0}});
+    // Все ключи попадают в узкую дугу: без ограничения их получил бы
+    // один бэкенд
+    std::map<std::string, int> counts;
+    for (int i = 0; i < 1000; ++i) ++counts[ring.assign(7)];
+    EXPECT_EQ(ring.total_load(), 1000);
+    for (const auto& [backend, count] : counts) {
+        EXPECT_LE(count, 313);
+        EXPECT_EQ(ring.load(backend), size_t(count));
+    }
+    EXPECT_EQ(counts[ring.locate(7)], 313);
+
+    ring.release("a");
+    EXPECT_EQ(ring.load("a"), size_t(counts["a"] - 1));
+    EXPECT_EQ(ring.total_load(), 999);
+    ring.remove("a");
+    EXPECT_EQ(ring.total_load(), size_t(999 - counts["a"] + 1));
+    EXPECT_THROW(ring.release("a"), std::invalid_argument);
+}
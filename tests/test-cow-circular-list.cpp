@@ -0,0 +1,168 @@
+/* Platon Lukyanov st128133@student.spbu.ru
+ * Problem 7
+ */
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "CowCircularList.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+template <typename T>
+std::vector<T> contents(const CowCircularList<T>& list) {
+    return std::vector<T>(list.begin(), list.end());
+}
+
+}  // namespace
+
+TEST(CowCircularList, test_empty_handle) {
+    CowCircularList<int> list;
+    EXPECT_TRUE(list.empty());
+    EXPECT_EQ(list.use_count(), 0);
+    EXPECT_EQ(list.begin(), list.end());
+    EXPECT_THROW(list.front(), std::out_of_range);
+    EXPECT_THROW(list.pop_back(), std::out_of_range);
+    EXPECT_THROW(list.pop_front(), std::out_of_range);
+    list.rotate(3);
+    EXPECT_EQ(list.use_count(), 0);
+    list.push_back(1);
+    EXPECT_EQ(list.use_count(), 1);
+    EXPECT_EQ(list.front(), 1);
+}
+
+TEST(CowCircularList, test_copy_shares_until_write) {
+    CircularList<std::string> source;
+    source.push_back("a");
+    source.push_back("b");
+    CowCircularList<std::string> a(source);
+    CowCircularList<std::string> b = a;
+    EXPECT_TRUE(a.shared());
+    EXPECT_EQ(&a.get(), &b.get());
+    EXPECT_EQ(&a.front(), &b.front());
+
+    b.push_back("c");
+    EXPECT_FALSE(a.shared());
+    EXPECT_FALSE(b.shared());
+    EXPECT_NE(&a.get(), &b.get());
+    EXPECT_EQ(contents(a), (std::vector<std::string>{"a", "b"}));
+    EXPECT_EQ(contents(b), (std::vector<std::string>{"a", "b", "c"}));
+
+    // Единоличный владелец меняет кольцо на месте
+    const CircularList<std::string>* before = &b.get();
+    b.pop_front();
+    b.rotate(1);
+    EXPECT_EQ(&b.get(), before);
+    EXPECT_EQ(contents(b), (std::vector<std::string>{"c", "b"}));
+}
+
+TEST(CowCircularList, test_modify_through_iterators) {
+    CowCircularList<int> a;
+    for (int i = 0; i < 4; ++i) a.push_back(i);
+    CowCircularList<int> b = a;
+    // Итератор разделённого кольца переносится в копию по номеру
+    b.set(std::next(b.begin()), 10);
+    EXPECT_FALSE(a.shared());
+    EXPECT_EQ(contents(a), (std::vector<int>{0, 1, 2, 3}));
+    EXPECT_EQ(contents(b), (std::vector<int>{0, 10, 2, 3}));
+
+    // Единоличный владелец меняет кольцо на месте
+    const int* second = &*std::next(b.begin());
+    auto it = b.erase(b.begin());
+    EXPECT_EQ(&*it, second);
+    it = b.insert(b.end(), 4);
+    EXPECT_EQ(*it, 4);
+    EXPECT_EQ(contents(b), (std::vector<int>{10, 2, 3, 4}));
+
+    // Запись после копирования описателя не видна в копии
+    CowCircularList<int> c = b;
+    it = b.insert(std::next(b.begin(), 2), 7);
+    b.set(it, 8);
+    b.erase(b.begin());
+    EXPECT_EQ(contents(b), (std::vector<int>{2, 8, 3, 4}));
+    EXPECT_EQ(contents(c), (std::vector<int>{10, 2, 3, 4}));
+
+    CowCircularList<int> empty;
+    EXPECT_EQ(*empty.insert(empty.end(), 1), 1);
+    EXPECT_EQ(contents(empty), (std::vector<int>{1}));
+    EXPECT_THROW(empty.erase(empty.end()), std::invalid_argument);
+    EXPECT_THROW(empty.set(empty.end(), 2), std::invalid_argument);
+}
+
+TEST(CowCircularList, test_clear_and_assign_release_shared_ring) {
+    CowCircularList<int> a;
+    a.assign(3, 7);
+    CowCircularList<int> b = a;
+    CowCircularList<int> c = a;
+    b.clear();
+    EXPECT_TRUE(b.empty());
+    EXPECT_EQ(b.use_count(), 0);
+    c.assign(2, 1);
+    EXPECT_EQ(a.use_count(), 1);
+    EXPECT_EQ(contents(a), (std::vector<int>{7, 7, 7}));
+    EXPECT_EQ(contents(c), (std::vector<int>{1, 1}));
+}
+
+TEST(CowCircularList, test_comparisons_and_swap) {
+    CowCircularList<int> a, b;
+    a.push_back(1);
+    b.push_back(2);
+    EXPECT_LT(a, b);
+    EXPECT_NE(a, b);
+    CowCircularList<int> c = a;
+    EXPECT_EQ(a, c);
+    c.push_back(0);
+    EXPECT_LE(a, c);
+    EXPECT_GT(c, a);
+    EXPECT_GE(b, c);
+    a.swap(b);
+    EXPECT_EQ(a.front(), 2);
+    EXPECT_EQ(b.front(), 1);
+    EXPECT_EQ(CowCircularList<int>(),
+              CowCircularList<int>(CircularList<int>()));
+}
+
+TEST(CowCircularList, test_concurrent_copies) {
+    CowCircularList<int> origin;
+    for (int i = 0; i < 100; ++i) origin.push_back(i);
+    std::vector<std::thread> threads;
+    std::vector<long> sums(4);
+    for (int t = 0; t < 4; ++t) {
+        CowCircularList<int> copy = origin;
+        threads.emplace_back([copy, t, &sums]() mutable {
+            for (int i = 0; i < 100; ++i) {
+                CowCircularList<int> local = copy;
+                local.push_back(t);
+                copy = local;
+            }
+            copy.for_each([&](int value) { sums[t] += value; });
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    for (int t = 0; t < 4; ++t) EXPECT_EQ(sums[t], 4950 + 100 * t);
+    EXPECT_EQ(origin.size(), 100);
+    EXPECT_EQ(origin.use_count(), 1);
+}
+
+TEST(CowCircularList, test_write_after_reader_releases) {
+    // Читатель в другом потоке обходит снимок и отпускает его; владелец,
+    // увидев, что кольцо больше не разделено, пишет в него на месте
+    for (int round = 0; round < 50; ++round) {
+        CowCircularList<int> writer;
+        for (int i = 0; i < 1000; ++i) writer.push_back(i);
+        long sum = 0;
+        std::thread reader([snapshot = writer, &sum]() mutable {
+            snapshot.for_each([&sum](int value) { sum += value; });
+            snapshot.clear();
+        });
+        while (writer.shared()) std::this_thread::yield();
+        const CircularList<int>* before = &writer.get();
+        for (auto it = writer.begin(); it != writer.end(); ++it)
+            writer.set(it, -1);
+        reader.join();
+        EXPECT_EQ(&writer.get(), before);
+        EXPECT_EQ(sum, 499500);
+        EXPECT_EQ(writer.front(), -1);
+    }
+}
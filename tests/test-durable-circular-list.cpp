@@ -0,0 +1,267 @@
+/* Platon Lukyanov st128133@student.spbu.ru
+ * Problem 7
+ */
+#include <sys/resource.h>
+
+#include <csignal>
+#include <cstdio>
+#include <deque>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "DurableCircularList.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+using Queue = DurableCircularList<long>;
+
+// Пустой каталог для журнала теста
+std::string fresh_directory(const std::string& name) {
+    std::string directory = ::testing::TempDir() + "durable-" + name;
+    std::filesystem::remove_all(directory);
+    return directory;
+}
+
+std::vector<long> contents(const Queue& queue) {
+    std::vector<long> result;
+    queue.for_each([&result](long value) { result.push_back(value); });
+    return result;
+}
+
+}  // namespace
+
+TEST(DurableCircularList, test_recover_from_wal) {
+    std::string directory = fresh_directory("wal");
+    Queue::Handle middle;
+    {
+        Queue queue(directory);
+        EXPECT_TRUE(queue.empty());
+        EXPECT_THROW(queue.pop_front(), std::out_of_range);
+        EXPECT_THROW(queue.front(), std::out_of_range);
+        queue.push_back(1);
+        middle = queue.push_back(2);
+        queue.push_back(3);
+        queue.push_front(0);
+        Queue::Handle erased = queue.insert(middle, 10);
+        EXPECT_EQ(contents(queue), (std::vector<long>{0, 1, 10, 2, 3}));
+        EXPECT_TRUE(queue.erase(erased));
+        EXPECT_FALSE(queue.erase(erased));
+        EXPECT_EQ(queue.get(erased), nullptr);
+        EXPECT_THROW(queue.insert(erased, 5), std::invalid_argument);
+        queue.pop_back();
+        EXPECT_EQ(queue.last_sequence(), 7);
+    }
+    Queue queue(directory);
+    EXPECT_EQ(contents(queue), (std::vector<long>{0, 1, 2}));
+    EXPECT_EQ(queue.last_sequence(), 7);
+    EXPECT_EQ(queue.durable_sequence(), 7);
+    // Описатели переживают восстановление
+    ASSERT_TRUE(queue.contains(middle));
+    EXPECT_EQ(*queue.get(middle), 2);
+    queue.insert(middle, 15);
+    queue.pop_front();
+    EXPECT_EQ(contents(queue), (std::vector<long>{1, 15, 2}));
+    EXPECT_EQ(queue.back_handle(), middle);
+}
+
+TEST(DurableCircularList, test_checkpoint) {
+    std::string directory = fresh_directory("checkpoint");
+    {
+        Queue queue(directory);
+        for (long i = 0; i < 100; ++i) queue.push_back(i);
+        for (int i = 0; i < 40; ++i) queue.pop_front();
+        queue.checkpoint();
+        EXPECT_EQ(queue.wal_bytes(), 0);
+        queue.push_back(100);
+        queue.pop_front();
+    }
+    std::vector<long> expected;
+    for (long i = 41; i <= 100; ++i) expected.push_back(i);
+    {
+        Queue queue(directory);
+        EXPECT_EQ(contents(queue), expected);
+        EXPECT_EQ(queue.last_sequence(), 142);
+    }
+
+    // Журнал сворачивается сам, когда перерастает checkpoint_bytes
+    WalOptions options;
+    options.checkpoint_bytes = 4096;
+    {
+        Queue queue(directory, options);
+        for (long i = 0; i < 1000; ++i) {
+            queue.push_back(i);
+            queue.pop_front();
+        }
+        EXPECT_LT(queue.wal_bytes(), 4096);
+        expected = contents(queue);
+    }
+    EXPECT_EQ(contents(Queue(directory)), expected);
+}
+
+TEST(DurableCircularList, test_old_records_after_checkpoint) {
+    // Падение между переименованием снимка и очисткой журнала: записи,
+    // уже вошедшие в снимок, не применяются повторно
+    std::string directory = fresh_directory("old-records");
+    std::string saved = directory + "-wal";
+    {
+        Queue queue(directory);
+        for (long i = 0; i < 10; ++i) queue.push_back(i);
+        queue.pop_front();
+        queue.sync();
+        std::filesystem::copy_file(
+            directory + "/wal", saved,
+            std::filesystem::copy_options::overwrite_existing);
+        queue.checkpoint();
+    }
+    std::filesystem::copy_file(
+        saved, directory + "/wal",
+        std::filesystem::copy_options::overwrite_existing);
+    Queue queue(directory);
+    EXPECT_EQ(contents(queue), (std::vector<long>{1, 2, 3, 4, 5, 6, 7, 8, 9}));
+    queue.push_back(10);
+    EXPECT_EQ(queue.last_sequence(), 12);
+}
+
+TEST(DurableCircularList, test_torn_tail) {
+    std::string directory = fresh_directory("torn");
+    {
+        Queue queue(directory);
+        for (long i = 0; i < 5; ++i) queue.push_back(i);
+    }
+    std::string wal = directory + "/wal";
+    size_t size = std::filesystem::file_size(wal);
+    size_t record = size / 5;
+    // Последняя запись оборвана на середине
+    std::filesystem::resize_file(wal, size - record / 2);
+    {
+        Queue queue(directory);
+        EXPECT_EQ(contents(queue), (std::vector<long>{0, 1, 2, 3}));
+        EXPECT_EQ(std::filesystem::file_size(wal), 4 * record);
+        queue.push_back(40);
+    }
+    // Испорченная запись отбрасывается вместе со всем, что за ней
+    {
+        std::FILE* file = std::fopen(wal.c_str(), "r+b");
+        ASSERT_NE(file, nullptr);
+        std::fseek(file, long(2 * record + 12), SEEK_SET);
+        std::fputc(0x5a, file);
+        std::fclose(file);
+    }
+    Queue queue(directory);
+    EXPECT_EQ(contents(queue), (std::vector<long>{0, 1}));
+}
+
+TEST(DurableCircularList, test_failed_write_is_retried) {
+    std::string directory = fresh_directory("failed-write");
+    std::string wal = directory + "/wal";
+    WalOptions options;
+    options.group_size = 1000;
+    options.group_delay = std::chrono::hours(1);
+    {
+        Queue queue(directory, options);
+        for (long i = 0; i < 10; ++i) queue.push_back(i);
+        queue.sync();
+        size_t record = queue.wal_bytes() / 10;
+
+        // Предел размера файла обрывает вторую запись на середине
+        rlimit saved;
+        ASSERT_EQ(::getrlimit(RLIMIT_FSIZE, &saved), 0);
+        rlimit limited = saved;
+        limited.rlim_cur = rlim_t(11 * record + record / 2);
+        auto handler = std::signal(SIGXFSZ, SIG_IGN);
+        ASSERT_EQ(::setrlimit(RLIMIT_FSIZE, &limited), 0);
+        queue.push_back(10);
+        EXPECT_THROW(queue.push_back(11), std::system_error);
+        EXPECT_THROW(queue.push_back(12), std::system_error);
+        ::setrlimit(RLIMIT_FSIZE, &saved);
+        std::signal(SIGXFSZ, handler);
+
+        // Оборванная запись убрана, изменения остались в памяти, а повтор
+        // пишет неудавшиеся записи целиком
+        EXPECT_EQ(std::filesystem::file_size(wal), 11 * record);
+        EXPECT_EQ(queue.size(), 13);
+        EXPECT_EQ(queue.durable_sequence(), 10);
+        for (long i = 13; i < 20; ++i) queue.push_back(i);
+        EXPECT_EQ(std::filesystem::file_size(wal), 20 * record);
+        queue.sync();
+        EXPECT_EQ(queue.durable_sequence(), 20);
+        queue.push_back(20);
+    }
+    std::vector<long> expected;
+    for (long i = 0; i <= 20; ++i) expected.push_back(i);
+    EXPECT_EQ(contents(Queue(directory)), expected);
+}
+
+TEST(DurableCircularList, test_fsync_policies) {
+    for (FsyncPolicy policy :
+         {FsyncPolicy::always, FsyncPolicy::group, FsyncPolicy::none}) {
+        std::string directory = fresh_directory("policy");
+        WalOptions options;
+        options.fsync = policy;
+        options.group_size = 8;
+        options.group_delay = std::chrono::hours(1);
+        {
+            Queue queue(directory, options);
+            for (long i = 0; i < 63; ++i) queue.push_back(i);
+            size_t expected_syncs = policy == FsyncPolicy::always ? 63
+                                    : policy == FsyncPolicy::group ? 7
+                                                                   : 0;
+            EXPECT_EQ(queue.sync_count(), expected_syncs);
+            // Неполная группа ждёт sync()
+            EXPECT_EQ(queue.durable_sequence(),
+                      policy == FsyncPolicy::group ? 56 : 63);
+            // Записи уже в файле при любой политике: их видит процесс,
+            // открывший каталог до sync() и до закрытия queue
+            EXPECT_EQ(Queue(directory, options).size(), 63);
+            queue.sync();
+            EXPECT_EQ(queue.durable_sequence(), 63);
+        }
+        EXPECT_EQ(Queue(directory, options).size(), 63);
+    }
+
+    WalOptions options;
+    options.group_size = 0;
+    EXPECT_THROW(Queue(fresh_directory("bad"), options),
+                 std::invalid_argument);
+}
+
+TEST(DurableCircularList, test_random_against_deque) {
+    std::string directory = fresh_directory("random");
+    std::mt19937 random(75);
+    std::deque<long> model;
+    WalOptions options;
+    options.fsync = FsyncPolicy::none;
+    options.checkpoint_bytes = 1 << 14;
+    for (int round = 0; round < 10; ++round) {
+        Queue queue(directory, options);
+        ASSERT_EQ(contents(queue), std::vector<long>(model.begin(),
+                                                     model.end()));
+        for (int step = 0; step < 500; ++step) {
+            long value = round * 1000 + step;
+            switch (random() % 4) {
+                case 0:
+                    queue.push_back(value);
+                    model.push_back(value);
+                    break;
+                case 1:
+                    queue.push_front(value);
+                    model.push_front(value);
+                    break;
+                case 2:
+                    if (!model.empty()) {
+                        queue.pop_front();
+                        model.pop_front();
+                    }
+                    break;
+                default:
+                    if (!model.empty()) {
+                        queue.pop_back();
+                        model.pop_back();
+                    }
+            }
+        }
+    }
+}
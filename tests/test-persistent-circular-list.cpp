@@ -0,0 +1,171 @@
+/* Platon Lukyanov st128133@student.spbu.ru
+ * Problem 7
+ */
+#include <algorithm>
+#include <deque>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "PersistentCircularList.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+template <typename T>
+std::vector<T> contents(const PersistentCircularList<T>& list) {
+    std::vector<T> result;
+    list.for_each([&result](const T& value) { result.push_back(value); });
+    return result;
+}
+
+}  // namespace
+
+TEST(PersistentCircularList, test_empty) {
+    PersistentCircularList<int> list;
+    EXPECT_TRUE(list.empty());
+    EXPECT_EQ(list.size(), 0);
+    EXPECT_EQ(list.begin(), list.end());
+    EXPECT_THROW(list.front(), std::out_of_range);
+    EXPECT_THROW(list.back(), std::out_of_range);
+    EXPECT_THROW(list.at(0), std::out_of_range);
+    EXPECT_THROW(list.pop_back(), std::out_of_range);
+    EXPECT_THROW(list.pop_front(), std::out_of_range);
+    EXPECT_THROW(list.erase(0), std::out_of_range);
+    EXPECT_THROW(list.insert(1, 0), std::out_of_range);
+    EXPECT_TRUE(list.rotate(5).empty());
+}
+
+TEST(PersistentCircularList, test_versions_are_independent) {
+    PersistentCircularList<std::string> v0;
+    auto v1 = v0.push_back("b");
+    auto v2 = v1.push_front("a").push_back("c");
+    auto v3 = v2.set(1, "B");
+    auto v4 = v3.erase(0);
+    auto v5 = v2.insert(3, "d");
+
+    EXPECT_TRUE(v0.empty());
+    EXPECT_EQ(contents(v1), (std::vector<std::string>{"b"}));
+    EXPECT_EQ(contents(v2), (std::vector<std::string>{"a", "b", "c"}));
+    EXPECT_EQ(contents(v3), (std::vector<std::string>{"a", "B", "c"}));
+    EXPECT_EQ(contents(v4), (std::vector<std::string>{"B", "c"}));
+    EXPECT_EQ(contents(v5), (std::vector<std::string>{"a", "b", "c", "d"}));
+    EXPECT_EQ(v2.front(), "a");
+    EXPECT_EQ(v2.back(), "c");
+    EXPECT_EQ(v5.pop_back(), v2);
+    EXPECT_EQ(v2.pop_front().pop_front().front(), "c");
+}
+
+TEST(PersistentCircularList, test_rotate) {
+    PersistentCircularList<int> list;
+    for (int i = 0; i < 5; ++i) list = list.push_back(i);
+    auto rotated = list.rotate(2);
+    EXPECT_EQ(contents(rotated), (std::vector<int>{2, 3, 4, 0, 1}));
+    EXPECT_EQ(contents(list.rotate(-1)), (std::vector<int>{4, 0, 1, 2, 3}));
+    EXPECT_EQ(list.rotate(7), rotated);
+    EXPECT_EQ(rotated.front(), 2);
+    EXPECT_EQ(rotated.back(), 1);
+    EXPECT_EQ(rotated[3], 0);
+
+    // Изменения повёрнутой версии учитывают смещение
+    EXPECT_EQ(contents(rotated.set(3, 9)),
+              (std::vector<int>{2, 3, 4, 9, 1}));
+    EXPECT_EQ(contents(rotated.push_back(5)),
+              (std::vector<int>{2, 3, 4, 0, 1, 5}));
+    EXPECT_EQ(contents(rotated.erase(1)), (std::vector<int>{2, 4, 0, 1}));
+    EXPECT_EQ(contents(list), (std::vector<int>{0, 1, 2, 3, 4}));
+}
+
+TEST(PersistentCircularList, test_iterators) {
+    PersistentCircularList<int> list;
+    for (int i = 1; i <= 4; ++i) list = list.push_back(i * 10);
+    list = list.rotate(1);
+    std::vector<int> forward(list.begin(), list.end());
+    EXPECT_EQ(forward, (std::vector<int>{20, 30, 40, 10}));
+    std::vector<int> backward(list.rbegin(), list.rend());
+    EXPECT_EQ(backward, (std::vector<int>{10, 40, 30, 20}));
+    EXPECT_EQ(*--list.end(), 10);
+    EXPECT_THROW(*list.end(), std::out_of_range);
+    // Итератор на begin() переходит на последний элемент кольца
+    auto it = list.begin();
+    EXPECT_EQ(*--it, 10);
+}
+
+TEST(PersistentCircularList, test_circular_list_conversion) {
+    CircularList<int> source;
+    for (int i = 0; i < 1000; ++i) source.push_back(i);
+    PersistentCircularList<int> list(source);
+    EXPECT_EQ(list.size(), 1000);
+    EXPECT_EQ(list.to_circular_list(), source);
+    EXPECT_EQ(list.at(500), 500);
+
+    // Исходный список не связан со снимком
+    source.pop_front();
+    EXPECT_EQ(list.front(), 0);
+    EXPECT_TRUE(PersistentCircularList<int>(CircularList<int>()).empty());
+}
+
+TEST(PersistentCircularList, test_comparisons) {
+    PersistentCircularList<int> a, b;
+    a = a.push_back(1).push_back(2);
+    b = b.push_back(2).push_back(1);
+    EXPECT_NE(a, b);
+    EXPECT_EQ(a.rotate(1), b);
+    EXPECT_LT(a, b);
+    EXPECT_GT(b, a);
+    EXPECT_LE(a, a.push_back(0));
+    EXPECT_GE(a, a.pop_back());
+    EXPECT_LT(a.pop_back(), a);
+}
+
+TEST(PersistentCircularList, test_random_against_deque) {
+    std::mt19937 random(63);
+    std::vector<PersistentCircularList<int>> versions(1);
+    std::vector<std::deque<int>> expected(1);
+    for (int step = 0; step < 3000; ++step) {
+        size_t from = random() % versions.size();
+        auto list = versions[from];
+        auto model = expected[from];
+        size_t n = model.size();
+        switch (random() % 5) {
+            case 0:
+            case 1: {
+                size_t index = random() % (n + 1);
+                list = list.insert(index, step);
+                model.insert(model.begin() + index, step);
+                break;
+            }
+            case 2:
+                if (n > 0) {
+                    size_t index = random() % n;
+                    list = list.erase(index);
+                    model.erase(model.begin() + index);
+                }
+                break;
+            case 3:
+                if (n > 0) {
+                    size_t index = random() % n;
+                    list = list.set(index, -step);
+                    model[index] = -step;
+                }
+                break;
+            default:
+                if (n > 0) {
+                    int shift = int(random() % (2 * n)) - int(n);
+                    list = list.rotate(shift);
+                    size_t steps = size_t((shift % int(n) + int(n)) % int(n));
+                    std::rotate(model.begin(), model.begin() + steps,
+                                model.end());
+                }
+        }
+        ASSERT_EQ(contents(list),
+                  std::vector<int>(model.begin(), model.end()));
+        versions.push_back(list);
+        expected.push_back(model);
+    }
+    // Старые версии не изменились
+    for (size_t i = 0; i < versions.size(); i += 97) {
+        ASSERT_EQ(contents(versions[i]),
+                  std::vector<int>(expected[i].begin(), expected[i].end()));
+    }
+}
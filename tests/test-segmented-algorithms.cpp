@@ -0,0 +1,182 @@
+/* Platon Lukyanov st128133@student.spbu.ru
+ * Problem 7
+ */
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+#include "CircularList.h"
+#include "SegmentedAlgorithms.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+template <typename T>
+std::vector<T> make_values(size_t n) {
+    std::vector<T> values(n);
+    for (size_t i = 0; i < n; ++i) {
+        values[i] = static_cast<T>(int32_t((i * 7919) % 1000) - 500);
+    }
+    return values;
+}
+
+template <typename T>
+void expect_kernels_match_scalar(const std::vector<T>& values) {
+    namespace d = segmented::detail;
+    const T* data = values.data();
+    size_t n = values.size();
+    for (T needle : {values[n / 2], values[n - 1], T(12345)}) {
+        EXPECT_EQ(d::find_index(data, n, needle),
+                  d::scalar::find(data, n, needle));
+        EXPECT_EQ(d::count(data, n, needle), d::scalar::count(data, n, needle));
+    }
+    EXPECT_EQ(d::min_index(data, n), d::scalar::min_index(data, n));
+    EXPECT_EQ(d::max_index(data, n), d::scalar::max_index(data, n));
+    EXPECT_EQ(d::accumulate(data, n, T(0)),
+              d::scalar::accumulate(data, n, T(0)));
+}
+
+#ifdef SEGMENTED_HAS_X86_KERNELS
+// Ядра одного набора инструкций под общими именами, чтобы проверять их
+// одним шаблоном в обход диспетчеризации
+#define SEGMENTED_KERNELS(Name, isa)                                      \
+    struct Name {                                                         \
+            template <typename T>                                         \
+            static size_t find(const T* data, size_t n, T value) {        \
+                return segmented::detail::isa::find(data, n, value);      \
+            }                                                             \
+            template <typename T>                                         \
+            static size_t count(const T* data, size_t n, T value) {       \
+                return segmented::detail::isa::count(data, n, value);     \
+            }                                                             \
+            template <typename T>                                         \
+            static T min_value(const T* data, size_t n) {                 \
+                return segmented::detail::isa::min_value(data, n);        \
+            }                                                             \
+            template <typename T>                                         \
+            static T max_value(const T* data, size_t n) {                 \
+                return segmented::detail::isa::max_value(data, n);        \
+            }                                                             \
+            template <typename T>                                         \
+            static T sum(const T* data, size_t n) {                       \
+                return segmented::detail::isa::sum(data, n);              \
+            }                                                             \
+    }
+
+SEGMENTED_KERNELS(Sse41Kernels, sse41);
+SEGMENTED_KERNELS(Avx2Kernels, avx2);
+#undef SEGMENTED_KERNELS
+
+// Длины вокруг ширины векторов (4 и 8 элементов) и их кратных, где
+// векторная часть сменяется скалярным хвостом
+std::vector<size_t> lengths_around_vector_widths() {
+    std::vector<size_t> lengths;
+    for (size_t n = 1; n <= 40; ++n) lengths.push_back(n);
+    for (size_t n : {255, 256, 257, 1000, 1003}) lengths.push_back(n);
+    return lengths;
+}
+
+template <typename Kernels, typename T>
+void expect_isa_matches_scalar(const std::vector<T>& values) {
+    namespace s = segmented::detail::scalar;
+    const T* data = values.data();
+    size_t n = values.size();
+    SCOPED_TRACE(n);
+    for (T needle : {values[0], values[n / 2], values[n - 1], T(12345)}) {
+        EXPECT_EQ(Kernels::find(data, n, needle), s::find(data, n, needle));
+        EXPECT_EQ(Kernels::count(data, n, needle), s::count(data, n, needle));
+    }
+    EXPECT_EQ(Kernels::min_value(data, n), data[s::min_index(data, n)]);
+    EXPECT_EQ(Kernels::max_value(data, n), data[s::max_index(data, n)]);
+    EXPECT_EQ(Kernels::sum(data, n), s::accumulate(data, n, T(0)));
+}
+
+template <typename Kernels, typename T>
+void expect_isa_matches_scalar() {
+    for (size_t n : lengths_around_vector_widths()) {
+        expect_isa_matches_scalar<Kernels>(make_values<T>(n));
+        // Повторы: count и find видят совпадения и в векторах, и в хвосте
+        std::vector<T> repeated(n);
+        for (size_t i = 0; i < n; ++i) repeated[i] = static_cast<T>(i % 3);
+        expect_isa_matches_scalar<Kernels>(repeated);
+    }
+}
+#endif
+
+}  // namespace
+
+TEST(SegmentedAlgorithms, test_int32_kernels) {
+    for (size_t n : {16, 17, 31, 1000, 1003}) {
+        expect_kernels_match_scalar(make_values<int32_t>(n));
+    }
+}
+
+TEST(SegmentedAlgorithms, test_float_kernels) {
+    for (size_t n : {16, 17, 31, 1000, 1003}) {
+        expect_kernels_match_scalar(make_values<float>(n));
+    }
+}
+
+#ifdef SEGMENTED_HAS_X86_KERNELS
+TEST(SegmentedAlgorithms, test_sse41_kernels) {
+    __builtin_cpu_init();
+    if (!__builtin_cpu_supports("sse4.1")) GTEST_SKIP() << "no SSE4.1";
+    expect_isa_matches_scalar<Sse41Kernels, int32_t>();
+    expect_isa_matches_scalar<Sse41Kernels, float>();
+}
+
+TEST(SegmentedAlgorithms, test_avx2_kernels) {
+    __builtin_cpu_init();
+    if (!__builtin_cpu_supports("avx2")) GTEST_SKIP() << "no AVX2";
+    expect_isa_matches_scalar<Avx2Kernels, int32_t>();
+    expect_isa_matches_scalar<Avx2Kernels, float>();
+}
+#endif
+
+TEST(SegmentedAlgorithms, test_value_not_representable) {
+    std::vector<int32_t> values(64, 3);
+    EXPECT_EQ(segmented::detail::find_index(values.data(), values.size(), 3.5),
+              values.size());
+    EXPECT_EQ(segmented::detail::count(values.data(), values.size(), 3.5), 0);
+    EXPECT_EQ(segmented::detail::count(values.data(), values.size(), 3.0), 64);
+    EXPECT_EQ(segmented::detail::count(values.data(), values.size(), 1e20), 0);
+    EXPECT_EQ(segmented::detail::count(values.data(), values.size(),
+                                       std::numeric_limits<double>::quiet_NaN()),
+              0);
+    EXPECT_EQ(segmented::detail::count(values.data(), values.size(), 3L), 64);
+    EXPECT_EQ(segmented::detail::count(values.data(), values.size(),
+                                       int64_t(1) << 40),
+              0);
+
+    std::vector<float> floats(64, 0.5f);
+    floats[40] = std::numeric_limits<float>::infinity();
+    EXPECT_EQ(segmented::detail::count(floats.data(), floats.size(), 1e300), 0);
+    EXPECT_EQ(segmented::detail::count(floats.data(), floats.size(), 0.5), 63);
+    EXPECT_EQ(segmented::detail::find_index(
+                  floats.data(), floats.size(),
+                  std::numeric_limits<double>::infinity()),
+              40);
+}
+
+TEST(SegmentedAlgorithms, test_list_algorithms) {
+    CircularList<int32_t> list;
+    EXPECT_TRUE(segmented::find(list, 1) == list.end());
+    EXPECT_TRUE(segmented::min_element(list) == list.end());
+    EXPECT_EQ(segmented::accumulate(list, 0), 0);
+
+    for (int32_t value : {4, -2, 7, -2, 7, 1}) list.push_back(value);
+    EXPECT_EQ(*segmented::find(list, 7), 7);
+    EXPECT_TRUE(segmented::find(list, 8) == list.end());
+    EXPECT_EQ(segmented::count(list, -2), 2);
+    EXPECT_EQ(segmented::accumulate(list, 0), 15);
+
+    auto min = segmented::min_element(list);
+    EXPECT_EQ(*min, -2);
+    EXPECT_TRUE(min == ++list.begin());
+    EXPECT_TRUE(segmented::max_element(list) == ++(++list.begin()));
+
+    const CircularList<int32_t>& clist = list;
+    EXPECT_EQ(*segmented::find(clist, 1), 1);
+    EXPECT_EQ(*segmented::max_element(clist), 7);
+}
@@ -0,0 +1,154 @@
+/* Platon Lukyanov st128133@student.spbu.ru
+ * Problem 7
+ */
+#include <random>
+#include <string>
+#include <vector>
+
+#include "SlotCircularList.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+template <typename T>
+std::vector<T> contents(const SlotCircularList<T>& list) {
+    return std::vector<T>(list.begin(), list.end());
+}
+
+}  // namespace
+
+TEST(SlotCircularList, test_handle_is_small) {
+    static_assert(sizeof(SlotCircularList<std::string>::Handle) == 8);
+    SlotCircularList<int> list;
+    SlotCircularList<int>::Handle none;
+    EXPECT_FALSE(list.contains(none));
+    EXPECT_EQ(list.get(none), nullptr);
+    EXPECT_FALSE(list.erase(none));
+    EXPECT_THROW(list.front(), std::out_of_range);
+    EXPECT_THROW(list.front_handle(), std::out_of_range);
+    EXPECT_THROW(list.pop_back(), std::out_of_range);
+    EXPECT_THROW(list.next(none), std::invalid_argument);
+    EXPECT_THROW(list.insert(none, 1), std::invalid_argument);
+}
+
+TEST(SlotCircularList, test_push_get_erase) {
+    SlotCircularList<std::string> list;
+    auto b = list.push_back("b");
+    auto a = list.push_front("a");
+    auto c = list.push_back("c");
+    EXPECT_EQ(contents(list), (std::vector<std::string>{"a", "b", "c"}));
+    EXPECT_EQ(*list.get(b), "b");
+    *list.get(b) = "B";
+    EXPECT_EQ(list.front_handle(), a);
+    EXPECT_EQ(list.back_handle(), c);
+    EXPECT_EQ(list.next(c), a);
+    EXPECT_EQ(list.prev(a), c);
+
+    EXPECT_TRUE(list.erase(b));
+    EXPECT_FALSE(list.erase(b));
+    EXPECT_FALSE(list.contains(b));
+    EXPECT_EQ(list.get(b), nullptr);
+    EXPECT_EQ(list.next(a), c);
+    EXPECT_EQ(contents(list), (std::vector<std::string>{"a", "c"}));
+}
+
+TEST(SlotCircularList, test_reused_slot_rejects_old_handle) {
+    SlotCircularList<int> list;
+    auto old = list.push_back(1);
+    list.push_back(2);
+    list.erase(old);
+    auto reused = list.push_back(3);
+    EXPECT_EQ(reused.slot, old.slot);
+    EXPECT_NE(reused.generation, old.generation);
+    EXPECT_EQ(list.get(old), nullptr);
+    EXPECT_EQ(*list.get(reused), 3);
+    EXPECT_EQ(list.capacity(), 2);
+
+    list.clear();
+    EXPECT_FALSE(list.contains(reused));
+    EXPECT_EQ(list.capacity(), 2);
+    auto fresh = list.push_front(4);
+    EXPECT_LT(fresh.slot, 2);
+    EXPECT_EQ(list.size(), 1);
+}
+
+TEST(SlotCircularList, test_handles_survive_growth_and_copy) {
+    SlotCircularList<std::string> list;
+    auto first = list.push_back("first");
+    std::vector<SlotCircularList<std::string>::Handle> handles;
+    for (int i = 0; i < 1000; ++i)
+        handles.push_back(list.push_back(std::to_string(i)));
+    auto middle = list.insert(handles[500], "middle");
+    EXPECT_EQ(*list.get(first), "first");
+    EXPECT_EQ(list.prev(handles[500]), middle);
+
+    SlotCircularList<std::string> copy = list;
+    EXPECT_EQ(copy, list);
+    EXPECT_EQ(*copy.get(handles[999]), "999");
+    copy.erase(handles[0]);
+    EXPECT_TRUE(list.contains(handles[0]));
+    EXPECT_FALSE(copy.contains(handles[0]));
+    EXPECT_GT(copy, list);
+
+    SlotCircularList<std::string> moved = std::move(list);
+    EXPECT_TRUE(list.empty());
+    EXPECT_EQ(*moved.get(middle), "middle");
+}
+
+TEST(SlotCircularList, test_insert_own_element_during_growth) {
+    // Вставляемое значение лежит в пуле, который переезжает при росте
+    SlotCircularList<std::string> list;
+    std::string value(40, 'x');
+    list.push_back(value);
+    for (int i = 0; i < 100; ++i) {
+        list.push_back(list.front());
+        list.push_front(list.back());
+        list.insert(list.back_handle(), list.front());
+    }
+    EXPECT_EQ(list.size(), 301);
+    list.for_each([&value](const std::string& s) { EXPECT_EQ(s, value); });
+}
+
+TEST(SlotCircularList, test_iterators) {
+    SlotCircularList<int> list;
+    for (int i = 0; i < 4; ++i) list.push_back(i);
+    auto it = list.begin();
+    ++it;
+    EXPECT_EQ(*list.get(it.handle()), 1);
+    for (int& value : list) value *= 10;
+    std::vector<int> reversed(list.rbegin(), list.rend());
+    EXPECT_EQ(reversed, (std::vector<int>{30, 20, 10, 0}));
+    EXPECT_EQ(*--list.end(), 30);
+    EXPECT_THROW(list.end().handle(), std::out_of_range);
+    int sum = 0;
+    list.for_each([&sum](int value) {
+        sum += value;
+        return value < 10;
+    });
+    EXPECT_EQ(sum, 10);
+}
+
+TEST(SlotCircularList, test_random_against_vector) {
+    std::mt19937 random(67);
+    SlotCircularList<int> list;
+    std::vector<std::pair<SlotCircularList<int>::Handle, int>> live;
+    std::vector<SlotCircularList<int>::Handle> dead;
+    for (int step = 0; step < 5000; ++step) {
+        if (live.empty() || random() % 3 != 0) {
+            live.emplace_back(list.push_back(step), step);
+        } else {
+            size_t index = random() % live.size();
+            ASSERT_TRUE(list.erase(live[index].first));
+            dead.push_back(live[index].first);
+            live.erase(live.begin() + index);
+        }
+    }
+    EXPECT_EQ(list.size(), live.size());
+    for (const auto& [handle, value] : live) {
+        ASSERT_EQ(*list.get(handle), value);
+    }
+    for (const auto& handle : dead) ASSERT_FALSE(list.contains(handle));
+    std::vector<int> order;
+    for (const auto& entry : live) order.push_back(entry.second);
+    EXPECT_EQ(contents(list), order);
+}
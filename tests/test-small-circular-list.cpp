@@ -0,0 +1,121 @@
+/* Platon Lukyanov st128133@student.spbu.ru
+ * Problem 7
+ */
+#include <string>
+#include <vector>
+
+#include "SegmentedAlgorithms.h"
+#include "SmallCircularList.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+template <typename List>
+std::vector<typename List::iterator::value_type> contents(const List& list) {
+    return {list.begin(), list.end()};
+}
+
+}  // namespace
+
+TEST(SmallCircularList, test_inline_ring) {
+    SmallCircularList<int, 4> list;
+    EXPECT_TRUE(list.empty());
+    EXPECT_TRUE(list.is_inline());
+    EXPECT_THROW(list.front(), std::out_of_range);
+    EXPECT_THROW(list.pop_back(), std::out_of_range);
+    list.push_back(2);
+    list.push_back(3);
+    list.push_front(1);
+    list.push_front(0);
+    EXPECT_TRUE(list.is_inline());
+    EXPECT_EQ(list.size(), 4);
+    EXPECT_EQ(list.front(), 0);
+    EXPECT_EQ(list.back(), 3);
+    EXPECT_EQ(contents(list), (std::vector<int>{0, 1, 2, 3}));
+    EXPECT_EQ(std::vector<int>(list.rbegin(), list.rend()),
+              (std::vector<int>{3, 2, 1, 0}));
+    list.pop_front();
+    list.pop_back();
+    list.push_back(4);
+    EXPECT_EQ(contents(list), (std::vector<int>{1, 2, 4}));
+}
+
+TEST(SmallCircularList, test_spill_and_return) {
+    SmallCircularList<std::string, 2> list;
+    list.push_back("b");
+    list.push_front("a");
+    list.push_back(list.front());
+    EXPECT_FALSE(list.is_inline());
+    EXPECT_EQ(contents(list), (std::vector<std::string>{"a", "b", "a"}));
+    list.push_front("z");
+    EXPECT_EQ(list.front(), "z");
+    EXPECT_EQ(list.size(), 4);
+    while (!list.empty()) list.pop_back();
+    EXPECT_TRUE(list.is_inline());
+    list.push_back("again");
+    EXPECT_TRUE(list.is_inline());
+    EXPECT_EQ(list.back(), "again");
+}
+
+TEST(SmallCircularList, test_copy_move_swap) {
+    SmallCircularList<std::string, 3> small;
+    small.push_back("x");
+    small.push_back("y");
+    SmallCircularList<std::string, 3> big;
+    for (int i = 0; i < 5; ++i) big.push_back(std::to_string(i));
+
+    SmallCircularList<std::string, 3> small_copy(small);
+    SmallCircularList<std::string, 3> big_copy(big);
+    EXPECT_TRUE(small_copy == small);
+    EXPECT_TRUE(big_copy == big);
+    EXPECT_TRUE(small_copy.is_inline());
+    EXPECT_FALSE(big_copy.is_inline());
+
+    SmallCircularList<std::string, 3> moved(std::move(big_copy));
+    EXPECT_TRUE(big_copy.empty());
+    EXPECT_TRUE(moved == big);
+
+    small_copy.swap(moved);
+    EXPECT_TRUE(small_copy == big);
+    EXPECT_TRUE(moved == small);
+    moved = big;
+    EXPECT_TRUE(moved == big);
+    moved = std::move(small_copy);
+    EXPECT_TRUE(moved == big);
+    EXPECT_TRUE(big < small);
+    EXPECT_TRUE(small >= big);
+    EXPECT_TRUE(small != big);
+}
+
+TEST(SmallCircularList, test_segments) {
+    SmallCircularList<int, 8> list;
+    for (int i = 0; i < 6; ++i) list.push_back(i);
+    for (int i = 0; i < 4; ++i) list.pop_front();
+    for (int i = 6; i < 10; ++i) list.push_back(i);
+    // Кольцо перешло через границу массива: два сегмента
+    std::vector<size_t> sizes;
+    list.for_each_segment(
+        [&](std::span<const int> segment) { sizes.push_back(segment.size()); });
+    EXPECT_EQ(sizes, (std::vector<size_t>{4, 2}));
+    EXPECT_EQ(*segmented::find(list, 8), 8);
+    EXPECT_EQ(segmented::count(list, 9), 1);
+    EXPECT_EQ(segmented::accumulate(list, 0), 4 + 5 + 6 + 7 + 8 + 9);
+    EXPECT_EQ(*segmented::min_element(list), 4);
+    EXPECT_TRUE(segmented::max_element(list) == --list.end());
+
+    for (int i = 10; i < 20; ++i) list.push_back(i);
+    EXPECT_FALSE(list.is_inline());
+    EXPECT_EQ(*segmented::find(list, 15), 15);
+    EXPECT_EQ(segmented::accumulate(list, 0), 4 + 5 + 6 + 7 + 8 + 9 + 145);
+}
+
+TEST(SmallCircularList, test_no_heap_until_overflow) {
+    SmallCircularList<int, 8> list;
+    static_assert(sizeof(list) >= 8 * sizeof(int));
+    for (int round = 0; round < 100; ++round) {
+        for (int i = 0; i < 8; ++i) list.push_back(i);
+        EXPECT_TRUE(list.is_inline());
+        for (int i = 0; i < 8; ++i) list.pop_front();
+    }
+    EXPECT_TRUE(list.empty());
+}
@@ -0,0 +1,170 @@
+/* Platon Lukyanov st128133@student.spbu.ru
+ * Problem 7
+ */
+#include <cstdint>
+#include <deque>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include "SoaCircularList.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+// Отметка времени, значение и флаги
+using Samples = SoaCircularList<int64_t, double, uint8_t>;
+
+template <size_t I, typename List>
+std::vector<typename List::template field_type<I>> column(const List& list) {
+    std::vector<typename List::template field_type<I>> result;
+    list.template for_each_segment<I>([&](auto segment) {
+        result.insert(result.end(), segment.begin(), segment.end());
+    });
+    return result;
+}
+
+}  // namespace
+
+TEST(SoaCircularList, test_push_pop_both_ends) {
+    Samples list;
+    EXPECT_TRUE(list.empty());
+    EXPECT_THROW(list.front(), std::out_of_range);
+    EXPECT_THROW(list.pop_front(), std::out_of_range);
+    list.push_back(2, 2.5, 0);
+    list.push_back(3, 3.5, 1);
+    list.push_front(1, 1.5, 1);
+    EXPECT_EQ(list.size(), 3);
+    EXPECT_EQ(list.front(), std::make_tuple(int64_t(1), 1.5, uint8_t(1)));
+    EXPECT_EQ(list.back(), std::make_tuple(int64_t(3), 3.5, uint8_t(1)));
+    EXPECT_EQ(std::get<1>(list[1]), 2.5);
+    EXPECT_EQ(list.get<0>(2), 3);
+    EXPECT_THROW(list[3], std::out_of_range);
+    EXPECT_THROW(*list.end(), std::out_of_range);
+
+    list.get<2>(0) = 7;
+    list.set(1, 20, 20.5, 2);
+    EXPECT_EQ(column<2>(list), (std::vector<uint8_t>{7, 2, 1}));
+    EXPECT_EQ(column<0>(list), (std::vector<int64_t>{1, 20, 3}));
+    list.pop_front();
+    list.pop_back();
+    EXPECT_EQ(list.front(), std::make_tuple(int64_t(20), 20.5, uint8_t(2)));
+    list.pop_back();
+    EXPECT_TRUE(list.empty());
+    EXPECT_TRUE(list.begin() == list.end());
+}
+
+TEST(SoaCircularList, test_column_segments) {
+    using List = SoaCircularList<int, float>;
+    List list;
+    const int n = 1000;
+    for (int i = 0; i < n; ++i) list.push_back(i, float(i) / 2);
+    for (int i = 1; i <= 100; ++i) list.push_front(-i, 0);
+
+    // Сегменты покрывают столбец по порядку и не длиннее блока
+    size_t segments = 0;
+    long sum = 0;
+    list.for_each_segment<0>([&](std::span<int> segment) {
+        EXPECT_LE(segment.size(), List::kChunkSize);
+        ++segments;
+        for (int value : segment) sum += value;
+    });
+    EXPECT_EQ(sum, long(n) * (n - 1) / 2 - 100 * 101 / 2);
+    size_t chunks = (list.size() + List::kChunkSize - 1) / List::kChunkSize;
+    EXPECT_GE(segments, chunks);
+    EXPECT_LE(segments, chunks + 1);
+
+    auto floats = column<1>(list);
+    EXPECT_EQ(floats.size(), list.size());
+    EXPECT_EQ(floats.back(), float(n - 1) / 2);
+
+    // false прекращает обход
+    size_t visited = 0;
+    list.for_each_segment<0>([&](std::span<int>) {
+        ++visited;
+        return false;
+    });
+    EXPECT_EQ(visited, 1);
+
+    // Обход по записям отдаёт ссылки на поля
+    list.for_each([](int& key, float& value) { value = float(key); });
+    const auto& clist = list;
+    clist.for_each([](const int& key, const float& value) {
+        EXPECT_EQ(float(key), value);
+    });
+}
+
+TEST(SoaCircularList, test_rotate_copy_compare) {
+    SoaCircularList<int> list;
+    for (int i = 0; i < 600; ++i) list.push_back(i);
+    SoaCircularList<int> copy(list);
+    EXPECT_EQ(copy, list);
+    list.rotate(10);
+    EXPECT_EQ(list.get<0>(0), 10);
+    EXPECT_EQ(list.get<0>(599), 9);
+    list.rotate(-20);
+    EXPECT_EQ(list.get<0>(0), 590);
+    list.rotate(610);
+    EXPECT_EQ(list.get<0>(0), 0);
+    EXPECT_EQ(list, copy);
+
+    copy.pop_back();
+    EXPECT_LT(copy, list);
+    EXPECT_GT(list, copy);
+    EXPECT_NE(list, copy);
+    SoaCircularList<int> moved(std::move(copy));
+    EXPECT_TRUE(copy.empty());
+    EXPECT_EQ(moved.size(), 599);
+    copy = moved;
+    EXPECT_EQ(copy, moved);
+    moved = std::move(list);
+    EXPECT_EQ(moved.size(), 600);
+    moved.swap(list);
+    EXPECT_TRUE(moved.empty());
+    EXPECT_EQ(std::get<0>(list.back()), 599);
+}
+
+TEST(SoaCircularList, test_random_against_deque) {
+    std::mt19937 random(71);
+    SoaCircularList<int, short> list;
+    std::deque<int> model;
+    for (int step = 0; step < 20000; ++step) {
+        // Перекос в сторону вставок в начале прогона и удалений в конце
+        bool grow = int(random() % 20000) > step / 2;
+        switch (random() % 4) {
+            case 0:
+                if (grow) {
+                    list.push_back(step, short(step));
+                    model.push_back(step);
+                } else if (!model.empty()) {
+                    list.pop_back();
+                    model.pop_back();
+                }
+                break;
+            case 1:
+                if (grow) {
+                    list.push_front(step, short(step));
+                    model.push_front(step);
+                } else if (!model.empty()) {
+                    list.pop_front();
+                    model.pop_front();
+                }
+                break;
+            case 2:
+                if (!model.empty()) {
+                    list.pop_front();
+                    model.pop_front();
+                }
+                break;
+            default:
+                list.push_back(-step, short(-step));
+                model.push_back(-step);
+        }
+        ASSERT_EQ(list.size(), model.size());
+        if (step % 97 == 0) {
+            ASSERT_EQ(column<0>(list),
+                      std::vector<int>(model.begin(), model.end()));
+        }
+    }
+    EXPECT_EQ(column<0>(list), std::vector<int>(model.begin(), model.end()));
+}
@@ -0,0 +1,188 @@
+/* Platon Lukyanov st128133@student.spbu.ru
+ * Problem 7
+ */
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <deque>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "SpillCircularList.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+struct Message {
+        long id;
+        char payload[24];
+};
+
+// Бюджет на 2 * 16 значений long
+constexpr size_t kBudget = 32 * sizeof(long);
+
+std::string temp_directory() {
+    std::string directory = ::testing::TempDir();
+    if (!directory.empty() && directory.back() == '/') directory.pop_back();
+    return directory;
+}
+
+}  // namespace
+
+TEST(SpillCircularList, test_fits_in_memory) {
+    SpillCircularList<long> list(kBudget, temp_directory());
+    EXPECT_TRUE(list.empty());
+    EXPECT_THROW(list.front(), std::out_of_range);
+    EXPECT_THROW(list.back(), std::out_of_range);
+    EXPECT_THROW(list.pop_front(), std::out_of_range);
+    for (long i = 0; i < 20; ++i) list.push_back(i);
+    EXPECT_EQ(list.size(), 20);
+    EXPECT_EQ(list.front(), 0);
+    EXPECT_EQ(list.back(), 19);
+    for (long i = 0; i < 20; ++i) {
+        EXPECT_EQ(list.front(), i);
+        list.pop_front();
+    }
+    EXPECT_TRUE(list.empty());
+    // Диск не понадобился
+    EXPECT_EQ(list.stats().segments, 0);
+    EXPECT_EQ(list.stats().spilled_bytes, 0);
+
+    EXPECT_THROW(SpillCircularList<long>(3 * sizeof(long)),
+                 std::invalid_argument);
+}
+
+TEST(SpillCircularList, test_spill_and_read_back) {
+    // Сегмент на 40 значений: сброс идёт порциями по 8
+    SpillCircularList<long> list(kBudget, temp_directory(), 40 * sizeof(long),
+                                 64);
+    const long n = 1000;
+    for (long i = 0; i < n; ++i) {
+        list.push_back(i);
+        ASSERT_EQ(list.back(), i);
+        ASSERT_EQ(list.front(), 0);
+        ASSERT_LE(list.memory_size(), 32);
+    }
+    EXPECT_EQ(list.size(), n);
+    EXPECT_GT(list.spilled_size(), 0);
+    EXPECT_EQ(list.memory_size() + list.spilled_size(), list.size());
+    EXPECT_GT(list.stats().segments, 1);
+    EXPECT_EQ(list.stats().spilled_bytes, list.spilled_size() * sizeof(long));
+
+    for (long i = 0; i < n; ++i) {
+        ASSERT_EQ(list.front(), i);
+        list.pop_front();
+        ASSERT_LE(list.memory_size(), 32);
+    }
+    EXPECT_TRUE(list.empty());
+    const SpillStats& stats = list.stats();
+    EXPECT_EQ(stats.read_back_bytes, stats.spilled_bytes);
+    EXPECT_GT(stats.spill_seconds, 0);
+    EXPECT_GT(stats.read_back_bandwidth(), 0);
+    EXPECT_GT(stats.spill_bandwidth(), 0);
+}
+
+TEST(SpillCircularList, test_move_clear_swap) {
+    SpillCircularList<Message> list(8 * sizeof(Message), temp_directory());
+    for (long i = 0; i < 100; ++i) list.push_back(Message{i, "payload"});
+    EXPECT_GT(list.spilled_size(), 0);
+
+    SpillCircularList<Message> moved(std::move(list));
+    EXPECT_TRUE(list.empty());
+    EXPECT_EQ(moved.size(), 100);
+    EXPECT_EQ(moved.front().id, 0);
+    EXPECT_EQ(moved.back().id, 99);
+
+    SpillCircularList<Message> other(8 * sizeof(Message), temp_directory());
+    other.push_back(Message{-1, "other"});
+    other.swap(moved);
+    EXPECT_EQ(moved.size(), 1);
+    EXPECT_EQ(other.size(), 100);
+    moved = std::move(other);
+    EXPECT_EQ(moved.size(), 100);
+
+    moved.clear();
+    EXPECT_TRUE(moved.empty());
+    EXPECT_EQ(moved.spilled_size(), 0);
+    moved.push_back(Message{7, "again"});
+    EXPECT_EQ(moved.front().id, 7);
+}
+
+TEST(SpillCircularList, test_missing_directory) {
+    SpillCircularList<long> list(kBudget, "/nonexistent/spill/directory");
+    for (long i = 0; i < 31; ++i) list.push_back(i);
+    // 32-е значение заполняет хвост и требует сегмент
+    EXPECT_THROW(list.push_back(31), std::system_error);
+}
+
+#if defined(__linux__)
+TEST(SpillCircularList, test_failed_read_back_keeps_queue) {
+    SpillCircularList<long> list(kBudget, temp_directory());
+    for (long i = 0; i < 200; ++i) list.push_back(i);
+    ASSERT_GT(list.spilled_size(), 0);
+
+    // Дескрипторы сегментов (удалённые файлы spill-*) подменяются
+    // открытым только на запись /dev/null: pread вернёт EBADF
+    std::vector<std::pair<int, int>> saved;
+    int null_fd = ::open("/dev/null", O_WRONLY);
+    ASSERT_GE(null_fd, 0);
+    std::vector<int> fds;
+    for (const auto& link :
+         std::filesystem::directory_iterator("/proc/self/fd")) {
+        std::error_code error;
+        auto target = std::filesystem::read_symlink(link.path(), error);
+        if (!error && target.string().find("/spill-") != std::string::npos)
+            fds.push_back(std::stoi(link.path().filename().string()));
+    }
+    ASSERT_FALSE(fds.empty());
+    for (int fd : fds) {
+        saved.emplace_back(fd, ::dup(fd));
+        ::dup2(null_fd, fd);
+    }
+
+    // Голова на 16 значений: снятие последнего из них читает сегмент
+    for (long i = 0; i < 15; ++i) list.pop_front();
+    EXPECT_THROW(list.pop_front(), std::system_error);
+    EXPECT_EQ(list.size(), 185);
+    EXPECT_EQ(list.front(), 15);
+    EXPECT_EQ(list.stats().read_back_bytes, 0);
+
+    for (auto [fd, copy] : saved) {
+        ::dup2(copy, fd);
+        ::close(copy);
+    }
+    ::close(null_fd);
+    for (long i = 15; i < 200; ++i) {
+        ASSERT_EQ(list.front(), i);
+        list.pop_front();
+    }
+    EXPECT_TRUE(list.empty());
+}
+#endif
+
+TEST(SpillCircularList, test_random_against_deque) {
+    std::mt19937 random(74);
+    SpillCircularList<long> list(kBudget, temp_directory(), 64 * sizeof(long));
+    std::deque<long> model;
+    for (long step = 0; step < 50000; ++step) {
+        // Производитель то обгоняет потребителя, то отстаёт от него
+        bool produce = (step / 5000) % 2 == 0 ? random() % 3 != 0
+                                               : random() % 3 == 0;
+        if (produce) {
+            list.push_back(step);
+            model.push_back(step);
+        } else if (!model.empty()) {
+            ASSERT_EQ(list.front(), model.front());
+            list.pop_front();
+            model.pop_front();
+        }
+        ASSERT_EQ(list.size(), model.size());
+        if (!model.empty()) {
+            ASSERT_EQ(list.front(), model.front());
+            ASSERT_EQ(list.back(), model.back());
+        }
+    }
+}
@@ -0,0 +1,334 @@
+/* Platon Lukyanov st128133@student.spbu.ru
+ * Problem 7
+ */
+#include <array>
+#include <deque>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "SplitCircularList.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+struct Record {
+        long id;
+        std::array<char, 192> body;
+        bool operator==(const Record& other) const {
+            return id == other.id && body == other.body;
+        }
+        bool operator!=(const Record& other) const {
+            return !(*this == other);
+        }
+};
+
+struct RecordId {
+        long operator()(const Record& record) const {
+            return record.id;
+        }
+};
+
+Record make_record(long id) {
+    Record record{id, {}};
+    record.body.fill(char('a' + id % 26));
+    return record;
+}
+
+// Считает живые объекты, чтобы проверять отсутствие утечек
+struct Counted {
+        static inline int live = 0;
+        long id;
+        explicit Counted(long id) : id(id) {
+            ++live;
+        }
+        Counted(const Counted& other) : id(other.id) {
+            ++live;
+        }
+        ~Counted() {
+            --live;
+        }
+        bool operator==(const Counted& other) const {
+            return id == other.id;
+        }
+};
+
+// Бросает исключение на отрицательных идентификаторах
+struct ThrowingId {
+        long operator()(const Counted& value) const {
+            if (value.id < 0) throw std::runtime_error("bad id");
+            return value.id;
+        }
+};
+
+template <typename List>
+std::vector<typename List::value_type> contents(const List& list) {
+    return {list.begin(), list.end()};
+}
+
+}  // namespace
+
+TEST(SplitCircularList, test_push_pop_both_ends) {
+    SplitCircularList<std::string> list;
+    EXPECT_TRUE(list.empty());
+    EXPECT_THROW(list.front(), std::out_of_range);
+    EXPECT_THROW(list.pop_back(), std::out_of_range);
+    list.push_back("b");
+    list.push_back("c");
+    list.push_front("a");
+    EXPECT_EQ(list.size(), 3);
+    EXPECT_EQ(list.front(), "a");
+    EXPECT_EQ(list.back(), "c");
+    EXPECT_EQ(contents(list), (std::vector<std::string>{"a", "b", "c"}));
+    EXPECT_EQ(std::vector<std::string>(list.rbegin(), list.rend()),
+              (std::vector<std::string>{"c", "b", "a"}));
+    list.front() = "A";
+    list.pop_back();
+    list.pop_front();
+    EXPECT_EQ(contents(list), (std::vector<std::string>{"b"}));
+    list.clear();
+    EXPECT_TRUE(list.empty());
+    EXPECT_TRUE(list.begin() == list.end());
+}
+
+TEST(SplitCircularList, test_insert_erase_and_reuse) {
+    SplitCircularList<int> list;
+    for (int i = 0; i < 200; ++i) list.push_back(i);
+    // Значение, на которое ссылаются, не перемещается при росте
+    const int* first = &list.front();
+    for (int i = 200; i < 1000; ++i) list.push_back(i);
+    EXPECT_EQ(first, &list.front());
+
+    auto it = list.nth(10);
+    EXPECT_EQ(*it, 10);
+    it = list.erase(it);
+    EXPECT_EQ(*it, 11);
+    it = list.insert(it, -1);
+    EXPECT_EQ(*it, -1);
+    EXPECT_EQ(list.index_of(it), 10);
+    EXPECT_THROW(list.erase(list.end()), std::invalid_argument);
+
+    // Освобождённые узлы используются повторно
+    for (int round = 0; round < 5; ++round) {
+        while (!list.empty()) list.pop_front();
+        for (int i = 0; i < 1000; ++i) list.push_front(i);
+    }
+    EXPECT_EQ(list.size(), 1000);
+    EXPECT_EQ(list.front(), 999);
+}
+
+TEST(SplitCircularList, test_link_only_operations) {
+    SplitCircularList<int> list;
+    for (int i = 0; i < 10; ++i) list.push_back(i);
+    EXPECT_EQ(*list.nth(7), 7);
+    EXPECT_TRUE(list.nth(10) == list.end());
+    EXPECT_THROW(list.nth(11), std::out_of_range);
+    EXPECT_EQ(list.index_of(list.begin()), 0);
+    EXPECT_EQ(list.index_of(list.nth(9)), 9);
+    EXPECT_EQ(list.index_of(list.end()), 10);
+
+    auto five = list.nth(5);
+    list.rotate(3);
+    EXPECT_EQ(contents(list),
+              (std::vector<int>{3, 4, 5, 6, 7, 8, 9, 0, 1, 2}));
+    EXPECT_EQ(list.index_of(five), 2);
+    list.rotate(-4);
+    EXPECT_EQ(list.front(), 9);
+    list.rotate(20);
+    EXPECT_EQ(list.front(), 9);
+    EXPECT_EQ(list.back(), 8);
+}
+
+TEST(SplitCircularList, test_keyed_records) {
+    using List = SplitCircularList<Record, RecordId>;
+    static_assert(List::keyed);
+    static_assert(std::is_same_v<List::key_type, long>);
+    static_assert(
+        std::is_same_v<decltype(*std::declval<List::iterator>()),
+                       const Record&>);
+
+    List list;
+    for (long id = 0; id < 100; ++id) list.push_back(make_record(id % 10));
+    EXPECT_EQ(list.count_key(3), 10);
+    EXPECT_EQ(list.count_key(42), 0);
+    auto it = list.find(7);
+    EXPECT_EQ(it.key(), 7);
+    EXPECT_EQ((*it).body[0], 'h');
+    EXPECT_EQ(list.index_of(it), 7);
+    EXPECT_TRUE(list.find(42) == list.end());
+
+    // replace() пересчитывает ключ в массиве связей
+    list.replace(it, make_record(42));
+    EXPECT_TRUE(list.find(42) == it);
+    EXPECT_EQ(list.count_key(7), 9);
+    EXPECT_THROW(list.end().key(), std::out_of_range);
+
+    long sum = 0;
+    list.for_each_key([&](long key) {
+        sum += key;
+        return key != 42;
+    });
+    EXPECT_EQ(sum, 0 + 1 + 2 + 3 + 4 + 5 + 6 + 42);
+}
+
+TEST(SplitCircularList, test_copy_move_compare) {
+    SplitCircularList<std::string> list;
+    for (int i = 0; i < 100; ++i) list.push_back(std::to_string(i));
+    SplitCircularList<std::string> copy(list);
+    EXPECT_EQ(copy, list);
+    copy.pop_back();
+    EXPECT_NE(copy, list);
+    EXPECT_LT(copy, list);
+    EXPECT_GT(list, copy);
+    EXPECT_LE(copy, copy);
+
+    SplitCircularList<std::string> moved(std::move(copy));
+    EXPECT_EQ(moved.size(), 99);
+    EXPECT_TRUE(copy.empty());
+    copy = list;
+    EXPECT_EQ(copy, list);
+    moved = std::move(copy);
+    EXPECT_EQ(moved, list);
+    moved.swap(copy);
+    EXPECT_TRUE(moved.empty());
+    EXPECT_EQ(copy.front(), "0");
+}
+
+TEST(SplitCircularList, test_capturing_key_of) {
+    long offset = 1000;
+    auto shifted = [offset](const Record& record) {
+        return record.id + offset;
+    };
+    using List = SplitCircularList<Record, decltype(shifted)>;
+    static_assert(!std::is_default_constructible_v<List>);
+    static_assert(!std::is_copy_assignable_v<List>);
+
+    List list(shifted);
+    for (long id = 0; id < 10; ++id) list.push_back(make_record(id));
+    EXPECT_EQ(list.find(1003).key(), 1003);
+    EXPECT_TRUE(list.find(3) == list.end());
+    List copy(list);
+    EXPECT_EQ(copy.count_key(1009), 1);
+    List moved(std::move(copy));
+    EXPECT_TRUE(copy.empty());
+    copy.push_back(make_record(5));
+    EXPECT_EQ(copy.begin().key(), 1005);
+    EXPECT_EQ(moved.size(), 10);
+}
+
+TEST(SplitCircularList, test_throwing_key_of) {
+    {
+        SplitCircularList<Counted, ThrowingId> list;
+        list.push_back(Counted(1));
+        EXPECT_THROW(list.push_back(Counted(-1)), std::runtime_error);
+        EXPECT_THROW(list.insert(list.begin(), Counted(-2)),
+                     std::runtime_error);
+        EXPECT_EQ(list.size(), 1);
+        EXPECT_EQ(Counted::live, 1);
+
+        // Освобождённый узел переиспользуется без повторного конструирования
+        // поверх живого объекта
+        list.push_front(Counted(0));
+        list.push_back(Counted(2));
+        EXPECT_EQ(Counted::live, 3);
+        EXPECT_EQ(list.find(0).key(), 0);
+        EXPECT_EQ(list.back().id, 2);
+    }
+    EXPECT_EQ(Counted::live, 0);
+}
+
+TEST(SplitCircularList, test_move_does_not_allocate) {
+    static_assert(
+        std::is_nothrow_move_constructible_v<SplitCircularList<Record>>);
+    static_assert(std::is_nothrow_move_constructible_v<
+                  SplitCircularList<Record, RecordId>>);
+    static_assert(std::is_nothrow_default_constructible_v<
+                  SplitCircularList<std::string>>);
+
+    // Перемещённый список пуст и пригоден для любых операций
+    SplitCircularList<std::string> list;
+    EXPECT_TRUE(list.begin() == list.end());
+    list.clear();
+    list.push_front("a");
+    SplitCircularList<std::string> moved(std::move(list));
+    EXPECT_TRUE(list.empty());
+    EXPECT_TRUE(list.begin() == list.end());
+    EXPECT_TRUE(list.nth(0) == list.end());
+    EXPECT_EQ(list.index_of(list.end()), 0);
+    EXPECT_EQ(list, SplitCircularList<std::string>());
+    list.rotate(3);
+    list.clear();
+    list.insert(list.end(), "b");
+    list.push_front("a");
+    EXPECT_EQ(contents(list), (std::vector<std::string>{"a", "b"}));
+
+    // Рост вектора перемещает списки, а не копирует: значения остаются
+    // на месте
+    std::vector<SplitCircularList<std::string>> lists(1);
+    lists[0].push_back("kept");
+    const std::string* kept = &lists[0].front();
+    for (int i = 0; i < 100; ++i) lists.emplace_back();
+    EXPECT_EQ(&lists[0].front(), kept);
+    EXPECT_EQ(moved.front(), "a");
+}
+
+TEST(SplitCircularList, test_layout_selection) {
+    static_assert(std::is_same_v<LayoutCircularList<int, NodeLayout::split>,
+                                 SplitCircularList<int>>);
+    static_assert(
+        std::is_same_v<LayoutCircularList<int, NodeLayout::inline_payload>,
+                       CircularList<int>>);
+    static_assert(
+        std::is_same_v<
+            LayoutCircularList<Record, NodeLayout::split, RecordId>,
+            SplitCircularList<Record, RecordId>>);
+}
+
+TEST(SplitCircularList, test_random_against_deque) {
+    std::mt19937 random(70);
+    SplitCircularList<int> list;
+    std::deque<int> model;
+    for (int step = 0; step < 5000; ++step) {
+        switch (random() % 6) {
+            case 0:
+                list.push_back(step);
+                model.push_back(step);
+                break;
+            case 1:
+                list.push_front(step);
+                model.push_front(step);
+                break;
+            case 2:
+                if (!model.empty()) {
+                    size_t index = random() % model.size();
+                    list.erase(list.nth(index));
+                    model.erase(model.begin() + index);
+                }
+                break;
+            case 3: {
+                size_t index = random() % (model.size() + 1);
+                list.insert(list.nth(index), -step);
+                model.insert(model.begin() + index, -step);
+                break;
+            }
+            case 4:
+                if (!model.empty()) {
+                    list.pop_front();
+                    model.pop_front();
+                }
+                break;
+            default:
+                if (!model.empty()) {
+                    int shift = int(random() % 20) - 10;
+                    list.rotate(shift);
+                    int n = int(model.size());
+                    std::rotate(model.begin(),
+                                model.begin() + (shift % n + n) % n,
+                                model.end());
+                }
+        }
+        ASSERT_EQ(contents(list), std::vector<int>(model.begin(), model.end()));
+    }
+}
@@ -0,0 +1,174 @@
+/* Platon Lukyanov st128133@student.spbu.ru
+ * Problem 7
+ */
+#include <string>
+#include <vector>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#include "SegmentedAlgorithms.h"
+#include "StaticCircularList.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+template <typename List>
+std::vector<typename List::iterator::value_type> contents(const List& list) {
+    return {list.begin(), list.end()};
+}
+
+}  // namespace
+
+TEST(StaticCircularList, test_push_pop_both_ends) {
+    StaticCircularList<int, 4> list;
+    EXPECT_TRUE(list.empty());
+    EXPECT_THROW(list.front(), std::out_of_range);
+    EXPECT_THROW(list.pop_front(), std::out_of_range);
+    EXPECT_TRUE(list.push_back(2));
+    EXPECT_TRUE(list.push_back(3));
+    EXPECT_TRUE(list.push_front(1));
+    EXPECT_TRUE(list.push_front(0));
+    EXPECT_TRUE(list.full());
+    EXPECT_EQ(list.front(), 0);
+    EXPECT_EQ(list.back(), 3);
+    EXPECT_EQ(contents(list), (std::vector<int>{0, 1, 2, 3}));
+    EXPECT_EQ(std::vector<int>(list.rbegin(), list.rend()),
+              (std::vector<int>{3, 2, 1, 0}));
+    EXPECT_EQ(*--list.end(), 3);
+    EXPECT_TRUE(++(--list.end()) == list.end());
+    list.pop_front();
+    list.pop_back();
+    EXPECT_EQ(contents(list), (std::vector<int>{1, 2}));
+    list.clear();
+    EXPECT_TRUE(list.empty());
+}
+
+TEST(StaticCircularList, test_free_list_reuse) {
+    StaticCircularList<std::string, 3> list;
+    for (int round = 0; round < 100; ++round) {
+        list.push_back("a" + std::to_string(round));
+        list.push_back("b");
+        list.push_front("c");
+        EXPECT_TRUE(list.full());
+        auto middle = ++list.begin();
+        list.erase(middle);
+        list.pop_front();
+        list.pop_back();
+        EXPECT_TRUE(list.empty());
+    }
+    list.push_back("x");
+    EXPECT_EQ(list.front(), "x");
+}
+
+TEST(StaticCircularList, test_insert_and_erase) {
+    StaticCircularList<int, 5> list;
+    list.insert(list.end(), 3);
+    list.insert(list.begin(), 1);
+    auto it = list.insert(++list.begin(), 2);
+    EXPECT_EQ(*it, 2);
+    EXPECT_EQ(contents(list), (std::vector<int>{1, 2, 3}));
+    it = list.erase(it);
+    EXPECT_EQ(*it, 3);
+    it = list.erase(it);
+    EXPECT_TRUE(it == list.end());
+    EXPECT_THROW(list.erase(list.end()), std::invalid_argument);
+    EXPECT_EQ(contents(list), (std::vector<int>{1}));
+}
+
+TEST(StaticCircularList, test_full_policy_throw) {
+    StaticCircularList<int, 2> list;
+    list.push_back(1);
+    list.push_back(2);
+    EXPECT_THROW(list.push_back(3), std::length_error);
+    EXPECT_THROW(list.push_front(3), std::length_error);
+    EXPECT_THROW(list.insert(list.begin(), 3), std::length_error);
+    EXPECT_EQ(contents(list), (std::vector<int>{1, 2}));
+}
+
+TEST(StaticCircularList, test_full_policy_reject) {
+    StaticCircularList<int, 2, FullPolicy::reject> list;
+    EXPECT_TRUE(list.push_back(1));
+    EXPECT_TRUE(list.push_back(2));
+    EXPECT_FALSE(list.push_back(3));
+    EXPECT_FALSE(list.push_front(3));
+    EXPECT_TRUE(list.insert(list.begin(), 3) == list.end());
+    EXPECT_EQ(contents(list), (std::vector<int>{1, 2}));
+}
+
+TEST(StaticCircularList, test_full_policy_overwrite_oldest) {
+    StaticCircularList<std::string, 3, FullPolicy::overwrite_oldest> list;
+    for (const char* value : {"a", "b", "c", "d", "e"}) list.push_back(value);
+    EXPECT_EQ(contents(list), (std::vector<std::string>{"c", "d", "e"}));
+    list.push_back(list.front());
+    EXPECT_EQ(contents(list), (std::vector<std::string>{"d", "e", "c"}));
+    list.push_front("z");
+    EXPECT_EQ(contents(list), (std::vector<std::string>{"z", "d", "e"}));
+    EXPECT_TRUE(list.insert(list.begin(), "y") == list.end());
+    EXPECT_EQ(list.front(), "z");
+    auto it = list.insert(--list.end(), "w");
+    EXPECT_EQ(*it, "w");
+    EXPECT_EQ(contents(list), (std::vector<std::string>{"d", "w", "e"}));
+}
+
+TEST(StaticCircularList, test_copy_move_swap_compare) {
+    StaticCircularList<std::string, 4> a;
+    a.push_back("1");
+    a.push_back("2");
+    a.push_front("0");
+    StaticCircularList<std::string, 4> b(a);
+    EXPECT_TRUE(a == b);
+    b.pop_back();
+    EXPECT_TRUE(b < a);
+    EXPECT_TRUE(a > b);
+    EXPECT_TRUE(b <= a);
+    EXPECT_TRUE(a != b);
+
+    StaticCircularList<std::string, 4> c(std::move(a));
+    EXPECT_TRUE(a.empty());
+    EXPECT_EQ(contents(c), (std::vector<std::string>{"0", "1", "2"}));
+    c.swap(b);
+    EXPECT_EQ(contents(b), (std::vector<std::string>{"0", "1", "2"}));
+    EXPECT_EQ(contents(c), (std::vector<std::string>{"0", "1"}));
+    a = b;
+    EXPECT_TRUE(a == b);
+    a = std::move(c);
+    EXPECT_EQ(contents(a), (std::vector<std::string>{"0", "1"}));
+    a.push_back("x");
+    a.push_back("y");
+    EXPECT_TRUE(a.full());
+}
+
+TEST(StaticCircularList, test_segments) {
+    StaticCircularList<int32_t, 8> list;
+    for (int32_t value : {5, -1, 7, 2}) list.push_back(value);
+    list.pop_front();
+    list.push_back(9);
+    EXPECT_EQ(*segmented::find(list, 7), 7);
+    EXPECT_EQ(*segmented::max_element(list), 9);
+    EXPECT_EQ(segmented::accumulate(list, 0), 17);
+
+    std::vector<int32_t> seen;
+    const auto& clist = list;
+    clist.for_each([&](int32_t value) { seen.push_back(value); });
+    EXPECT_EQ(seen, (std::vector<int32_t>{-1, 7, 2, 9}));
+}
+
+TEST(StaticCircularList, test_no_heap) {
+    static_assert(sizeof(StaticCircularList<int, 100>::Index) == 2);
+    StaticCircularList<int, 64, FullPolicy::overwrite_oldest> list;
+#if defined(__GLIBC__)
+    size_t before = mallinfo2().uordblks;
+#endif
+    for (int i = 0; i < 10000; ++i) {
+        list.push_back(i);
+        if (i % 3 == 0) list.pop_front();
+        if (i % 7 == 0 && list.size() > 1) list.erase(++list.begin());
+    }
+#if defined(__GLIBC__)
+    EXPECT_EQ(mallinfo2().uordblks, before);
+#endif
+    EXPECT_EQ(list.size(), 63);
+    EXPECT_EQ(list.back(), 9999);
+}
@@ -0,0 +1,227 @@
+/* Platon Lukyanov st128133@student.spbu.ru
+ * Problem 7
+ */
+#include <deque>
+#include <random>
+#include <string>
+#include <vector>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#include "StringCircularList.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+std::vector<std::string> contents(const StringCircularList& list) {
+    return std::vector<std::string>(list.begin(), list.end());
+}
+
+}  // namespace
+
+TEST(StringCircularList, test_push_pop_fifo) {
+    StringCircularList list;
+    EXPECT_TRUE(list.empty());
+    EXPECT_THROW(list.front(), std::out_of_range);
+    EXPECT_THROW(list.pop_front(), std::out_of_range);
+    EXPECT_THROW(list.pop_back(), std::out_of_range);
+    list.push_back("alpha");
+    list.push_back("");
+    list.push_back("gamma");
+    EXPECT_EQ(list.size(), 3);
+    EXPECT_EQ(list.front(), "alpha");
+    EXPECT_EQ(list.back(), "gamma");
+    EXPECT_EQ(list[1], "");
+    EXPECT_THROW(list[3], std::out_of_range);
+    EXPECT_EQ(contents(list),
+              (std::vector<std::string>{"alpha", "", "gamma"}));
+    EXPECT_EQ(list.arena_bytes_used(), 10);
+
+    list.pop_front();
+    EXPECT_EQ(list.front(), "");
+    list.pop_back();
+    EXPECT_EQ(list.back(), "");
+    list.pop_front();
+    EXPECT_TRUE(list.empty());
+    EXPECT_EQ(list.arena_bytes_used(), 0);
+    EXPECT_TRUE(list.begin() == list.end());
+}
+
+TEST(StringCircularList, test_wrap_around_reuses_arena) {
+    StringCircularList list;
+    list.reserve(256, 16);
+    size_t capacity = list.arena_capacity();
+    // Длины не делят ёмкость, поэтому строки переходят через конец буфера
+    std::deque<std::string> model;
+    for (int i = 0; i < 1000; ++i) {
+        std::string value(size_t(5 + i % 23), char('a' + i % 26));
+        list.push_back(value);
+        model.push_back(value);
+        if (model.size() > 6) {
+            list.pop_front();
+            model.pop_front();
+        }
+        ASSERT_EQ(list.front(), model.front());
+        ASSERT_EQ(list.back(), model.back());
+    }
+    EXPECT_EQ(list.arena_capacity(), capacity);
+    EXPECT_EQ(contents(list),
+              std::vector<std::string>(model.begin(), model.end()));
+
+    // Снятие с хвоста возвращает и пропуск в конце буфера
+    while (list.size() > 1) list.pop_back();
+    EXPECT_EQ(list.arena_bytes_used(), model.front().size());
+}
+
+TEST(StringCircularList, test_only_empty_strings_remain) {
+    // Занятых байтов нет, но пустая строка ещё в списке
+    StringCircularList list;
+    list.push_back("abc");
+    list.push_back("");
+    list.pop_front();
+    EXPECT_EQ(list.arena_bytes_used(), 0);
+    list.push_back("xyz");
+    list.pop_front();
+    EXPECT_EQ(list.arena_bytes_used(), 3);
+    list.push_back("12345");
+    EXPECT_EQ(list.front(), "xyz");
+    EXPECT_EQ(list.back(), "12345");
+    EXPECT_EQ(list.arena_bytes_used(), 8);
+
+    StringCircularList tail;
+    tail.push_back("abc");
+    tail.push_back("");
+    tail.pop_front();
+    tail.push_back("xyz");
+    tail.pop_back();
+    EXPECT_EQ(tail.size(), 1);
+    EXPECT_EQ(tail.arena_bytes_used(), 0);
+    tail.push_back("12345");
+    tail.pop_front();
+    EXPECT_EQ(tail.front(), "12345");
+    EXPECT_EQ(tail.arena_bytes_used(), 5);
+}
+
+TEST(StringCircularList, test_push_back_own_element) {
+    StringCircularList list;
+    list.push_back(std::string(100, 'x'));
+    // Каждая вставка своего же элемента выходит за арену и растит её
+    for (int i = 0; i < 40; ++i) list.push_back(list.front());
+    EXPECT_EQ(list.size(), 41);
+    list.for_each([](std::string_view value) {
+        EXPECT_EQ(value, std::string(100, 'x'));
+    });
+
+    list.clear();
+    for (int i = 0; i < 5; ++i) list.push_back(std::to_string(i));
+    list.rotate(2);
+    EXPECT_EQ(contents(list),
+              (std::vector<std::string>{"2", "3", "4", "0", "1"}));
+    list.rotate(-3);
+    EXPECT_EQ(list.front(), "4");
+    list.rotate(5);
+    EXPECT_EQ(list.front(), "4");
+
+    // false прекращает обход
+    size_t visited = 0;
+    list.for_each([&visited](std::string_view) {
+        ++visited;
+        return false;
+    });
+    EXPECT_EQ(visited, 1);
+}
+
+TEST(StringCircularList, test_convert_copy_compare) {
+    CircularList<std::string> source;
+    source.push_back("one");
+    source.push_back("two");
+    source.push_back(std::string(300, 't'));
+    StringCircularList list(source);
+    EXPECT_EQ(list.size(), 3);
+    EXPECT_EQ(list.back(), std::string(300, 't'));
+    EXPECT_EQ(list.to_circular_list(), source);
+
+    StringCircularList copy(list);
+    EXPECT_EQ(copy, list);
+    copy.pop_back();
+    EXPECT_LT(copy, list);
+    EXPECT_GT(list, copy);
+    EXPECT_LE(copy, list);
+    EXPECT_GE(list, copy);
+    EXPECT_NE(list, copy);
+
+    StringCircularList moved(std::move(copy));
+    EXPECT_TRUE(copy.empty());
+    EXPECT_EQ(moved.size(), 2);
+    copy = moved;
+    EXPECT_EQ(copy, moved);
+    moved = std::move(list);
+    EXPECT_EQ(moved.size(), 3);
+    moved.swap(list);
+    EXPECT_TRUE(moved.empty());
+    EXPECT_EQ(list.front(), "one");
+}
+
+#if defined(__GLIBC__)
+TEST(StringCircularList, test_steady_state_without_heap) {
+    StringCircularList list;
+    list.reserve(1 << 12, 64);
+    std::string message = "2024-01-01T00:00:00Z INFO request served in ";
+    size_t capacity = list.arena_capacity();
+    size_t before = mallinfo2().uordblks;
+    for (int i = 0; i < 10000; ++i) {
+        list.push_back(std::string_view(message).substr(0, 20 + i % 25));
+        if (list.size() > 32) list.pop_front();
+    }
+    size_t after = mallinfo2().uordblks;
+    EXPECT_EQ(after, before);
+    EXPECT_EQ(list.arena_capacity(), capacity);
+}
+#endif
+
+TEST(StringCircularList, test_random_against_deque) {
+    std::mt19937 random(73);
+    StringCircularList list;
+    std::deque<std::string> model;
+    for (int step = 0; step < 20000; ++step) {
+        // Перекос в сторону вставок в начале прогона и удалений в конце
+        bool grow = int(random() % 20000) > step / 2;
+        switch (random() % 4) {
+            case 0:
+            case 1:
+                if (grow) {
+                    // Пустые строки часты: они не занимают байтов арены
+                    size_t length = random() % 3 == 0 ? 0 : random() % 40;
+                    std::string value(length, char('a' + step % 26));
+                    list.push_back(value);
+                    model.push_back(value);
+                } else if (!model.empty()) {
+                    list.pop_back();
+                    model.pop_back();
+                }
+                break;
+            case 2:
+                if (!model.empty()) {
+                    list.pop_front();
+                    model.pop_front();
+                }
+                break;
+            default:
+                if (!model.empty()) {
+                    list.rotate(1);
+                    model.push_back(model.front());
+                    model.pop_front();
+                }
+        }
+        ASSERT_EQ(list.size(), model.size());
+        ASSERT_LE(list.arena_bytes_used(), list.arena_capacity());
+        if (step % 97 == 0) {
+            ASSERT_EQ(contents(list),
+                      std::vector<std::string>(model.begin(), model.end()));
+        }
+    }
+    EXPECT_EQ(contents(list),
+              std::vector<std::string>(model.begin(), model.end()));
+}
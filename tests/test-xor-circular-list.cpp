@@ -0,0 +1,109 @@
+/* Platon Lukyanov st128133@student.spbu.ru
+ * Problem 7
+ */
+#include <string>
+#include <vector>
+
+#include "XorCircularList.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+template <typename T>
+std::vector<T> forward(const XorCircularList<T>& list) {
+    return std::vector<T>(list.begin(), list.end());
+}
+
+template <typename T>
+std::vector<T> backward(const XorCircularList<T>& list) {
+    return std::vector<T>(list.rbegin(), list.rend());
+}
+
+}  // namespace
+
+TEST(XorCircularList, test_node_is_smaller) {
+    EXPECT_EQ(XorCircularList<long>::node_size, 2 * sizeof(void*));
+}
+
+TEST(XorCircularList, test_push_and_pop_both_ends) {
+    XorCircularList<int> list;
+    EXPECT_TRUE(list.empty());
+    EXPECT_THROW(list.front(), std::out_of_range);
+    EXPECT_THROW(list.pop_back(), std::out_of_range);
+    list.push_back(2);
+    list.push_front(1);
+    list.push_back(3);
+    list.push_front(0);
+    EXPECT_EQ(list.size(), 4);
+    EXPECT_EQ(forward(list), (std::vector<int>{0, 1, 2, 3}));
+    EXPECT_EQ(backward(list), (std::vector<int>{3, 2, 1, 0}));
+    list.pop_front();
+    list.pop_back();
+    EXPECT_EQ(forward(list), (std::vector<int>{1, 2}));
+    list.pop_back();
+    EXPECT_EQ(list.front(), 1);
+    EXPECT_EQ(list.back(), 1);
+    list.pop_front();
+    EXPECT_TRUE(list.empty());
+    list.push_front(7);
+    EXPECT_EQ(forward(list), (std::vector<int>{7}));
+}
+
+TEST(XorCircularList, test_bidirectional_iteration) {
+    XorCircularList<int> list;
+    for (int i = 0; i < 5; ++i) list.push_back(i);
+    auto it = list.begin();
+    ++it;
+    ++it;
+    EXPECT_EQ(*it, 2);
+    --it;
+    EXPECT_EQ(*it, 1);
+    auto last = list.end();
+    --last;
+    EXPECT_EQ(*last, 4);
+    ++last;
+    EXPECT_TRUE(last == list.end());
+}
+
+TEST(XorCircularList, test_insert_and_erase_through_iterator) {
+    XorCircularList<std::string> list;
+    list.insert(list.end(), "b");
+    list.insert(list.begin(), "a");
+    list.insert(list.end(), "d");
+    auto it = list.begin();
+    ++it;
+    ++it;
+    it = list.insert(it, "c");
+    EXPECT_EQ(*it, "c");
+    EXPECT_EQ(forward(list), (std::vector<std::string>{"a", "b", "c", "d"}));
+
+    it = list.erase(list.begin());
+    EXPECT_EQ(*it, "b");
+    ++it;
+    it = list.erase(it);
+    EXPECT_EQ(*it, "d");
+    it = list.erase(it);
+    EXPECT_TRUE(it == list.end());
+    EXPECT_EQ(forward(list), (std::vector<std::string>{"b"}));
+    EXPECT_EQ(backward(list), (std::vector<std::string>{"b"}));
+    it = list.erase(list.begin());
+    EXPECT_TRUE(list.empty());
+    EXPECT_THROW(list.erase(list.begin()), std::out_of_range);
+}
+
+TEST(XorCircularList, test_copy_move_compare) {
+    XorCircularList<int> list;
+    for (int i = 0; i < 10; ++i) list.push_front(i);
+    XorCircularList<int> copy(list);
+    EXPECT_TRUE(copy == list);
+    copy.pop_back();
+    EXPECT_TRUE(copy != list);
+    XorCircularList<int> moved(std::move(copy));
+    EXPECT_TRUE(copy.empty());
+    EXPECT_EQ(moved.size(), 9);
+    copy = list;
+    EXPECT_TRUE(copy == list);
+    moved = std::move(copy);
+    EXPECT_TRUE(moved == list);
+    EXPECT_EQ(backward(moved).front(), 0);
+}